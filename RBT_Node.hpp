@@ -8,6 +8,12 @@ enum Color {
 	RED
 };
 
+/*
+		With FT_THREADED_TREE defined every node also carries its in-order
+		neighbours, kept by Rb_tree on link and unlink, so successor() and
+		predecessor() are a single load instead of a climb. The sentinel
+		closes the list: its next is the minimum, its prev the maximum.
+*/
 template <typename T>
 struct RBT_Node {
 	typedef RBT_Node<T>			Tree_Node;
@@ -20,13 +26,22 @@ struct RBT_Node {
 	Node_ptr					left;
 	Node_ptr					right;
 	Color						color;
+	int							rank;
+#ifdef FT_THREADED_TREE
+	Node_ptr					next;
+	Node_ptr					prev;
+#endif
 
 	RBT_Node(const T& _data, Node_ptr _root, Node_ptr _leaf,
 							Node_ptr _parent = NULL,
 							Node_ptr _left = NULL,
 							Node_ptr _right = NULL,
-							Color _color = BLACK)
-	: data(_data), root(_root), leaf(_leaf), parent(_parent), left(_left), right(_right), color(_color)
+							Color _color = BLACK,
+							int _rank = 0)
+	: data(_data), root(_root), leaf(_leaf), parent(_parent), left(_left), right(_right), color(_color), rank(_rank)
+#ifdef FT_THREADED_TREE
+		, next(_leaf), prev(_leaf)
+#endif
 		{}
 
 	static Node_ptr get_root(Node_ptr node) {
@@ -47,6 +62,15 @@ struct RBT_Node {
 		return (node);
 	}
 
+#ifdef FT_THREADED_TREE
+	static Node_ptr successor(Node_ptr x) {
+		return (x->next);
+	}
+
+	static Node_ptr predecessor(Node_ptr x) {
+		return (x->prev);
+	}
+#else
 	static Node_ptr successor(Node_ptr x) {
 		if (x == x->leaf) {
 			return (maximum(get_root(x)));
@@ -76,6 +100,7 @@ struct RBT_Node {
 		}
 		return (y);
 	}
+#endif
 };
 
 }
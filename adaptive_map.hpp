@@ -0,0 +1,601 @@
+#ifndef ADAPTIVE_MAP_H
+#define ADAPTIVE_MAP_H
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./algorithm.hpp"
+#include "./iterator_traits.hpp"
+#include "./map.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+// Walks either an inline slot array (ptr set) or an ft::map (ptr NULL).
+template <typename T, typename TreeIter>
+class adaptive_iterator : public iterator<std::bidirectional_iterator_tag, T> {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef T									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef T*									pointer;
+	typedef T&									reference;
+
+ protected:
+	pointer										ptr;
+	TreeIter									node;
+
+ public:
+	adaptive_iterator(void) : ptr(NULL), node() {}
+
+	explicit adaptive_iterator(pointer _ptr) : ptr(_ptr), node() {}
+
+	explicit adaptive_iterator(const TreeIter& _node) : ptr(NULL), node(_node) {}
+
+	template <typename U, typename I>
+	adaptive_iterator(const adaptive_iterator<U, I>& i) : ptr(i.slot()), node(i.base()) {}
+
+	~adaptive_iterator(void) {}
+
+	pointer slot(void) const {
+		return (ptr);
+	}
+
+	TreeIter base(void) const {
+		return (node);
+	}
+
+	reference operator*(void) const {
+		return (ptr != NULL ? *ptr : *node);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	adaptive_iterator& operator++(void) {
+		if (ptr != NULL)
+			++ptr;
+		else
+			++node;
+		return (*this);
+	}
+
+	adaptive_iterator operator++(int) {
+		adaptive_iterator tmp(*this);
+		++(*this);
+		return (tmp);
+	}
+
+	adaptive_iterator& operator--(void) {
+		if (ptr != NULL)
+			--ptr;
+		else
+			--node;
+		return (*this);
+	}
+
+	adaptive_iterator operator--(int) {
+		adaptive_iterator tmp(*this);
+		--(*this);
+		return (tmp);
+	}
+};
+
+template <typename TL, typename IL, typename TR, typename IR>
+inline bool operator==(const adaptive_iterator<TL, IL>& lhs, const adaptive_iterator<TR, IR>& rhs) {
+	return (lhs.slot() == rhs.slot() && lhs.base() == rhs.base());
+}
+
+template <typename TL, typename IL, typename TR, typename IR>
+inline bool operator!=(const adaptive_iterator<TL, IL>& lhs, const adaptive_iterator<TR, IR>& rhs) {
+	return (!(lhs == rhs));
+}
+
+/*
+		Up to Inline entries live in a sorted array inside the object, so a
+		small map costs no allocation at all. The first insert past Inline
+		moves everything into an ft::map; erasing down to Inline / 2 moves
+		it back. Either switch invalidates all iterators.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>,
+		class Alloc = std::allocator<ft::pair<const Key, T> >, std::size_t Inline = 8>
+class adaptive_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Alloc										allocator_type;
+	typedef ft::map<Key, T, Compare, Alloc>				tree_type;
+	typedef ft::adaptive_iterator<value_type, typename tree_type::iterator>
+														iterator;
+	typedef ft::adaptive_iterator<const value_type, typename tree_type::const_iterator>
+														const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+ /*****************************************************************************\
+ * 							MEMBER CLASS			 						   *
+ \*****************************************************************************/
+	class value_compare : public std::binary_function<value_type, value_type, bool> {
+	 protected:
+		Compare comp;
+
+	 public:
+		explicit value_compare(Compare c = Compare()) : comp(c) {}
+
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(x.first, y.first));
+		}
+	};
+
+ private:
+	typedef typename Alloc::template rebind<tree_type>::other	Tree_allocator;
+
+	union Storage {
+		char											bytes[Inline * sizeof(value_type)];
+		long double										align_float;
+		long long										align_int;
+		void*											align_ptr;
+	};
+
+	Storage												_small;
+	size_type											_count;
+	tree_type*											_tree;
+	key_compare											_comp;
+	allocator_type										_alloc;
+	Tree_allocator										_tree_alloc;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit adaptive_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _count(0), _tree(NULL), _comp(comp), _alloc(alloc), _tree_alloc(alloc)
+		{};
+
+	template <class InputIterator>
+	adaptive_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type())
+		: _count(0), _tree(NULL), _comp(comp), _alloc(alloc), _tree_alloc(alloc) {
+		insert(first, last);
+	};
+
+	adaptive_map(const adaptive_map& x)
+		: _count(0), _tree(NULL), _comp(x._comp), _alloc(x._alloc), _tree_alloc(x._tree_alloc) {
+		_copy(x);
+	};
+
+	~adaptive_map(void) {
+		clear();
+	};
+
+	adaptive_map& operator=(const adaptive_map& x) {
+		if (this != &x) {
+			clear();
+			_comp = x._comp;
+			_alloc = x._alloc;
+			_tree_alloc = x._tree_alloc;
+			_copy(x);
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type& at(const Key& key) {
+		iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	const mapped_type& at(const Key& key) const {
+		const_iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	mapped_type& operator[](const key_type& k) {
+		return (insert(ft::make_pair(k, mapped_type())).first->second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (_tree ? iterator(_tree->begin()) : iterator(_slots()));
+	};
+
+	const_iterator begin(void) const {
+		return (_tree ? const_iterator(_tree->begin()) : const_iterator(_slots()));
+	};
+
+	iterator end(void) {
+		return (_tree ? iterator(_tree->end()) : iterator(_slots() + _count));
+	};
+
+	const_iterator end(void) const {
+		return (_tree ? const_iterator(_tree->end()) : const_iterator(_slots() + _count));
+	};
+
+	reverse_iterator rbegin(void) {
+		return (reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	reverse_iterator rend(void) {
+		return (reverse_iterator(begin()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (size() == 0);
+	};
+
+	size_type size(void) const {
+		return (_tree ? _tree->size() : _count);
+	};
+
+	size_type max_size(void) const {
+		return (_alloc.max_size());
+	};
+
+	// True while the entries live in the inline array.
+	bool is_inline(void) const {
+		return (_tree == NULL);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		if (_tree == NULL) {
+			size_type i = _small_lower_bound(val.first);
+			if (i < _count && !_comp(val.first, _slots()[i].first))
+				return (ft::make_pair(iterator(_slots() + i), false));
+			if (_count < Inline) {
+				_small_insert(i, val);
+				return (ft::make_pair(iterator(_slots() + i), true));
+			}
+			_promote();
+		}
+		ft::pair<typename tree_type::iterator, bool> res = _tree->insert(val);
+		return (ft::make_pair(iterator(res.first), res.second));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		(void)position;
+		return (insert(val).first);
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		while (first != last) {
+			insert(*first);
+			++first;
+		}
+	};
+
+	void erase(iterator position) {
+		if (_tree == NULL) {
+			_small_erase(position.slot() - _slots(), 1);
+		} else {
+			_tree->erase(position.base());
+			_demote();
+		}
+	};
+
+	size_type erase(const key_type& k) {
+		if (_tree == NULL) {
+			size_type i = _small_lower_bound(k);
+			if (i == _count || _comp(k, _slots()[i].first))
+				return (0);
+			_small_erase(i, 1);
+			return (1);
+		}
+		size_type n = _tree->erase(k);
+		_demote();
+		return (n);
+	};
+
+	void erase(iterator first, iterator last) {
+		if (_tree == NULL) {
+			_small_erase(first.slot() - _slots(), last.slot() - first.slot());
+		} else {
+			_tree->erase(first.base(), last.base());
+			_demote();
+		}
+	};
+
+	void swap(adaptive_map& x) {
+		if (_tree != NULL && x._tree != NULL) {
+			std::swap(_tree, x._tree);
+			std::swap(_comp, x._comp);
+			std::swap(_alloc, x._alloc);
+			std::swap(_tree_alloc, x._tree_alloc);
+			return;
+		}
+		adaptive_map tmp(*this);
+		*this = x;
+		x = tmp;
+	};
+
+	void clear(void) {
+		if (_tree != NULL) {
+			_tree_alloc.destroy(_tree);
+			_tree_alloc.deallocate(_tree, 1);
+			_tree = NULL;
+		}
+		_small_erase(0, _count);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) {
+		if (_tree != NULL)
+			return (iterator(_tree->find(k)));
+		size_type i = _small_lower_bound(k);
+		if (i < _count && !_comp(k, _slots()[i].first))
+			return (iterator(_slots() + i));
+		return (end());
+	};
+
+	const_iterator find(const key_type& k) const {
+		if (_tree != NULL)
+			return (const_iterator(static_cast<const tree_type*>(_tree)->find(k)));
+		size_type i = _small_lower_bound(k);
+		if (i < _count && !_comp(k, _slots()[i].first))
+			return (const_iterator(_slots() + i));
+		return (end());
+	};
+
+	size_type count(const key_type& k) const {
+		return (find(k) != end());
+	};
+
+	iterator lower_bound(const key_type& k) {
+		if (_tree != NULL)
+			return (iterator(_tree->lower_bound(k)));
+		return (iterator(_slots() + _small_lower_bound(k)));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		if (_tree != NULL)
+			return (const_iterator(static_cast<const tree_type*>(_tree)->lower_bound(k)));
+		return (const_iterator(_slots() + _small_lower_bound(k)));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		if (_tree != NULL)
+			return (iterator(_tree->upper_bound(k)));
+		return (iterator(_slots() + _small_upper_bound(k)));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		if (_tree != NULL)
+			return (const_iterator(static_cast<const tree_type*>(_tree)->upper_bound(k)));
+		return (const_iterator(_slots() + _small_upper_bound(k)));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+	value_compare value_comp(void) const {
+		return (value_compare(_comp));
+	};
+
+ private:
+
+	pointer _slots(void) {
+		return (reinterpret_cast<pointer>(_small.bytes));
+	};
+
+	const_pointer _slots(void) const {
+		return (reinterpret_cast<const_pointer>(_small.bytes));
+	};
+
+	// Counts instead of searching: no early exit and no data-dependent
+	// branch, so the loop unrolls (and vectorizes for plain keys).
+	size_type _small_lower_bound(const key_type& k) const {
+		const_pointer s = _slots();
+		size_type i = 0;
+		for (size_type j = 0; j < _count; j++)
+			i += _comp(s[j].first, k);
+		return (i);
+	};
+
+	size_type _small_upper_bound(const key_type& k) const {
+		const_pointer s = _slots();
+		size_type i = 0;
+		for (size_type j = 0; j < _count; j++)
+			i += !_comp(k, s[j].first);
+		return (i);
+	};
+
+	// Keys are const, so entries move by copy and destroy. A copy that
+	// throws leaves a hole at j: the entries past it are dropped so the
+	// slots stay contiguous and _count matches what is constructed.
+	void _small_insert(size_type i, const value_type& val) {
+		pointer s = _slots();
+		size_type j = _count;
+		try {
+			for (; j > i; j--) {
+				_alloc.construct(s + j, s[j - 1]);
+				_alloc.destroy(s + j - 1);
+			}
+			_alloc.construct(s + i, val);
+		} catch (...) {
+			for (size_type k = j + 1; k <= _count; k++)
+				_alloc.destroy(s + k);
+			_count = j;
+			throw;
+		}
+		_count++;
+	};
+
+	void _small_erase(size_type i, size_type n) {
+		pointer s = _slots();
+		for (size_type j = i; j < i + n; j++)
+			_alloc.destroy(s + j);
+		size_type j = i + n;
+		try {
+			for (; j < _count; j++) {
+				_alloc.construct(s + j - n, s[j]);
+				_alloc.destroy(s + j);
+			}
+		} catch (...) {
+			for (size_type k = j; k < _count; k++)
+				_alloc.destroy(s + k);
+			_count = j - n;
+			throw;
+		}
+		_count -= n;
+	};
+
+	void _promote(void) {
+		tree_type* tree = _tree_alloc.allocate(1);
+		try {
+			new (tree) tree_type(_comp, _alloc);
+		} catch (...) {
+			_tree_alloc.deallocate(tree, 1);
+			throw;
+		}
+		pointer s = _slots();
+		try {
+			for (size_type j = 0; j < _count; j++)
+				tree->insert(s[j]);
+		} catch (...) {
+			_tree_alloc.destroy(tree);
+			_tree_alloc.deallocate(tree, 1);
+			throw;
+		}
+		_small_erase(0, _count);
+		_tree = tree;
+	};
+
+	void _demote(void) {
+		if (_tree->size() > Inline / 2)
+			return;
+		// The erase that got here has already happened, so a throwing copy
+		// only cancels the move: the slots are emptied and the tree stays.
+		pointer s = _slots();
+		try {
+			for (typename tree_type::iterator it = _tree->begin(); it != _tree->end(); ++it) {
+				_alloc.construct(s + _count, *it);
+				_count++;
+			}
+		} catch (...) {
+			_small_erase(0, _count);
+			return;
+		}
+		_tree_alloc.destroy(_tree);
+		_tree_alloc.deallocate(_tree, 1);
+		_tree = NULL;
+	};
+
+	void _copy(const adaptive_map& x) {
+		if (x._tree != NULL) {
+			_tree = _tree_alloc.allocate(1);
+			new (_tree) tree_type(*x._tree);
+			return;
+		}
+		const_pointer s = x._slots();
+		for (size_type j = 0; j < x._count; j++)
+			_alloc.construct(_slots() + j, s[j]);
+		_count = x._count;
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+void swap(adaptive_map<Key, T, Compare, Alloc, Inline>& lhs, adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	lhs.swap(rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator==(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator!=(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator<(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator<=(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (!(rhs < lhs));
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator>(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class Alloc, std::size_t Inline>
+bool operator>=(const adaptive_map<Key, T, Compare, Alloc, Inline>& lhs,
+				const adaptive_map<Key, T, Compare, Alloc, Inline>& rhs) {
+	return (!(lhs < rhs));
+}
+
+};
+#endif
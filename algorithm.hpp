@@ -1,6 +1,20 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+#include "./iterator_traits.hpp"
+#include "./random_access_iterator.hpp"
+#include "./type_traits.hpp"
+#include "./utility.hpp"
+
 namespace ft {
 
 template <typename InputIt1, typename InputIt2>
@@ -57,6 +71,730 @@ inline bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
 	return ((first1 == last1) && (first2 != last2));
 }
 
+/*****************************************************************************\
+* 							SORTING				 							   *
+\*****************************************************************************/
+
+/*
+		sort is introsort: quicksort on a median of three, heapsort once the
+		recursion passes 2 log2(n), and one insertion sort over the nearly
+		sorted result. stable_sort is a bottom-up merge sort through a
+		buffer of n elements. Without a comparator, integral elements of
+		either are sorted by an LSD radix sort instead, one pass per byte
+		that is not the same in every element.
+*/
+
+struct sort_tuning {
+	enum {
+		INSERTION = 16,
+		RUN = 32,
+		RADIX_MIN = 256
+	};
+};
+
+template <typename T>
+struct sort_less {
+	bool operator()(const T& a, const T& b) const {
+		return (a < b);
+	}
+};
+
+template <typename It>
+inline void sort_swap(It a, It b) {
+	using std::swap;
+	swap(*a, *b);
+}
+
+// Uninitialized room for n copies of T, released by the destructor.
+template <typename T>
+class sort_buffer {
+	std::allocator<T>									_alloc;
+	T*													_data;
+	std::size_t											_size;
+	std::size_t											_capacity;
+
+	sort_buffer(const sort_buffer&);
+	sort_buffer& operator=(const sort_buffer&);
+
+ public:
+	// Copies [first, first + n) in.
+	template <typename It>
+	sort_buffer(It first, std::size_t n)
+		: _alloc(), _data(_alloc.allocate(n)), _size(0), _capacity(n) {
+		try {
+			for (; _size < n; ++_size, ++first)
+				_alloc.construct(_data + _size, *first);
+		} catch (...) {
+			_release();
+			throw;
+		}
+	}
+
+	~sort_buffer(void) {
+		_release();
+	}
+
+	T* data(void) const {
+		return (_data);
+	}
+
+ private:
+	void _release(void) {
+		for (std::size_t i = 0; i < _size; i++)
+			_alloc.destroy(_data + i);
+		_alloc.deallocate(_data, _capacity);
+	}
+};
+
+template <typename It, typename Compare>
+void insertion_sort(It first, It last, Compare comp) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	if (first == last)
+		return;
+	for (It i = first + 1; i != last; ++i) {
+		if (!comp(*i, *(i - 1)))
+			continue;
+		value_type v = *i;
+		It j = i;
+		do {
+			*j = *(j - 1);
+			--j;
+		} while (j != first && comp(v, *(j - 1)));
+		*j = v;
+	}
+}
+
+template <typename It, typename Distance, typename T, typename Compare>
+void sort_sift_down(It first, Distance hole, Distance n, T v, Compare comp) {
+	Distance child;
+	while ((child = 2 * hole + 1) < n) {
+		if (child + 1 < n && comp(*(first + child), *(first + child + 1)))
+			child++;
+		if (!comp(v, *(first + child)))
+			break;
+		*(first + hole) = *(first + child);
+		hole = child;
+	}
+	*(first + hole) = v;
+}
+
+template <typename It, typename Compare>
+void make_heap(It first, It last, Compare comp) {
+	typedef typename iterator_traits<It>::difference_type	Distance;
+	typedef typename iterator_traits<It>::value_type	value_type;
+	Distance n = last - first;
+	for (Distance i = n / 2; i-- > 0; ) {
+		value_type v = *(first + i);
+		sort_sift_down(first, i, n, v, comp);
+	}
+}
+
+// [first, last) must be a heap; sorts it ascending.
+template <typename It, typename Compare>
+void sort_heap(It first, It last, Compare comp) {
+	typedef typename iterator_traits<It>::difference_type	Distance;
+	typedef typename iterator_traits<It>::value_type	value_type;
+	for (Distance n = last - first; n > 1; n--) {
+		value_type v = *(first + (n - 1));
+		*(first + (n - 1)) = *first;
+		sort_sift_down(first, Distance(0), n - 1, v, comp);
+	}
+}
+
+template <typename It, typename Compare>
+void sort_median_to_first(It first, It a, It b, It c, Compare comp) {
+	if (comp(*a, *b)) {
+		if (comp(*b, *c))
+			sort_swap(first, b);
+		else if (comp(*a, *c))
+			sort_swap(first, c);
+		else
+			sort_swap(first, a);
+	} else if (comp(*a, *c)) {
+		sort_swap(first, a);
+	} else if (comp(*b, *c)) {
+		sort_swap(first, c);
+	} else {
+		sort_swap(first, b);
+	}
+}
+
+// Partitions [first + 1, last) around *first; the median of three keeps
+// both scans inside the range without bounds checks.
+template <typename It, typename Compare>
+It sort_partition_pivot(It first, It last, Compare comp) {
+	It mid = first + (last - first) / 2;
+	sort_median_to_first(first, first + 1, mid, last - 1, comp);
+	It pivot = first;
+	++first;
+	while (true) {
+		while (comp(*first, *pivot))
+			++first;
+		--last;
+		while (comp(*pivot, *last))
+			--last;
+		if (!(first < last))
+			return (first);
+		sort_swap(first, last);
+		++first;
+	}
+}
+
+template <typename It, typename Compare>
+void introsort_loop(It first, It last, std::size_t depth, Compare comp) {
+	while (last - first > sort_tuning::INSERTION) {
+		if (depth == 0) {
+			ft::make_heap(first, last, comp);
+			ft::sort_heap(first, last, comp);
+			return;
+		}
+		depth--;
+		It cut = sort_partition_pivot(first, last, comp);
+		introsort_loop(cut, last, depth, comp);
+		last = cut;
+	}
+}
+
+inline std::size_t sort_depth_limit(std::size_t n) {
+	std::size_t depth = 0;
+	for (; n > 1; n >>= 1)
+		depth += 2;
+	return (depth);
+}
+
+// The key of an integral value as an unsigned number in the same order.
+template <typename T>
+inline unsigned long long radix_key(const T& x) {
+	unsigned long long k = static_cast<unsigned long long>(x);
+	k &= ~0ULL >> (8 * (sizeof(k) - sizeof(T)));
+	if (std::numeric_limits<T>::is_signed)
+		k ^= 1ULL << (8 * sizeof(T) - 1);
+	return (k);
+}
+
+template <typename Src, typename Dst>
+void radix_pass(Src src, std::size_t n, Dst dst, unsigned shift, const std::size_t* count) {
+	std::size_t offset[256];
+	std::size_t sum = 0;
+	for (unsigned b = 0; b < 256; b++) {
+		offset[b] = sum;
+		sum += count[b];
+	}
+	for (std::size_t i = 0; i < n; ++i, ++src)
+		*(dst + offset[(radix_key(*src) >> shift) & 0xff]++) = *src;
+}
+
+// LSD radix sort for integral elements. Equal integers cannot be told
+// apart, so input already in either order is just left or reversed.
+template <typename It>
+void radix_sort(It first, It last) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	const unsigned bytes = sizeof(value_type);
+	std::size_t n = last - first;
+	if (n < 2)
+		return;
+	It i = first + 1;
+	while (i != last && !(*i < *(i - 1)))
+		++i;
+	if (i == last)
+		return;
+	for (i = first + 1; i != last && !(*(i - 1) < *i); )
+		++i;
+	if (i == last) {
+		std::reverse(first, last);
+		return;
+	}
+	std::size_t count[bytes][256];
+	for (unsigned b = 0; b < bytes; b++)
+		for (unsigned v = 0; v < 256; v++)
+			count[b][v] = 0;
+	for (i = first; i != last; ++i) {
+		unsigned long long k = radix_key(*i);
+		for (unsigned b = 0; b < bytes; b++, k >>= 8)
+			count[b][k & 0xff]++;
+	}
+	// Integers need no construction, so the buffer is left raw.
+	std::allocator<value_type> alloc;
+	value_type* tmp = alloc.allocate(n);
+	bool in_buffer = false;
+	for (unsigned b = 0; b < bytes; b++) {
+		// A byte that is the same everywhere would not move anything.
+		if (count[b][(radix_key(*first) >> (8 * b)) & 0xff] == n)
+			continue;
+		if (in_buffer)
+			radix_pass(tmp, n, first, 8 * b, count[b]);
+		else
+			radix_pass(first, n, tmp, 8 * b, count[b]);
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer)
+		std::copy(tmp, tmp + n, first);
+	alloc.deallocate(tmp, n);
+}
+
+template <typename Src, typename Dst, typename Compare>
+Dst sort_merge(Src first1, Src last1, Src first2, Src last2, Dst out, Compare comp) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first2, *first1))
+			*out = *first2++;
+		else
+			*out = *first1++;
+		++out;
+	}
+	for (; first1 != last1; ++first1, ++out)
+		*out = *first1;
+	for (; first2 != last2; ++first2, ++out)
+		*out = *first2;
+	return (out);
+}
+
+template <typename Src, typename Dst, typename Compare>
+void merge_sort_pass(Src src, std::size_t n, Dst dst, std::size_t width, Compare comp) {
+	for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+		std::size_t mid = std::min(lo + width, n);
+		std::size_t hi = std::min(lo + 2 * width, n);
+		sort_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+	}
+}
+
+template <typename It, typename Compare>
+void merge_sort(It first, It last, Compare comp) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	std::size_t n = last - first;
+	for (std::size_t lo = 0; lo < n; lo += sort_tuning::RUN)
+		insertion_sort(first + lo, first + std::min<std::size_t>(lo + sort_tuning::RUN, n), comp);
+	if (n <= sort_tuning::RUN)
+		return;
+	sort_buffer<value_type> buffer(first, n);
+	value_type* tmp = buffer.data();
+	bool in_buffer = false;
+	for (std::size_t width = sort_tuning::RUN; width < n; width *= 2) {
+		if (in_buffer)
+			merge_sort_pass(tmp, n, first, width, comp);
+		else
+			merge_sort_pass(first, n, tmp, width, comp);
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer)
+		std::copy(tmp, tmp + n, first);
+}
+
+template <typename It, typename Compare>
+inline void sort(It first, It last, Compare comp) {
+	if (last - first < 2)
+		return;
+	introsort_loop(first, last, sort_depth_limit(last - first), comp);
+	insertion_sort(first, last, comp);
+}
+
+// What sort and stable_sort do without a comparator: radix sort for
+// integral elements, unless there are too few to pay for the counts.
+template <typename T, bool Integral = is_integral<T>::value>
+struct default_sort {
+	template <typename It>
+	static void sort(It first, It last) {
+		ft::sort(first, last, sort_less<T>());
+	}
+
+	template <typename It>
+	static void stable_sort(It first, It last) {
+		merge_sort(first, last, sort_less<T>());
+	}
+};
+
+template <typename T>
+struct default_sort<T, true> {
+	template <typename It>
+	static void sort(It first, It last) {
+		if (last - first >= sort_tuning::RADIX_MIN)
+			radix_sort(first, last);
+		else
+			ft::sort(first, last, sort_less<T>());
+	}
+
+	template <typename It>
+	static void stable_sort(It first, It last) {
+		sort(first, last);
+	}
+};
+
+template <typename It>
+inline void sort(It first, It last) {
+	default_sort<typename iterator_traits<It>::value_type>::sort(first, last);
+}
+
+template <typename It, typename Compare>
+inline void stable_sort(It first, It last, Compare comp) {
+	merge_sort(first, last, comp);
+}
+
+template <typename It>
+inline void stable_sort(It first, It last) {
+	default_sort<typename iterator_traits<It>::value_type>::stable_sort(first, last);
+}
+
+// Puts the middle - first smallest elements, sorted, in [first, middle);
+// the rest are left in no particular order.
+template <typename It, typename Compare>
+void partial_sort(It first, It middle, It last, Compare comp) {
+	typedef typename iterator_traits<It>::difference_type	Distance;
+	typedef typename iterator_traits<It>::value_type	value_type;
+	if (first == middle)
+		return;
+	ft::make_heap(first, middle, comp);
+	for (It i = middle; i != last; ++i) {
+		if (comp(*i, *first)) {
+			value_type v = *i;
+			*i = *first;
+			sort_sift_down(first, Distance(0), Distance(middle - first), v, comp);
+		}
+	}
+	ft::sort_heap(first, middle, comp);
+}
+
+template <typename It>
+inline void partial_sort(It first, It middle, It last) {
+	ft::partial_sort(first, middle, last, sort_less<typename iterator_traits<It>::value_type>());
+}
+
+// Puts in *nth the element that sorting would put there, with nothing
+// greater before it and nothing smaller after it. Quickselect, falling
+// back to a heap selection when the partitions keep coming out uneven.
+template <typename It, typename Compare>
+void nth_element(It first, It nth, It last, Compare comp) {
+	if (nth == last)
+		return;
+	std::size_t depth = sort_depth_limit(last - first);
+	while (last - first > sort_tuning::INSERTION) {
+		if (depth == 0) {
+			ft::partial_sort(first, nth + 1, last, comp);
+			return;
+		}
+		depth--;
+		It cut = sort_partition_pivot(first, last, comp);
+		if (cut <= nth)
+			first = cut;
+		else
+			last = cut;
+	}
+	insertion_sort(first, last, comp);
+}
+
+template <typename It>
+inline void nth_element(It first, It nth, It last) {
+	ft::nth_element(first, nth, last, sort_less<typename iterator_traits<It>::value_type>());
+}
+
+template <typename It, typename Compare>
+bool is_sorted(It first, It last, Compare comp) {
+	if (first == last)
+		return (true);
+	for (It next = first + 1; next != last; ++first, ++next)
+		if (comp(*next, *first))
+			return (false);
+	return (true);
+}
+
+template <typename It>
+inline bool is_sorted(It first, It last) {
+	return (ft::is_sorted(first, last, sort_less<typename iterator_traits<It>::value_type>()));
+}
+
+/*****************************************************************************\
+* 							BINARY SEARCH		 							   *
+\*****************************************************************************/
+
+/*
+		Branch-free binary search: each halving step picks the next base
+		with a conditional move and prefetches both places the following
+		step may probe. Once what is left fits in a cache line, the answer
+		is found by counting the elements that come before it, which for
+		int, unsigned, float and double in contiguous storage under the
+		default order is done four or two at a time with SSE2.
+*/
+
+struct search_less {
+	template <typename A, typename B>
+	bool operator()(const A& a, const B& b) const {
+		return (a < b);
+	}
+};
+
+// Whether e comes before the lower (or upper) bound of value.
+template <bool Upper>
+struct search_order {
+	template <typename E, typename T, typename Compare>
+	static bool before(const E& e, const T& value, Compare& comp) {
+		return (comp(e, value));
+	}
+};
+
+template <>
+struct search_order<true> {
+	template <typename E, typename T, typename Compare>
+	static bool before(const E& e, const T& value, Compare& comp) {
+		return (!comp(value, e));
+	}
+};
+
+template <typename It>
+struct contiguous_iterator {
+	enum { value = 0 };
+};
+
+template <typename T>
+struct contiguous_iterator<T*> {
+	enum { value = 1 };
+
+	static const T* address(T* it) {
+		return (it);
+	}
+};
+
+template <typename P>
+struct contiguous_iterator<random_access_iterator<P> > {
+	enum { value = 1 };
+
+	static const typename random_access_iterator<P>::value_type*
+	address(const random_access_iterator<P>& it) {
+		return (it.base());
+	}
+};
+
+// Elements of T per cache line.
+template <typename T>
+inline std::size_t search_line(void) {
+	enum { LINE = 64 };
+	return (sizeof(T) < LINE ? LINE / sizeof(T) : 1);
+}
+
+// Narrows [base, base + n) to at most line elements that still hold the
+// answer, or are followed by it.
+template <bool Upper, typename It, typename T, typename Compare>
+It search_narrow(It base, std::size_t& n, const T& value, Compare& comp, std::size_t line) {
+	while (n > line) {
+		std::size_t half = n / 2;
+		n -= half;
+		__builtin_prefetch(&*(base + n / 2));
+		__builtin_prefetch(&*(base + (half + n / 2)));
+		base = (search_order<Upper>::before(*(base + half), value, comp) ? base + half : base);
+	}
+	return (base);
+}
+
+template <bool Upper, typename It, typename T, typename Compare>
+std::size_t search_count(It base, std::size_t n, const T& value, Compare& comp) {
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < n; i++)
+		count += search_order<Upper>::before(*(base + i), value, comp);
+	return (count);
+}
+
+template <typename T, bool Upper>
+struct simd_count {
+	static std::size_t count(const T* p, std::size_t n, const T& value) {
+		search_less less;
+		return (search_count<Upper>(p, n, value, less));
+	}
+};
+
+#ifdef __SSE2__
+template <bool Upper>
+struct simd_count<int, Upper> {
+	static std::size_t count(const int* p, std::size_t n, const int& value) {
+		__m128i v = _mm_set1_epi32(value);
+		std::size_t c = 0;
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			if (Upper)
+				c += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, v))));
+			else
+				c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(x, v))));
+		}
+		search_less less;
+		return (c + search_count<Upper>(p + i, n - i, value, less));
+	}
+};
+
+// Flipping the sign bit maps unsigned order onto signed order.
+template <bool Upper>
+struct simd_count<unsigned, Upper> {
+	static std::size_t count(const unsigned* p, std::size_t n, const unsigned& value) {
+		__m128i flip = _mm_set1_epi32(static_cast<int>(0x80000000u));
+		__m128i v = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(value)), flip);
+		std::size_t c = 0;
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), flip);
+			if (Upper)
+				c += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, v))));
+			else
+				c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(x, v))));
+		}
+		search_less less;
+		return (c + search_count<Upper>(p + i, n - i, value, less));
+	}
+};
+
+template <bool Upper>
+struct simd_count<float, Upper> {
+	static std::size_t count(const float* p, std::size_t n, const float& value) {
+		__m128 v = _mm_set1_ps(value);
+		std::size_t c = 0;
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128 x = _mm_loadu_ps(p + i);
+			c += __builtin_popcount(_mm_movemask_ps(Upper ? _mm_cmple_ps(x, v) : _mm_cmplt_ps(x, v)));
+		}
+		search_less less;
+		return (c + search_count<Upper>(p + i, n - i, value, less));
+	}
+};
+
+template <bool Upper>
+struct simd_count<double, Upper> {
+	static std::size_t count(const double* p, std::size_t n, const double& value) {
+		__m128d v = _mm_set1_pd(value);
+		std::size_t c = 0;
+		std::size_t i = 0;
+		for (; i + 2 <= n; i += 2) {
+			__m128d x = _mm_loadu_pd(p + i);
+			c += __builtin_popcount(_mm_movemask_pd(Upper ? _mm_cmple_pd(x, v) : _mm_cmplt_pd(x, v)));
+		}
+		search_less less;
+		return (c + search_count<Upper>(p + i, n - i, value, less));
+	}
+};
+#endif
+
+// The element and searched types differ: no vector compare applies.
+template <bool Upper, typename V, typename T>
+inline std::size_t search_count_default(const V* p, std::size_t n, const T& value) {
+	search_less less;
+	return (search_count<Upper>(p, n, value, less));
+}
+
+template <bool Upper, typename V>
+inline std::size_t search_count_default(const V* p, std::size_t n, const V& value) {
+	return (simd_count<V, Upper>::count(p, n, value));
+}
+
+template <bool Upper, typename It, typename T, typename Compare>
+It branchless_search(It first, It last, const T& value, Compare comp) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	std::size_t n = last - first;
+	It base = search_narrow<Upper>(first, n, value, comp, search_line<value_type>());
+	return (base + search_count<Upper>(base, n, value, comp));
+}
+
+template <typename It, bool Contiguous = contiguous_iterator<It>::value>
+struct default_search {
+	template <bool Upper, typename T>
+	static It search(It first, It last, const T& value) {
+		return (branchless_search<Upper>(first, last, value, search_less()));
+	}
+};
+
+template <typename It>
+struct default_search<It, true> {
+	template <bool Upper, typename T>
+	static It search(It first, It last, const T& value) {
+		typedef typename iterator_traits<It>::value_type	value_type;
+		search_less less;
+		std::size_t n = last - first;
+		It base = search_narrow<Upper>(first, n, value, less, search_line<value_type>());
+		const value_type* p = contiguous_iterator<It>::address(base);
+		return (base + search_count_default<Upper>(p, n, value));
+	}
+};
+
+template <typename It, typename T, typename Compare>
+inline It lower_bound(It first, It last, const T& value, Compare comp) {
+	return (branchless_search<false>(first, last, value, comp));
+}
+
+template <typename It, typename T>
+inline It lower_bound(It first, It last, const T& value) {
+	return (default_search<It>::template search<false>(first, last, value));
+}
+
+template <typename It, typename T, typename Compare>
+inline It upper_bound(It first, It last, const T& value, Compare comp) {
+	return (branchless_search<true>(first, last, value, comp));
+}
+
+template <typename It, typename T>
+inline It upper_bound(It first, It last, const T& value) {
+	return (default_search<It>::template search<true>(first, last, value));
+}
+
+template <typename It, typename T, typename Compare>
+inline bool binary_search(It first, It last, const T& value, Compare comp) {
+	first = ft::lower_bound(first, last, value, comp);
+	return (first != last && !comp(value, *first));
+}
+
+template <typename It, typename T>
+inline bool binary_search(It first, It last, const T& value) {
+	first = ft::lower_bound(first, last, value);
+	return (first != last && !(value < *first));
+}
+
+template <typename It, typename T, typename Compare>
+inline ft::pair<It, It> equal_range(It first, It last, const T& value, Compare comp) {
+	first = ft::lower_bound(first, last, value, comp);
+	return (ft::make_pair(first, ft::upper_bound(first, last, value, comp)));
+}
+
+template <typename It, typename T>
+inline ft::pair<It, It> equal_range(It first, It last, const T& value) {
+	first = ft::lower_bound(first, last, value);
+	return (ft::make_pair(first, ft::upper_bound(first, last, value)));
+}
+
+/*
+		Lower bounds of a sorted run of queries, written to out in order.
+		Each search starts where the previous answer was and gallops ahead
+		in doubling steps before the binary search, so it costs the log of
+		the distance moved: dense queries make one pass over the range and
+		sparse ones cost no more than separate searches.
+*/
+template <typename It, typename QueryIt, typename OutputIt, typename Compare>
+OutputIt lower_bound_many(It first, It last, QueryIt qfirst, QueryIt qlast, OutputIt out,
+						Compare comp) {
+	std::size_t n = last - first;
+	std::size_t lo = 0;
+	for (; qfirst != qlast; ++qfirst, ++out) {
+		std::size_t step = 1;
+		while (lo + step <= n && comp(*(first + (lo + step - 1)), *qfirst)) {
+			lo += step;
+			step *= 2;
+		}
+		std::size_t hi = std::min(lo + step, n);
+		lo = ft::lower_bound(first + lo, first + hi, *qfirst, comp) - first;
+		*out = first + lo;
+	}
+	return (out);
+}
+
+template <typename It, typename QueryIt, typename OutputIt>
+OutputIt lower_bound_many(It first, It last, QueryIt qfirst, QueryIt qlast, OutputIt out) {
+	std::size_t n = last - first;
+	std::size_t lo = 0;
+	for (; qfirst != qlast; ++qfirst, ++out) {
+		std::size_t step = 1;
+		while (lo + step <= n && *(first + (lo + step - 1)) < *qfirst) {
+			lo += step;
+			step *= 2;
+		}
+		std::size_t hi = std::min(lo + step, n);
+		lo = ft::lower_bound(first + lo, first + hi, *qfirst) - first;
+		*out = first + lo;
+	}
+	return (out);
+}
+
 }
 
 #endif
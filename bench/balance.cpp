@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <string>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../tree_balance.hpp"
+
+// Each balance policy on n keys: inserted in order, inserted in random
+// order, then 4n finds of uniformly drawn keys and 4n finds drawn from a
+// Zipf distribution (s = 1) over the same keys.
+template <typename Map>
+static void run(const std::string& name, const ft::vector<int>& keys, const ft::vector<int>& uniform,
+				const ft::vector<int>& zipf) {
+	{
+		Map m;
+		bench_timer t;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			m.insert(m.end(), ft::make_pair(static_cast<int>(i), 0));
+		bench_report((name + " insert sorted").c_str(), t.seconds(), m.size());
+	}
+	Map m;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+		bench_report((name + " insert uniform").c_str(), t.seconds(), m.size());
+	}
+	unsigned long long sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < uniform.size(); i++)
+			sum += m.find(uniform[i])->second;
+		bench_report((name + " find uniform").c_str(), t.seconds(), sum);
+	}
+	sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < zipf.size(); i++)
+			sum += m.find(zipf[i])->second;
+		bench_report((name + " find zipf").c_str(), t.seconds(), sum);
+	}
+}
+
+void bench_balance(std::size_t n) {
+	ft::vector<int> keys;
+	keys.reserve(n);
+	for (std::size_t i = 0; i < n; i++)
+		keys.push_back(static_cast<int>(i));
+	unsigned long long seed = 32;
+	for (std::size_t i = n; i > 1; i--)
+		std::swap(keys[i - 1], keys[bench_random(seed) % i]);
+	ft::vector<double> cumulative;
+	cumulative.reserve(n);
+	double total = 0;
+	for (std::size_t i = 0; i < n; i++) {
+		total += 1.0 / (i + 1);
+		cumulative.push_back(total);
+	}
+	ft::vector<int> uniform;
+	ft::vector<int> zipf;
+	for (std::size_t i = 0; i < 4 * n; i++) {
+		uniform.push_back(keys[bench_random(seed) % n]);
+		double r = (bench_random(seed) >> 11) * (total / 9007199254740992.0);
+		std::size_t rank = std::upper_bound(&cumulative[0], &cumulative[0] + n, r) - &cumulative[0];
+		zipf.push_back(keys[rank < n ? rank : n - 1]);
+	}
+	run<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::rb_balance> >(
+		"rb", keys, uniform, zipf);
+	run<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::avl_balance> >(
+		"avl", keys, uniform, zipf);
+	run<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::treap_balance> >(
+		"treap", keys, uniform, zipf);
+	run<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::splay_balance> >(
+		"splay", keys, uniform, zipf);
+}
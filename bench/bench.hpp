@@ -0,0 +1,73 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+#include "../thread.hpp"
+#include "../vector.hpp"
+
+/*
+		Benchmarks behind the timings quoted for the containers and the
+		algorithms. Each case builds its input from a fixed seed, times the
+		ft version against ft::map or the std one and prints seconds. The
+		checksums keep the work from being optimised away and should match
+		between the two sides of a row.
+*/
+
+struct bench_case {
+	const char*											name;
+	void												(*run)(std::size_t n);
+	std::size_t											n;
+};
+
+// xorshift64*, so that every run times the same input.
+inline unsigned long long bench_random(unsigned long long& state) {
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return (state * 2685821657736338717ULL);
+}
+
+class bench_timer {
+	double												_start;
+
+ public:
+	bench_timer(void) : _start(ft::monotonic_seconds()) {}
+
+	double seconds(void) const {
+		return (ft::monotonic_seconds() - _start);
+	}
+};
+
+inline void bench_report(const char* what, double seconds, unsigned long long checksum) {
+	std::cout << "  " << std::left << std::setw(40) << what << std::right << std::fixed
+		<< std::setprecision(3) << std::setw(9) << seconds << " s   " << checksum << std::endl;
+}
+
+// Random keys of the full width of Key, from seed.
+template <typename Key>
+ft::vector<Key> bench_keys(std::size_t n, unsigned long long seed) {
+	ft::vector<Key> keys;
+	keys.reserve(n);
+	for (std::size_t i = 0; i < n; i++)
+		keys.push_back(static_cast<Key>(bench_random(seed)));
+	return (keys);
+}
+
+void bench_flat_map(std::size_t n);
+void bench_find_batch(std::size_t n);
+void bench_concurrent_map(std::size_t n);
+void bench_sharded_map(std::size_t n);
+void bench_balance(std::size_t n);
+void bench_insert_hint(std::size_t n);
+void bench_radix_map(std::size_t n);
+void bench_string_radix_map(std::size_t n);
+void bench_filtered_map(std::size_t n);
+void bench_parallel(std::size_t n);
+void bench_serialize(std::size_t n);
+void bench_sort(std::size_t n);
+void bench_search(std::size_t n);
+
+#endif
@@ -0,0 +1,25 @@
+#include <sstream>
+
+#include "bench.hpp"
+#include "threads.hpp"
+#include "../concurrent_map.hpp"
+
+// concurrent_map against one locked ft::map at 0, 10 and 50% writes,
+// over 1 to max_threads() threads, on 1M keys half of them present.
+void bench_concurrent_map(std::size_t n) {
+	static const unsigned writes[] = {0, 10, 50};
+	enum { RANGE = 1 << 20 };
+	std::cout << "  " << ft::thread::hardware_concurrency() << " cores" << std::endl;
+	for (std::size_t w = 0; w < sizeof(writes) / sizeof(*writes); w++) {
+		ft::concurrent_map<int, int> lock_free;
+		locked_map<int, int> locked;
+		fill_mix(lock_free, RANGE);
+		fill_mix(locked, RANGE);
+		std::ostringstream mix;
+		mix << writes[w] << "% writes ";
+		for (unsigned threads = 1; threads <= max_threads(); threads *= 2) {
+			run_mix(mix.str() + "concurrent_map", lock_free, threads, writes[w], n, RANGE);
+			run_mix(mix.str() + "locked ft::map", locked, threads, writes[w], n, RANGE);
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#include <sstream>
+#include <string>
+
+#include "bench.hpp"
+#include "../filtered_map.hpp"
+#include "../map.hpp"
+
+// n unsigned keys, all even, so that odd keys are certainly absent. Then
+// n count() calls for each share of misses.
+template <typename Map>
+static double count_keys(const Map& m, const ft::vector<unsigned>& queries, unsigned long long& hits) {
+	bench_timer t;
+	hits = 0;
+	for (std::size_t i = 0; i < queries.size(); i++)
+		hits += m.count(queries[i]);
+	return (t.seconds());
+}
+
+void bench_filtered_map(std::size_t n) {
+	unsigned long long seed = 41;
+	ft::filtered_map<unsigned, int> filtered;
+	ft::map<unsigned, int> plain;
+	ft::vector<unsigned> keys;
+	keys.reserve(n);
+	while (plain.size() < n) {
+		unsigned k = static_cast<unsigned>(bench_random(seed)) & ~1u;
+		if (plain.insert(ft::make_pair(k, 0)).second) {
+			filtered.insert(ft::make_pair(k, 0));
+			keys.push_back(k);
+		}
+	}
+	unsigned long long positives = 0;
+	for (std::size_t i = 0; i < n; i++)
+		positives += filtered.filter().may_contain(static_cast<unsigned>(bench_random(seed)) | 1u);
+	std::cout << "  filter " << filtered.filter_bytes() << " bytes ("
+		<< static_cast<double>(filtered.filter_bytes()) / n << " per key), false positives expected "
+		<< filtered.false_positive_rate() * 100 << "%, measured "
+		<< positives * 100.0 / n << "%" << std::endl;
+
+	static const int misses[] = {0, 50, 90, 99};
+	for (std::size_t m = 0; m < sizeof(misses) / sizeof(*misses); m++) {
+		ft::vector<unsigned> queries;
+		queries.reserve(n);
+		for (std::size_t i = 0; i < n; i++) {
+			unsigned long long r = bench_random(seed);
+			if (static_cast<int>(r % 100) < misses[m])
+				queries.push_back(static_cast<unsigned>(r >> 32) | 1u);
+			else
+				queries.push_back(keys[(r >> 32) % n]);
+		}
+		unsigned long long hits[2];
+		double seconds[2];
+		seconds[0] = count_keys(filtered, queries, hits[0]);
+		seconds[1] = count_keys(plain, queries, hits[1]);
+		std::ostringstream label;
+		label << "count, " << misses[m] << "% misses";
+		bench_report(("filtered_map " + label.str()).c_str(), seconds[0], hits[0]);
+		bench_report(("ft::map " + label.str()).c_str(), seconds[1], hits[1]);
+	}
+}
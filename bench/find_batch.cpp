@@ -0,0 +1,52 @@
+#include <algorithm>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+// n queries, half of them present, on an ft::map of twice as many random
+// int keys: a loop of find, find_batch in random order, then find_batch
+// on the same queries sorted.
+static unsigned long long sum_found(const ft::map<int, int>& m,
+									const ft::vector<ft::map<int, int>::const_iterator>& found) {
+	unsigned long long sum = 0;
+	for (std::size_t i = 0; i < found.size(); i++)
+		if (found[i] != m.end())
+			sum += found[i]->second;
+	return (sum);
+}
+
+void bench_find_batch(std::size_t n) {
+	ft::vector<int> keys = bench_keys<int>(2 * n, 28);
+	ft::map<int, int> m;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	const ft::map<int, int>& view = m;
+	unsigned long long seed = 2828;
+	ft::vector<int> queries;
+	queries.reserve(n);
+	for (std::size_t i = 0; i < n; i++) {
+		unsigned long long r = bench_random(seed);
+		queries.push_back(r & 1 ? keys[(r >> 1) % keys.size()] : static_cast<int>(r >> 32));
+	}
+	ft::vector<ft::map<int, int>::const_iterator> found(n);
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++)
+			found[i] = view.find(queries[i]);
+		double seconds = t.seconds();
+		bench_report("loop of find", seconds, sum_found(view, found));
+	}
+	{
+		bench_timer t;
+		view.find_batch(queries.begin(), queries.end(), found.begin());
+		double seconds = t.seconds();
+		bench_report("find_batch", seconds, sum_found(view, found));
+	}
+	std::sort(&queries[0], &queries[0] + n);
+	{
+		bench_timer t;
+		view.find_batch(queries.begin(), queries.end(), found.begin());
+		double seconds = t.seconds();
+		bench_report("find_batch, sorted queries", seconds, sum_found(view, found));
+	}
+}
@@ -0,0 +1,56 @@
+#include <sstream>
+#include <string>
+
+#include "bench.hpp"
+#include "../flat_map.hpp"
+#include "../map.hpp"
+
+// Maps of 1K to 4M random int keys, each built from one range: n finds of present keys, n
+// lower_bounds of random keys, then enough full in-order walks to visit
+// n elements.
+template <typename Map>
+static void run(const std::string& label, const ft::vector<int>& keys, const ft::vector<int>& probes,
+				std::size_t n) {
+	ft::vector<ft::pair<int, int> > pairs;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		pairs.push_back(ft::make_pair(keys[i], static_cast<int>(i)));
+	Map m(pairs.begin(), pairs.end());
+	unsigned long long sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++)
+			sum += m.find(keys[i % keys.size()])->second;
+		bench_report((label + " find").c_str(), t.seconds(), sum);
+	}
+	sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++) {
+			typename Map::const_iterator it = m.lower_bound(probes[i]);
+			if (it != m.end())
+				sum += it->second;
+		}
+		bench_report((label + " lower_bound").c_str(), t.seconds(), sum);
+	}
+	sum = 0;
+	{
+		std::size_t walks = (n + m.size() - 1) / m.size();
+		bench_timer t;
+		for (std::size_t w = 0; w < walks; w++)
+			for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+				sum += it->second;
+		bench_report((label + " iterate").c_str(), t.seconds(), sum);
+	}
+}
+
+void bench_flat_map(std::size_t n) {
+	static const std::size_t sizes[] = {1 << 10, 1 << 16, 1 << 22};
+	ft::vector<int> probes = bench_keys<int>(n, 2626);
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		ft::vector<int> keys = bench_keys<int>(sizes[s], 26 + s);
+		std::ostringstream size;
+		size << sizes[s] << " ";
+		run<ft::flat_map<int, int> >(size.str() + "flat_map", keys, probes, n);
+		run<ft::map<int, int> >(size.str() + "ft::map", keys, probes, n);
+	}
+}
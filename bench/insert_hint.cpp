@@ -0,0 +1,22 @@
+#include "bench.hpp"
+#include "../map.hpp"
+
+// n ints inserted in increasing order into an ft::map, without a hint and
+// then with the previous insert's result as the hint.
+void bench_insert_hint(std::size_t n) {
+	{
+		ft::map<int, int> m;
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++)
+			m.insert(ft::make_pair(static_cast<int>(i), 0));
+		bench_report("sorted insert", t.seconds(), m.size());
+	}
+	{
+		ft::map<int, int> m;
+		ft::map<int, int>::iterator hint = m.end();
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++)
+			hint = m.insert(hint, ft::make_pair(static_cast<int>(i), 0));
+		bench_report("sorted insert, previous as hint", t.seconds(), m.size());
+	}
+}
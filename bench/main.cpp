@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "bench.hpp"
+
+// Default sizes are those the quoted timings were taken at.
+static const bench_case cases[] = {
+	{"flat_map", bench_flat_map, 4000000},
+	{"find_batch", bench_find_batch, 1000000},
+	{"concurrent_map", bench_concurrent_map, 2000000},
+	{"sharded_map", bench_sharded_map, 1000000},
+	{"balance", bench_balance, 500000},
+	{"insert_hint", bench_insert_hint, 2000000},
+	{"radix_map", bench_radix_map, 10000000},
+	{"string_radix_map", bench_string_radix_map, 1000000},
+	{"filtered_map", bench_filtered_map, 1000000},
+	{"parallel", bench_parallel, 4000000},
+	{"serialize", bench_serialize, 10000000},
+	{"sort", bench_sort, 10000000},
+	{"search", bench_search, 2000000},
+};
+
+static const std::size_t case_count = sizeof(cases) / sizeof(*cases);
+
+static int usage(const char* name) {
+	std::cerr << "usage: " << name << " [-n count] [case ...]\ncases:";
+	for (std::size_t i = 0; i < case_count; i++)
+		std::cerr << " " << cases[i].name;
+	std::cerr << std::endl;
+	return (1);
+}
+
+// Runs the named cases, or all of them, at their default size or at
+// count elements.
+int main(int argc, char** argv) {
+	std::size_t count = 0;
+	int first = 1;
+	if (argc > 2 && std::strcmp(argv[1], "-n") == 0) {
+		count = std::strtoul(argv[2], NULL, 10);
+		if (count == 0)
+			return (usage(argv[0]));
+		first = 3;
+	}
+	for (int i = first; i < argc; i++) {
+		std::size_t c = 0;
+		while (c < case_count && std::strcmp(argv[i], cases[c].name) != 0)
+			c++;
+		if (c == case_count)
+			return (usage(argv[0]));
+	}
+	for (std::size_t c = 0; c < case_count; c++) {
+		bool wanted = (first == argc);
+		for (int i = first; i < argc && !wanted; i++)
+			wanted = (std::strcmp(argv[i], cases[c].name) == 0);
+		if (!wanted)
+			continue;
+		std::size_t n = (count ? count : cases[c].n);
+		std::cout << cases[c].name << " (n = " << n << ")" << std::endl;
+		cases[c].run(n);
+	}
+	return (0);
+}
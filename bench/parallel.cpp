@@ -0,0 +1,57 @@
+#include <functional>
+#include <sstream>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../parallel.hpp"
+
+// for_each and reduce over an ft::map of n keys, done with plain loops
+// and then on pools of 1, 2, 4 ... workers up to twice the core count.
+// The body hashes the key into the value, so that the walk is not all
+// there is to time and every run leaves the same values.
+struct churn_value {
+	void operator()(ft::pair<const long, unsigned long long>& v) const {
+		unsigned long long x = v.first;
+		for (int i = 0; i < 16; i++)
+			x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+		v.second = x;
+	}
+};
+
+void bench_parallel(std::size_t n) {
+	unsigned long long seed = 42;
+	ft::map<long, unsigned long long> m;
+	while (m.size() < n)
+		m.insert(ft::make_pair(static_cast<long>(bench_random(seed)), m.size()));
+	{
+		bench_timer t;
+		churn_value f;
+		for (ft::map<long, unsigned long long>::iterator it = m.begin(); it != m.end(); ++it)
+			f(*it);
+		bench_report("loop for_each", t.seconds(), m.begin()->second);
+	}
+	{
+		bench_timer t;
+		unsigned long long sum = 0;
+		for (ft::map<long, unsigned long long>::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+		bench_report("loop reduce", t.seconds(), sum);
+	}
+	unsigned cores = ft::thread::hardware_concurrency();
+	std::cout << "  " << cores << " cores" << std::endl;
+	for (unsigned workers = 1; workers <= 2 * cores || workers <= 4; workers *= 2) {
+		ft::parallel::work_stealing_pool pool(workers);
+		std::ostringstream label;
+		label << workers << " workers ";
+		{
+			bench_timer t;
+			ft::parallel::for_each(m, churn_value(), pool);
+			bench_report((label.str() + "for_each").c_str(), t.seconds(), m.begin()->second);
+		}
+		{
+			bench_timer t;
+			unsigned long long sum = ft::parallel::reduce(m, 0ULL, std::plus<unsigned long long>(), pool);
+			bench_report((label.str() + "reduce").c_str(), t.seconds(), sum);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#include <string>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../radix_map.hpp"
+
+// Random 64-bit keys: insert all, find each, lower_bound of as many other
+// random keys, then a full in-order scan.
+template <typename Map>
+static void run(const char* name, const ft::vector<long>& keys, const ft::vector<long>& probes) {
+	std::string label(name);
+	Map m;
+	unsigned long long sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			m.insert(typename Map::value_type(keys[i], static_cast<int>(i)));
+		bench_report((label + " insert").c_str(), t.seconds(), m.size());
+	}
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			sum += m.find(keys[i])->second;
+		bench_report((label + " find").c_str(), t.seconds(), sum);
+	}
+	sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < probes.size(); i++) {
+			typename Map::const_iterator it = m.lower_bound(probes[i]);
+			if (it != m.end())
+				sum += it->second;
+		}
+		bench_report((label + " lower_bound").c_str(), t.seconds(), sum);
+	}
+	sum = 0;
+	{
+		bench_timer t;
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->first;
+		bench_report((label + " scan").c_str(), t.seconds(), sum);
+	}
+}
+
+void bench_radix_map(std::size_t n) {
+	ft::vector<long> keys = bench_keys<long>(n, 39);
+	ft::vector<long> probes = bench_keys<long>(n, 3939);
+	run<ft::radix_map<long, int> >("radix_map", keys, probes);
+	run<ft::map<long, int> >("ft::map", keys, probes);
+}
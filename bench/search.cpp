@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <sstream>
+
+#include "bench.hpp"
+#include "../algorithm.hpp"
+
+// n random int queries against sorted arrays of 1K to 256M ints, in ns
+// per query: one by one in random order, then as a sorted run, where the
+// std side is still one lower_bound per query.
+static void report_ns(const std::string& what, double seconds, std::size_t queries,
+					unsigned long long checksum) {
+	std::cout << "  " << std::left << std::setw(40) << what << std::right << std::fixed
+		<< std::setprecision(1) << std::setw(9) << seconds * 1e9 / queries << " ns  " << checksum
+		<< std::endl;
+}
+
+void bench_search(std::size_t n) {
+	static const std::size_t sizes[] = {1 << 10, 1 << 19, 1 << 25, 1 << 28};
+	unsigned long long seed = 50;
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		std::size_t size = sizes[s];
+		ft::vector<int> v;
+		v.reserve(size);
+		for (std::size_t i = 0; i < size; i++)
+			v.push_back(static_cast<int>(2 * i));
+		ft::vector<int> queries;
+		queries.reserve(n);
+		for (std::size_t i = 0; i < n; i++)
+			queries.push_back(static_cast<int>(bench_random(seed) % (2 * size + 1)));
+		const int* first = &v[0];
+		const int* last = first + size;
+		std::ostringstream label;
+		label << size << " ";
+		unsigned long long sum = 0;
+		{
+			bench_timer t;
+			for (std::size_t i = 0; i < n; i++)
+				sum += std::lower_bound(first, last, queries[i]) - first;
+			report_ns(label.str() + "std::lower_bound", t.seconds(), n, sum);
+		}
+		sum = 0;
+		{
+			bench_timer t;
+			for (std::size_t i = 0; i < n; i++)
+				sum += ft::lower_bound(first, last, queries[i]) - first;
+			report_ns(label.str() + "ft::lower_bound", t.seconds(), n, sum);
+		}
+		std::sort(&queries[0], &queries[0] + n);
+		sum = 0;
+		{
+			bench_timer t;
+			for (std::size_t i = 0; i < n; i++)
+				sum += std::lower_bound(first, last, queries[i]) - first;
+			report_ns(label.str() + "sorted queries, std::lower_bound", t.seconds(), n, sum);
+		}
+		sum = 0;
+		{
+			ft::vector<const int*> found(n);
+			bench_timer t;
+			ft::lower_bound_many(first, last, &queries[0], &queries[0] + n, &found[0]);
+			double seconds = t.seconds();
+			for (std::size_t i = 0; i < n; i++)
+				sum += found[i] - first;
+			report_ns(label.str() + "sorted queries, lower_bound_many", seconds, n, sum);
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../serialize.hpp"
+
+// Snapshots of n elements through a file: a vector<long> saved, written
+// as text for comparison and loaded, then a map<int, int> saved and
+// loaded against building it with n inserts in key order. Rates count
+// the bytes of the elements themselves.
+#define SNAPSHOT_FILE "bench_snapshot.tmp"
+
+static void report_rate(const char* what, double seconds, std::size_t bytes) {
+	std::cout << "  " << std::left << std::setw(40) << what << std::right << std::fixed
+		<< std::setprecision(3) << std::setw(9) << seconds << " s   " << bytes / seconds / 1e9
+		<< " GB/s" << std::endl;
+}
+
+void bench_serialize(std::size_t n) {
+	ft::vector<long> v = bench_keys<long>(n, 45);
+	std::size_t bytes = n * sizeof(long);
+	{
+		bench_timer t;
+		std::ofstream os(SNAPSHOT_FILE, std::ios::out | std::ios::binary);
+		ft::save(os, v);
+		os.close();
+		report_rate("vector<long> save", t.seconds(), bytes);
+	}
+	{
+		bench_timer t;
+		std::ofstream os(SNAPSHOT_FILE "txt");
+		for (std::size_t i = 0; i < v.size(); i++)
+			os << v[i] << '\n';
+		os.close();
+		report_rate("vector<long> as text", t.seconds(), bytes);
+		std::remove(SNAPSHOT_FILE "txt");
+	}
+	{
+		ft::vector<long> back;
+		bench_timer t;
+		std::ifstream is(SNAPSHOT_FILE, std::ios::in | std::ios::binary);
+		ft::load(is, back);
+		report_rate("vector<long> load", t.seconds(), bytes);
+		if (!(back == v))
+			std::cout << "  vector<long> load differs" << std::endl;
+	}
+
+	ft::map<int, int> m;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < n; i++)
+			m.insert(m.end(), ft::make_pair(static_cast<int>(i), static_cast<int>(v[i])));
+		bench_report("map<int, int> inserts", t.seconds(), m.size());
+	}
+	bytes = m.size() * 2 * sizeof(int);
+	{
+		bench_timer t;
+		std::ofstream os(SNAPSHOT_FILE, std::ios::out | std::ios::binary);
+		ft::save(os, m);
+		os.close();
+		report_rate("map<int, int> save", t.seconds(), bytes);
+	}
+	{
+		ft::map<int, int> back;
+		bench_timer t;
+		std::ifstream is(SNAPSHOT_FILE, std::ios::in | std::ios::binary);
+		ft::load(is, back);
+		bench_report("map<int, int> load", t.seconds(), back.size());
+		if (!(back == m))
+			std::cout << "  map<int, int> load differs" << std::endl;
+	}
+	std::remove(SNAPSHOT_FILE);
+}
@@ -0,0 +1,38 @@
+#include <sstream>
+#include <string>
+
+#include "bench.hpp"
+#include "threads.hpp"
+#include "../sharded_map.hpp"
+
+// sharded_map with 1, 4, 16 and 64 shards against one locked ft::map, at
+// 10 and 50% writes over 1 to max_threads() threads, on 1M keys half of
+// them present.
+enum { SHARDED_RANGE = 1 << 20 };
+
+template <std::size_t Shards>
+static void run_shards(unsigned threads, unsigned writes, std::size_t n) {
+	ft::sharded_map<int, int, Shards> m;
+	fill_mix(m, SHARDED_RANGE);
+	std::ostringstream label;
+	label << writes << "% writes " << Shards << " shards";
+	run_mix(label.str(), m, threads, writes, n, SHARDED_RANGE);
+}
+
+void bench_sharded_map(std::size_t n) {
+	static const unsigned writes[] = {10, 50};
+	std::cout << "  " << ft::thread::hardware_concurrency() << " cores" << std::endl;
+	for (std::size_t w = 0; w < sizeof(writes) / sizeof(*writes); w++) {
+		for (unsigned threads = 1; threads <= max_threads(); threads *= 2) {
+			locked_map<int, int> locked;
+			fill_mix(locked, SHARDED_RANGE);
+			std::ostringstream label;
+			label << writes[w] << "% writes locked ft::map";
+			run_mix(label.str(), locked, threads, writes[w], n, SHARDED_RANGE);
+			run_shards<1>(threads, writes[w], n);
+			run_shards<4>(threads, writes[w], n);
+			run_shards<16>(threads, writes[w], n);
+			run_shards<64>(threads, writes[w], n);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "bench.hpp"
+#include "../algorithm.hpp"
+#include "../parallel.hpp"
+
+// n longs in four orders: random, sorted, reversed and drawn from 16
+// values. Each sort gets its own copy; the checksum samples the result.
+static unsigned long long sample(const ft::vector<long>& v) {
+	unsigned long long sum = 0;
+	for (std::size_t i = 0; i < v.size(); i += 1 + v.size() / 64)
+		sum = sum * 31 + static_cast<unsigned long long>(v[i]);
+	return (sum);
+}
+
+enum sort_kind { STD_SORT, FT_SORT, FT_SORT_COMPARE, STD_STABLE, FT_STABLE, PARALLEL_SORT };
+
+static void run(const std::string& order, const ft::vector<long>& input, sort_kind kind) {
+	static const char* names[] = {"std::sort", "ft::sort", "ft::sort, comparator", "std::stable_sort",
+								"ft::stable_sort", "ft::parallel::sort"};
+	ft::vector<long> v(input);
+	bench_timer t;
+	switch (kind) {
+		case STD_SORT: std::sort(&v[0], &v[0] + v.size()); break;
+		case FT_SORT: ft::sort(v.begin(), v.end()); break;
+		case FT_SORT_COMPARE: ft::sort(v.begin(), v.end(), std::less<long>()); break;
+		case STD_STABLE: std::stable_sort(&v[0], &v[0] + v.size()); break;
+		case FT_STABLE: ft::stable_sort(v.begin(), v.end(), std::less<long>()); break;
+		case PARALLEL_SORT: ft::parallel::sort(v.begin(), v.end()); break;
+	}
+	bench_report((order + " " + names[kind]).c_str(), t.seconds(), sample(v));
+}
+
+void bench_sort(std::size_t n) {
+	unsigned long long seed = 49;
+	ft::vector<long> orders[4];
+	static const char* order_names[] = {"random", "sorted", "reversed", "16 values"};
+	for (std::size_t i = 0; i < n; i++) {
+		orders[0].push_back(static_cast<long>(bench_random(seed)));
+		orders[3].push_back(static_cast<long>(bench_random(seed) % 16) * 1000003);
+	}
+	orders[1] = orders[0];
+	std::sort(&orders[1][0], &orders[1][0] + n);
+	orders[2].assign(orders[1].rbegin(), orders[1].rend());
+	for (int o = 0; o < 4; o++)
+		for (int k = STD_SORT; k <= FT_SORT_COMPARE; k++)
+			run(order_names[o], orders[o], static_cast<sort_kind>(k));
+	for (int k = STD_STABLE; k <= PARALLEL_SORT; k++)
+		run(order_names[0], orders[0], static_cast<sort_kind>(k));
+}
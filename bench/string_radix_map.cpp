@@ -0,0 +1,58 @@
+#include <malloc.h>
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../string_radix_map.hpp"
+
+// URL-like keys such as /api/users/region-07/account-012345/item/00001234,
+// inserted in random order and then each looked up once in another random
+// order. The heap in use is read from mallinfo2.
+static std::string url(unsigned long long r) {
+	char buf[64];
+	std::sprintf(buf, "/api/users/region-%02u/account-%06u/item/%08u", static_cast<unsigned>(r % 20),
+				static_cast<unsigned>((r >> 8) % 1000000), static_cast<unsigned>((r >> 32) % 100000000));
+	return (buf);
+}
+
+static std::size_t heap_in_use(void) {
+	return (mallinfo2().uordblks);
+}
+
+template <typename Map>
+static void run(const char* name, const ft::vector<std::string>& keys, const ft::vector<std::size_t>& order) {
+	std::string label(name);
+	std::size_t before = heap_in_use();
+	Map* m = new Map;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			(*m)[keys[i]] = static_cast<int>(i);
+		bench_report((label + " insert").c_str(), t.seconds(), m->size());
+	}
+	std::cout << "  " << label << " heap " << (heap_in_use() - before) / 1000000 << " MB" << std::endl;
+	unsigned long long sum = 0;
+	{
+		bench_timer t;
+		for (std::size_t i = 0; i < order.size(); i++)
+			sum += m->find(keys[order[i]])->second;
+		bench_report((label + " random find").c_str(), t.seconds(), sum);
+	}
+	delete m;
+}
+
+void bench_string_radix_map(std::size_t n) {
+	unsigned long long seed = 40;
+	ft::vector<std::string> keys;
+	ft::vector<std::size_t> order;
+	keys.reserve(n);
+	order.reserve(n);
+	for (std::size_t i = 0; i < n; i++) {
+		keys.push_back(url(bench_random(seed)));
+		order.push_back(bench_random(seed) % n);
+	}
+	run<ft::string_radix_map<int> >("string_radix_map", keys, order);
+	run<ft::map<std::string, int> >("ft::map", keys, order);
+}
@@ -0,0 +1,111 @@
+#ifndef BENCH_THREADS_H
+#define BENCH_THREADS_H
+
+#include <sstream>
+#include <string>
+
+#include "bench.hpp"
+#include "../map.hpp"
+#include "../thread.hpp"
+
+// An ft::map behind one mutex, with the calls the concurrent maps offer.
+template <typename Key, typename T>
+class locked_map {
+	ft::map<Key, T>										_map;
+	mutable ft::mutex									_mutex;
+
+ public:
+	typedef ft::pair<const Key, T>						value_type;
+
+	bool insert(const value_type& val) {
+		ft::scoped_lock<ft::mutex> guard(_mutex);
+		return (_map.insert(val).second);
+	}
+
+	std::size_t erase(const Key& k) {
+		ft::scoped_lock<ft::mutex> guard(_mutex);
+		return (_map.erase(k));
+	}
+
+	bool find(const Key& k, T& out) const {
+		ft::scoped_lock<ft::mutex> guard(_mutex);
+		typename ft::map<Key, T>::const_iterator it = _map.find(k);
+		if (it == _map.end())
+			return (false);
+		out = it->second;
+		return (true);
+	}
+};
+
+// ops random operations on keys below range: finds, and for writes an
+// insert or an erase with even odds, so the size stays put.
+template <typename Map>
+struct mix_worker {
+	Map*												map;
+	unsigned											writes;
+	std::size_t											ops;
+	unsigned long long									seed;
+	unsigned											range;
+	unsigned long long									hits;
+
+	void operator()(void) {
+		int v;
+		for (std::size_t i = 0; i < ops; i++) {
+			unsigned long long r = bench_random(seed);
+			int k = static_cast<int>((r >> 32) % range);
+			if (r % 100 >= writes)
+				hits += map->find(k, v);
+			else if (r & 128)
+				map->insert(typename Map::value_type(k, k));
+			else
+				map->erase(k);
+		}
+	}
+};
+
+template <typename Map>
+void fill_mix(Map& m, unsigned range) {
+	for (unsigned k = 0; k < range; k += 2)
+		m.insert(typename Map::value_type(k, k));
+}
+
+// Splits n operations over threads at the given share of writes and
+// prints the throughput.
+template <typename Map>
+void run_mix(const std::string& name, Map& m, unsigned threads, unsigned writes, std::size_t n,
+			unsigned range) {
+	enum { MAX_THREADS = 256 };
+	mix_worker<Map> workers[MAX_THREADS];
+	ft::thread pool[MAX_THREADS];
+	for (unsigned i = 0; i < threads; i++) {
+		workers[i].map = &m;
+		workers[i].writes = writes;
+		workers[i].ops = n / threads;
+		workers[i].seed = 30 + i;
+		workers[i].range = range;
+		workers[i].hits = 0;
+	}
+	bench_timer t;
+	for (unsigned i = 1; i < threads; i++)
+		pool[i].start(&workers[i]);
+	workers[0]();
+	unsigned long long hits = workers[0].hits;
+	for (unsigned i = 1; i < threads; i++) {
+		pool[i].join();
+		hits += workers[i].hits;
+	}
+	double seconds = t.seconds();
+	std::ostringstream label;
+	label << name << ", " << threads << " threads";
+	std::cout << "  " << std::left << std::setw(40) << label.str() << std::right << std::fixed
+		<< std::setprecision(3) << std::setw(9) << seconds << " s   " << std::setprecision(2)
+		<< n / seconds / 1e6 << " Mops/s   " << hits << std::endl;
+}
+
+// Thread counts to sweep: 1, 2, 4 ... up to twice the cores, at least 4.
+inline unsigned max_threads(void) {
+	unsigned cores = ft::thread::hardware_concurrency();
+	return (cores * 2 > 4 ? cores * 2 : 4);
+}
+
+#endif
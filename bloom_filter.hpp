@@ -0,0 +1,212 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstddef>
+#include <memory>
+
+#include "./hash.hpp"
+
+namespace ft {
+
+// 128 four-bit counters: one cache line.
+struct bloom_block {
+	unsigned char						cells[64];
+};
+
+/*
+		A blocked counting Bloom filter. Each key hashes to one block and
+		sets PROBES counters inside it, so a query costs a single cache
+		miss. Counters make erase possible; one that reaches 15 stays there
+		for good, which can only cost false positives, never a false
+		negative. Sized for COUNTERS_PER_KEY counters (half a byte each)
+		per key of capacity: about 1% false positives when full.
+*/
+template <typename Key, typename Hash = ft::hash<Key>, typename Alloc = std::allocator<Key> >
+class counting_bloom_filter {
+ public:
+	typedef Key											key_type;
+	typedef Hash										hasher;
+	typedef std::size_t									size_type;
+
+	enum {
+		PROBES = 7,
+		COUNTERS_PER_KEY = 10,
+		BLOCK_COUNTERS = 128,
+		SATURATED = 15
+	};
+
+ private:
+	typedef typename Alloc::template rebind<bloom_block>::other	Block_allocator;
+
+	bloom_block*										_blocks;
+	size_type											_nblocks;
+	size_type											_size;
+	size_type											_capacity;
+	hasher												_hash;
+	Block_allocator										_alloc;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit counting_bloom_filter(size_type capacity = 0, const hasher& hash = hasher(),
+				const Alloc& alloc = Alloc())
+		: _blocks(NULL), _nblocks(0), _size(0), _capacity(0), _hash(hash), _alloc(alloc) {
+		reset(capacity);
+	};
+
+	counting_bloom_filter(const counting_bloom_filter& x)
+		: _blocks(NULL), _nblocks(0), _size(0), _capacity(0), _hash(x._hash), _alloc(x._alloc) {
+		*this = x;
+	};
+
+	~counting_bloom_filter(void) {
+		_alloc.deallocate(_blocks, _nblocks);
+	};
+
+	counting_bloom_filter& operator=(const counting_bloom_filter& x) {
+		if (this != &x) {
+			_alloc.deallocate(_blocks, _nblocks);
+			_nblocks = x._nblocks;
+			_blocks = _alloc.allocate(_nblocks);
+			for (size_type i = 0; i < _nblocks; i++)
+				_blocks[i] = x._blocks[i];
+			_size = x._size;
+			_capacity = x._capacity;
+			_hash = x._hash;
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	void insert(const key_type& k) {
+		unsigned long long h;
+		bloom_block& b = _block(k, h);
+		for (int i = 0; i < PROBES; i++, h >>= 7) {
+			unsigned c = _get(b, h & 127);
+			if (c < SATURATED)
+				_set(b, h & 127, c + 1);
+		}
+		_size++;
+	};
+
+	// k must have been inserted and not erased since.
+	void erase(const key_type& k) {
+		unsigned long long h;
+		bloom_block& b = _block(k, h);
+		for (int i = 0; i < PROBES; i++, h >>= 7) {
+			unsigned c = _get(b, h & 127);
+			if (c < SATURATED)
+				_set(b, h & 127, c - 1);
+		}
+		_size--;
+	};
+
+	void clear(void) {
+		for (size_type i = 0; i < _nblocks; i++)
+			_blocks[i] = bloom_block();
+		_size = 0;
+	};
+
+	// Empties the filter and sizes it for capacity keys.
+	void reset(size_type capacity) {
+		size_type nblocks = (capacity * COUNTERS_PER_KEY + BLOCK_COUNTERS - 1) / BLOCK_COUNTERS;
+		if (nblocks == 0)
+			nblocks = 1;
+		if (nblocks != _nblocks) {
+			_alloc.deallocate(_blocks, _nblocks);
+			_blocks = _alloc.allocate(nblocks);
+			_nblocks = nblocks;
+		}
+		_capacity = nblocks * BLOCK_COUNTERS / COUNTERS_PER_KEY;
+		clear();
+	};
+
+	void swap(counting_bloom_filter& x) {
+		std::swap(_blocks, x._blocks);
+		std::swap(_nblocks, x._nblocks);
+		std::swap(_size, x._size);
+		std::swap(_capacity, x._capacity);
+		std::swap(_hash, x._hash);
+		std::swap(_alloc, x._alloc);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	// false means k was never inserted, or has been erased.
+	bool may_contain(const key_type& k) const {
+		unsigned long long h;
+		const bloom_block& b = _block(k, h);
+		unsigned hit = 1;
+		for (int i = 0; i < PROBES; i++, h >>= 7)
+			hit &= (_get(b, h & 127) != 0);
+		return (hit);
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type capacity(void) const {
+		return (_capacity);
+	};
+
+	size_type memory(void) const {
+		return (_nblocks * sizeof(bloom_block));
+	};
+
+	// The chance that a key never inserted passes may_contain(), given the
+	// counters as they are: the mean over blocks of fill ^ PROBES.
+	double false_positive_rate(void) const {
+		double sum = 0;
+		for (size_type i = 0; i < _nblocks; i++) {
+			unsigned used = 0;
+			for (unsigned j = 0; j < BLOCK_COUNTERS; j++)
+				used += (_get(_blocks[i], j) != 0);
+			double p = static_cast<double>(used) / BLOCK_COUNTERS;
+			double q = 1;
+			for (int k = 0; k < PROBES; k++)
+				q *= p;
+			sum += q;
+		}
+		return (sum / _nblocks);
+	};
+
+ private:
+	// The high half of the hash picks the block, the low bits the
+	// counters, seven bits each.
+	bloom_block& _block(const key_type& k, unsigned long long& h) const {
+		unsigned long long x = _hash(k);
+		h = hash_mix(x ^ 0x9e3779b97f4a7c15ULL);
+		return (_blocks[static_cast<size_type>(((x >> 32) * _nblocks) >> 32)]);
+	};
+
+	static unsigned _get(const bloom_block& b, unsigned i) {
+		return ((b.cells[i >> 1] >> ((i & 1) * 4)) & 0xf);
+	};
+
+	static void _set(bloom_block& b, unsigned i, unsigned c) {
+		unsigned shift = (i & 1) * 4;
+		b.cells[i >> 1] = (b.cells[i >> 1] & ~(0xf << shift)) | (c << shift);
+	};
+};
+
+template <typename Key, typename Hash, typename Alloc>
+void swap(counting_bloom_filter<Key, Hash, Alloc>& lhs, counting_bloom_filter<Key, Hash, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
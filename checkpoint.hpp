@@ -0,0 +1,519 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "./Container.hpp"
+#include "./map.hpp"
+#include "./serialize.hpp"
+#include "./thread.hpp"
+#include "./utility.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+/*****************************************************************************\
+* 							CHECKPOINT JOB		 							   *
+\*****************************************************************************/
+
+struct checkpoint_stats {
+	bool												ok;
+	unsigned long long									records;
+	// Old values copied aside because a writer touched them first.
+	unsigned long long									preimages;
+	// Seconds writers were held up by this checkpoint: taking the view,
+	// copying old values, and the part of a lock wait spent behind the
+	// walk or another writer's copy. Writers waiting on each other do not
+	// count.
+	double												stall;
+	double												capture;
+	// The longest the writer thread held the lock at once.
+	double												longest_hold;
+	double												elapsed;
+
+	checkpoint_stats(void)
+		: ok(false), records(0), preimages(0), stall(0), capture(0), longest_hold(0), elapsed(0) {}
+};
+
+typedef void (*checkpoint_callback)(void* context, const checkpoint_stats& stats);
+
+// State shared by a running checkpoint and the futures that wait on it.
+class checkpoint_job {
+ public:
+	std::string											path;
+	checkpoint_callback									callback;
+	void*												context;
+	checkpoint_stats									stats;
+	double												start;
+
+ private:
+	mutex												_mutex;
+	condition											_finished;
+	bool												_done;
+	int													_refs;
+
+	checkpoint_job(const checkpoint_job&);
+	checkpoint_job& operator=(const checkpoint_job&);
+
+ public:
+	checkpoint_job(const char* _path, checkpoint_callback _callback, void* _context)
+		: path(_path), callback(_callback), context(_context), stats(), start(monotonic_seconds()),
+		_done(false), _refs(1) {}
+
+	void retain(void) {
+		__sync_add_and_fetch(&_refs, 1);
+	}
+
+	void release(void) {
+		if (__sync_sub_and_fetch(&_refs, 1) == 0)
+			delete this;
+	}
+
+	// Runs the callback, then wakes the waiters.
+	void complete(void) {
+		if (callback)
+			callback(context, stats);
+		scoped_lock<mutex> guard(_mutex);
+		_done = true;
+		_finished.notify_all();
+	}
+
+	bool done(void) {
+		scoped_lock<mutex> guard(_mutex);
+		return (_done);
+	}
+
+	void wait(void) {
+		scoped_lock<mutex> guard(_mutex);
+		while (!_done)
+			_finished.wait(_mutex);
+	}
+};
+
+class checkpoint_future {
+	checkpoint_job*										_job;
+
+ public:
+	checkpoint_future(void) : _job(NULL) {}
+
+	explicit checkpoint_future(checkpoint_job* job) : _job(job) {
+		if (_job)
+			_job->retain();
+	}
+
+	checkpoint_future(const checkpoint_future& x) : _job(x._job) {
+		if (_job)
+			_job->retain();
+	}
+
+	checkpoint_future& operator=(const checkpoint_future& x) {
+		if (x._job)
+			x._job->retain();
+		if (_job)
+			_job->release();
+		_job = x._job;
+		return (*this);
+	}
+
+	~checkpoint_future(void) {
+		if (_job)
+			_job->release();
+	}
+
+	bool valid(void) const {
+		return (_job != NULL);
+	}
+
+	bool ready(void) const {
+		return (!_job || _job->done());
+	}
+
+	// Blocks until the file is complete, or the checkpoint has failed.
+	const checkpoint_stats& get(void) const {
+		_job->wait();
+		return (_job->stats);
+	}
+};
+
+/*****************************************************************************\
+* 							CHECKPOINT MAP		 							   *
+\*****************************************************************************/
+
+/*
+		An ft::map behind a lock that can write a consistent snapshot of
+		itself to a file while writers carry on. checkpoint() only records
+		the size; a background thread then walks the tree in key order, a
+		few hundred elements per turn of the lock, and writes them out.
+
+		Until it is done, a writer about to change a key the walk has not
+		reached yet first copies the key's old value, or its absence, into
+		an undo map. The walk merges the undo map into the tree and prefers
+		it, so the file holds the map exactly as it was at checkpoint() and
+		only touched elements are ever copied. clear() during a checkpoint
+		hands the old tree to the walk instead of copying anything.
+
+		The file is a snapshot that ft::load() reads back into an ft::map;
+		it is written beside path and renamed into place when complete.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>,
+		class Alloc = std::allocator<ft::pair<const Key, T> > >
+class checkpoint_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(size_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Alloc										allocator_type;
+	typedef ft::map<Key, T, Compare, Alloc>				map_type;
+
+ private:
+	enum { SLICE = 256 };
+
+	typedef ft::pair<Key, T>							record;
+	typedef ft::pair<bool, T>							preimage;
+	typedef typename Alloc::template rebind<ft::pair<const Key, preimage> >::other
+														Undo_allocator;
+	typedef ft::map<Key, preimage, Compare, Undo_allocator>
+														undo_map;
+
+	struct worker {
+		checkpoint_map*									map;
+
+		void operator()(void) {
+			map->_write_checkpoint();
+		}
+	};
+
+	// Takes the lock for a writer and charges the running checkpoint with
+	// the part of the wait that overlaps the last checkpoint work done
+	// under the lock.
+	class writer_lock {
+		checkpoint_map&									_m;
+
+		writer_lock(const writer_lock&);
+		writer_lock& operator=(const writer_lock&);
+
+	 public:
+		explicit writer_lock(checkpoint_map& m) : _m(m) {
+			if (_m._mutex.try_lock())
+				return;
+			double start = monotonic_seconds();
+			_m._mutex.lock();
+			if (_m._job == NULL)
+				return;
+			double from = (start > _m._work_start ? start : _m._work_start);
+			double to = monotonic_seconds();
+			if (_m._work_end < to)
+				to = _m._work_end;
+			if (from < to)
+				_m._job->stats.stall += to - from;
+		}
+
+		~writer_lock(void) {
+			_m._mutex.unlock();
+		}
+	};
+
+	map_type											_map;
+	mutable mutex										_mutex;
+	key_compare											_comp;
+
+	// The running checkpoint: the tree it walks (_map, or the old tree
+	// after a clear), the elements it must write, and the last key done.
+	checkpoint_job*										_job;
+	map_type*											_source;
+	map_type											_detached;
+	undo_map											_undo;
+	size_type											_count;
+	Key													_cursor;
+	bool												_started;
+	// When the last slice of the walk or preimage copy held the lock.
+	double												_work_start;
+	double												_work_end;
+
+	mutex												_checkpoint_mutex;
+	worker												_worker;
+	thread												_writer;
+
+	checkpoint_map(const checkpoint_map&);
+	checkpoint_map& operator=(const checkpoint_map&);
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit checkpoint_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _map(comp, alloc), _comp(comp), _job(NULL), _source(NULL), _detached(comp, alloc),
+		_undo(comp, Undo_allocator(alloc)), _count(0), _cursor(), _started(false),
+		_work_start(0), _work_end(0) {
+		_worker.map = this;
+	};
+
+	// Waits for a running checkpoint to finish.
+	~checkpoint_map(void) {
+		_writer.join();
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (size() == 0);
+	};
+
+	size_type size(void) const {
+		scoped_lock<mutex> guard(_mutex);
+		return (_map.size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	bool insert(const value_type& val) {
+		writer_lock guard(*this);
+		typename map_type::iterator it = _map.find(val.first);
+		if (it != _map.end())
+			return (false);
+		_touch(val.first, it);
+		_map.insert(val);
+		return (true);
+	};
+
+	// Returns true if k was not there before.
+	bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+		writer_lock guard(*this);
+		typename map_type::iterator it = _map.find(k);
+		_touch(k, it);
+		if (it == _map.end()) {
+			_map.insert(value_type(k, obj));
+			return (true);
+		}
+		it->second = obj;
+		return (false);
+	};
+
+	size_type erase(const key_type& k) {
+		writer_lock guard(*this);
+		typename map_type::iterator it = _map.find(k);
+		if (it == _map.end())
+			return (0);
+		_touch(k, it);
+		_map.erase(it);
+		return (1);
+	};
+
+	void clear(void) {
+		map_type empty(_comp, _map.get_allocator());
+		_replace(empty);
+	};
+
+	// Replaces the contents with a snapshot written by checkpoint() or
+	// ft::save(); throws snapshot_error and changes nothing if the file
+	// cannot be read.
+	void restore(const char* path) {
+		std::ifstream is(path, std::ios::in | std::ios::binary);
+		if (!is)
+			throw snapshot_error("checkpoint: cannot open file");
+		map_type m(_comp, _map.get_allocator());
+		load(is, m);
+		_replace(m);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	bool find(const key_type& k, mapped_type& out) const {
+		scoped_lock<mutex> guard(_mutex);
+		typename map_type::const_iterator it = _map.find(k);
+		if (it == _map.end())
+			return (false);
+		out = it->second;
+		return (true);
+	};
+
+	size_type count(const key_type& k) const {
+		scoped_lock<mutex> guard(_mutex);
+		return (_map.count(k));
+	};
+
+ /*****************************************************************************\
+ * 							CHECKPOINT			 							   *
+ \*****************************************************************************/
+
+	// Writes the map as it is now to path on a background thread. Waits
+	// first for the previous checkpoint, if one is still running. The
+	// callback, if any, runs on that thread once the file is complete or
+	// the checkpoint has failed.
+	checkpoint_future checkpoint(const char* path, checkpoint_callback callback = NULL,
+								void* context = NULL) {
+		scoped_lock<mutex> serial(_checkpoint_mutex);
+		_writer.join();
+		checkpoint_job* job = new checkpoint_job(path, callback, context);
+		checkpoint_future future(job);
+		{
+			writer_lock guard(*this);
+			double start = monotonic_seconds();
+			_job = job;
+			_source = &_map;
+			_count = _map.size();
+			_started = false;
+			job->stats.capture = monotonic_seconds() - start;
+			job->stats.stall += job->stats.capture;
+		}
+		if (!_writer.start(&_worker))
+			_write_checkpoint_failed();
+		return (future);
+	};
+
+	bool checkpoint_running(void) const {
+		scoped_lock<mutex> guard(_mutex);
+		return (_job != NULL);
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+	allocator_type get_allocator(void) const {
+		return (_map.get_allocator());
+	};
+
+ private:
+	// Called with the lock held, before k changes; it is at it in _map,
+	// or it is end().
+	void _touch(const key_type& k, typename map_type::iterator it) {
+		if (_source != &_map || (_started && !_comp(_cursor, k)))
+			return;
+		double start = monotonic_seconds();
+		preimage old(it != _map.end(), it != _map.end() ? it->second : mapped_type());
+		if (_undo.insert(ft::make_pair(k, old)).second)
+			_job->stats.preimages++;
+		_work_start = start;
+		_work_end = monotonic_seconds();
+		_job->stats.stall += _work_end - start;
+	};
+
+	void _replace(map_type& m) {
+		map_type old(_comp, _map.get_allocator());
+		{
+			writer_lock guard(*this);
+			if (_source == &_map) {
+				_detached.swap(_map);
+				_source = &_detached;
+			} else {
+				old.swap(_map);
+			}
+			_map.swap(m);
+		}
+	};
+
+	// Moves the next SLICE elements of the view to out; returns false
+	// when the view is used up.
+	bool _take_slice(ft::vector<record>& out) {
+		scoped_lock<mutex> guard(_mutex);
+		double start = monotonic_seconds();
+		typename map_type::iterator it = (_started ? _source->upper_bound(_cursor) : _source->begin());
+		typename undo_map::iterator u = _undo.begin();
+		bool more = true;
+		for (size_type steps = 0; steps < SLICE; steps++) {
+			bool live = (it != _source->end());
+			if (!live && u == _undo.end()) {
+				more = false;
+				break;
+			}
+			if (u != _undo.end() && (!live || !_comp(it->first, u->first))) {
+				if (live && !_comp(u->first, it->first))
+					++it;
+				if (u->second.first)
+					out.push_back(record(u->first, u->second.second));
+				_cursor = u->first;
+				_undo.erase(u++);
+			} else {
+				out.push_back(record(it->first, it->second));
+				_cursor = it->first;
+				++it;
+			}
+			_started = true;
+		}
+		_work_start = start;
+		_work_end = monotonic_seconds();
+		double held = _work_end - start;
+		if (held > _job->stats.longest_hold)
+			_job->stats.longest_hold = held;
+		return (more);
+	};
+
+	void _write_checkpoint(void) {
+		checkpoint_job* job = _job;
+		std::string tmp = job->path + ".tmp";
+		bool ok = false;
+		unsigned long long records = 0;
+		try {
+			std::ofstream os(tmp.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!os)
+				throw snapshot_error("checkpoint: cannot open file");
+			snapshot_writer w(os);
+			w.header('m', 0, _count);
+			ft::vector<record> slice;
+			slice.reserve(SLICE);
+			bool more = true;
+			while (more) {
+				slice.clear();
+				more = _take_slice(slice);
+				for (size_type i = 0; i < slice.size(); i++)
+					serializer<record>::save(w, slice[i]);
+				records += slice.size();
+			}
+			if (records != _count)
+				throw snapshot_error("checkpoint: view lost track of the map");
+			w.finish();
+			os.close();
+			if (!os || std::rename(tmp.c_str(), job->path.c_str()) != 0)
+				throw snapshot_error("checkpoint: write failed");
+			ok = true;
+		} catch (...) {
+			std::remove(tmp.c_str());
+		}
+		_end_checkpoint(ok, records);
+	};
+
+	void _write_checkpoint_failed(void) {
+		_end_checkpoint(false, 0);
+	};
+
+	void _end_checkpoint(bool ok, unsigned long long records) {
+		map_type old(_comp, _map.get_allocator());
+		undo_map undo(_comp, _undo.get_allocator());
+		checkpoint_job* job;
+		{
+			scoped_lock<mutex> guard(_mutex);
+			job = _job;
+			_job = NULL;
+			_source = NULL;
+			old.swap(_detached);
+			undo.swap(_undo);
+		}
+		job->stats.ok = ok;
+		job->stats.records = records;
+		job->stats.elapsed = monotonic_seconds() - job->start;
+		job->complete();
+		job->release();
+	};
+};
+#undef CONTAINER
+
+}
+
+#endif
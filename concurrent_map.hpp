@@ -0,0 +1,469 @@
+#ifndef CONCURRENT_MAP_H
+#define CONCURRENT_MAP_H
+
+#include <functional>
+#include <memory>
+#include <new>
+
+#include "./Container.hpp"
+#include "./epoch.hpp"
+#include "./iterator_traits.hpp"
+#include "./thread.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*
+		Lazy skip list (Herlihy, Lev, Luchangco and Shavit). Lookups and
+		iteration never lock: they follow next pointers published with
+		release stores and only trust nodes that are fully linked and not
+		marked. insert and erase lock just the predecessors they relink.
+		Unlinked nodes go to an epoch_domain and are freed once no reader
+		can still reach them.
+*/
+template <typename T>
+struct skip_node {
+	typedef skip_node<T>*		Node_ptr;
+	T							data;
+	int							top;
+	int							marked;
+	int							linked;
+	spin_lock					lock;
+	Node_ptr					next[1];
+};
+
+template <typename T>
+class concurrent_iterator : public iterator<std::forward_iterator_tag, T> {
+ public:
+	typedef std::forward_iterator_tag		iterator_category;
+	typedef T								value_type;
+	typedef std::ptrdiff_t					difference_type;
+	typedef const T*						pointer;
+	typedef const T&						reference;
+	typedef skip_node<T>*					Node_ptr;
+
+ protected:
+	epoch_guard								guard;
+	Node_ptr								node;
+
+ public:
+	concurrent_iterator(epoch_domain& domain, Node_ptr _node) : guard(domain), node(_node) {
+		skip();
+	}
+
+	~concurrent_iterator(void) {}
+
+	Node_ptr base(void) const {
+		return (node);
+	}
+
+	reference operator*(void) const {
+		return (node->data);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	concurrent_iterator& operator++(void) {
+		node = __atomic_load_n(&node->next[0], __ATOMIC_ACQUIRE);
+		skip();
+		return (*this);
+	}
+
+	concurrent_iterator operator++(int) {
+		concurrent_iterator tmp(*this);
+		++(*this);
+		return (tmp);
+	}
+
+ private:
+	void skip(void) {
+		while (node != NULL && (__atomic_load_n(&node->marked, __ATOMIC_ACQUIRE)
+				|| !__atomic_load_n(&node->linked, __ATOMIC_ACQUIRE)))
+			node = __atomic_load_n(&node->next[0], __ATOMIC_ACQUIRE);
+	}
+};
+
+template <typename T>
+inline bool operator==(const concurrent_iterator<T>& lhs, const concurrent_iterator<T>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename T>
+inline bool operator!=(const concurrent_iterator<T>& lhs, const concurrent_iterator<T>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class concurrent_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Alloc										allocator_type;
+	typedef ft::concurrent_iterator<value_type>			iterator;
+	typedef ft::concurrent_iterator<value_type>			const_iterator;
+
+ private:
+	typedef skip_node<value_type>						Tree_Node;
+	typedef Tree_Node*									Node_ptr;
+	typedef typename Alloc::template rebind<char>::other
+														Byte_allocator;
+
+	enum { MAX_LEVEL = 32 };
+
+	Node_ptr											_head;
+	size_type											_size;
+	allocator_type										_alloc;
+	Byte_allocator										_bytes;
+	key_compare											_comp;
+	mutable epoch_domain								_epoch;
+
+	concurrent_map(const concurrent_map&);
+	concurrent_map& operator=(const concurrent_map&);
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit concurrent_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _head(NULL), _size(0), _alloc(alloc), _bytes(alloc), _comp(comp) {
+		_head = _allocate_node(MAX_LEVEL - 1);
+		_head->linked = 1;
+	};
+
+	template <class InputIterator>
+	concurrent_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type())
+		: _head(NULL), _size(0), _alloc(alloc), _bytes(alloc), _comp(comp) {
+		_head = _allocate_node(MAX_LEVEL - 1);
+		_head->linked = 1;
+		insert(first, last);
+	};
+
+	~concurrent_map(void) {
+		clear();
+		_deallocate_node(_head);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	// Iterators pin the epoch while alive: they never see freed memory, but
+	// they only reflect updates made after they passed a position. Like
+	// epoch_guard, an iterator belongs to the thread that made it and must
+	// be destroyed there; hand another thread a copy made on that thread.
+	const_iterator begin(void) const {
+		return (const_iterator(_epoch, _load(_head->next[0])));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(_epoch, NULL));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (size() == 0);
+	};
+
+	size_type size(void) const {
+		return (__atomic_load_n(&_size, __ATOMIC_RELAXED));
+	};
+
+	size_type max_size(void) const {
+		return (_alloc.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<const_iterator, bool> insert(const value_type& val) {
+		epoch_guard guard(_epoch);
+		Node_ptr preds[MAX_LEVEL];
+		Node_ptr succs[MAX_LEVEL];
+		int top = _random_level();
+
+		while (true) {
+			int found = _find(val.first, preds, succs);
+			if (found != -1) {
+				Node_ptr x = succs[found];
+				if (!_load(x->marked)) {
+					while (!_load(x->linked))
+						sched_yield();
+					return (ft::make_pair(const_iterator(_epoch, x), false));
+				}
+				continue;
+			}
+			int locked;
+			if (!_lock_preds(preds, succs, top, NULL, locked)) {
+				_unlock_preds(preds, locked);
+				continue;
+			}
+			Node_ptr x = _create_node(val, top);
+			for (int l = 0; l <= top; l++)
+				x->next[l] = succs[l];
+			for (int l = 0; l <= top; l++)
+				_store(preds[l]->next[l], x);
+			_store(x->linked, 1);
+			_unlock_preds(preds, top);
+			__sync_fetch_and_add(&_size, 1);
+			return (ft::make_pair(const_iterator(_epoch, x), true));
+		}
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		while (first != last) {
+			insert(*first);
+			++first;
+		}
+	};
+
+	size_type erase(const key_type& k) {
+		epoch_guard guard(_epoch);
+		Node_ptr preds[MAX_LEVEL];
+		Node_ptr succs[MAX_LEVEL];
+		Node_ptr victim = NULL;
+
+		while (true) {
+			int found = _find(k, preds, succs);
+			if (victim == NULL) {
+				if (found == -1)
+					return (0);
+				Node_ptr x = succs[found];
+				if (!_load(x->linked) || x->top != found || _load(x->marked))
+					return (0);
+				x->lock.lock();
+				if (_load(x->marked)) {
+					x->lock.unlock();
+					return (0);
+				}
+				_store(x->marked, 1);
+				victim = x;
+			}
+			int locked;
+			if (!_lock_preds(preds, succs, victim->top, victim, locked)) {
+				_unlock_preds(preds, locked);
+				continue;
+			}
+			for (int l = victim->top; l >= 0; l--)
+				_store(preds[l]->next[l], _load(victim->next[l]));
+			victim->lock.unlock();
+			_unlock_preds(preds, victim->top);
+			__sync_fetch_and_sub(&_size, 1);
+			_epoch.retire(victim, &concurrent_map::_retire_node, this);
+			return (1);
+		}
+	};
+
+	// Not thread-safe: no other thread may use the map meanwhile.
+	void clear(void) {
+		_epoch.synchronize();
+		Node_ptr x = _head->next[0];
+		while (x != NULL) {
+			Node_ptr next = x->next[0];
+			_destroy_node(x);
+			x = next;
+		}
+		for (int l = 0; l < MAX_LEVEL; l++)
+			_head->next[l] = NULL;
+		_size = 0;
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	const_iterator find(const key_type& k) const {
+		epoch_guard guard(_epoch);
+		Node_ptr x = _lower_bound(k);
+		if (_holds(x, k))
+			return (const_iterator(_epoch, x));
+		return (end());
+	};
+
+	// Copies the mapped value out, so no iterator has to stay pinned.
+	bool find(const key_type& k, mapped_type& out) const {
+		epoch_guard guard(_epoch);
+		Node_ptr x = _lower_bound(k);
+		if (!_holds(x, k))
+			return (false);
+		out = x->data.second;
+		return (true);
+	};
+
+	size_type count(const key_type& k) const {
+		epoch_guard guard(_epoch);
+		return (_holds(_lower_bound(k), k));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		epoch_guard guard(_epoch);
+		return (const_iterator(_epoch, _lower_bound(k)));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		epoch_guard guard(_epoch);
+		Node_ptr x = _lower_bound(k);
+		if (x != NULL && !_comp(k, x->data.first))
+			x = _load(x->next[0]);
+		return (const_iterator(_epoch, x));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+ private:
+
+	template <typename V>
+	static V _load(V& x) {
+		return (__atomic_load_n(&x, __ATOMIC_ACQUIRE));
+	};
+
+	template <typename V>
+	static void _store(V& x, V value) {
+		__atomic_store_n(&x, value, __ATOMIC_RELEASE);
+	};
+
+	static int _random_level(void) {
+		static __thread unsigned long seed = 0;
+		if (seed == 0)
+			seed = reinterpret_cast<unsigned long>(&seed) | 1;
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		int level = __builtin_ctzl(seed | (1UL << (MAX_LEVEL - 1)));
+		return (level);
+	};
+
+	static std::size_t _node_bytes(int top) {
+		return (sizeof(Tree_Node) + top * sizeof(Node_ptr));
+	};
+
+	Node_ptr _allocate_node(int top) {
+		Node_ptr x = reinterpret_cast<Node_ptr>(_bytes.allocate(_node_bytes(top)));
+		x->top = top;
+		x->marked = 0;
+		x->linked = 0;
+		new (&x->lock) spin_lock();
+		for (int l = 0; l <= top; l++)
+			x->next[l] = NULL;
+		return (x);
+	};
+
+	void _deallocate_node(Node_ptr x) {
+		x->lock.~spin_lock();
+		_bytes.deallocate(reinterpret_cast<char*>(x), _node_bytes(x->top));
+	};
+
+	Node_ptr _create_node(const value_type& val, int top) {
+		Node_ptr x = _allocate_node(top);
+		_alloc.construct(&x->data, val);
+		return (x);
+	};
+
+	void _destroy_node(Node_ptr x) {
+		_alloc.destroy(&x->data);
+		_deallocate_node(x);
+	};
+
+	static void _retire_node(void* context, void* ptr) {
+		static_cast<concurrent_map*>(context)->_destroy_node(static_cast<Node_ptr>(ptr));
+	};
+
+	// Fills preds/succs for every level and returns the highest level that
+	// holds k, or -1.
+	int _find(const key_type& k, Node_ptr* preds, Node_ptr* succs) const {
+		int found = -1;
+		Node_ptr pred = _head;
+		for (int l = MAX_LEVEL - 1; l >= 0; l--) {
+			Node_ptr curr = _load(pred->next[l]);
+			while (curr != NULL && _comp(curr->data.first, k)) {
+				pred = curr;
+				curr = _load(pred->next[l]);
+			}
+			if (found == -1 && curr != NULL && !_comp(k, curr->data.first))
+				found = l;
+			preds[l] = pred;
+			succs[l] = curr;
+		}
+		return (found);
+	};
+
+	Node_ptr _lower_bound(const key_type& k) const {
+		Node_ptr pred = _head;
+		Node_ptr curr = NULL;
+		for (int l = MAX_LEVEL - 1; l >= 0; l--) {
+			curr = _load(pred->next[l]);
+			while (curr != NULL && _comp(curr->data.first, k)) {
+				pred = curr;
+				curr = _load(pred->next[l]);
+			}
+		}
+		return (curr);
+	};
+
+	// A marked node is logically erased even while it is still linked.
+	bool _holds(Node_ptr x, const key_type& k) const {
+		return (x != NULL && !_comp(k, x->data.first)
+			&& _load(x->linked) && !_load(x->marked));
+	};
+
+	// Locks the distinct predecessors of levels 0..top and checks that they
+	// still point at succs (or at victim when erasing). On failure the
+	// caller unlocks up to `locked` and retries.
+	bool _lock_preds(Node_ptr* preds, Node_ptr* succs, int top, Node_ptr victim, int& locked) {
+		for (int l = 0; l <= top; l++) {
+			if (l == 0 || preds[l] != preds[l - 1])
+				preds[l]->lock.lock();
+			locked = l;
+			Node_ptr succ = (victim != NULL ? victim : succs[l]);
+			if (_load(preds[l]->marked) || _load(preds[l]->next[l]) != succ
+				|| (victim == NULL && succ != NULL && _load(succ->marked)))
+				return (false);
+		}
+		return (true);
+	};
+
+	void _unlock_preds(Node_ptr* preds, int locked) {
+		for (int l = 0; l <= locked; l++) {
+			if (l == 0 || preds[l] != preds[l - 1])
+				preds[l]->lock.unlock();
+		}
+	};
+};
+#undef CONTAINER
+
+};
+#endif
@@ -0,0 +1,1164 @@
+#ifndef DISK_MAP_H
+#define DISK_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./Container.hpp"
+#include "./iterator_traits.hpp"
+#include "./type_traits.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*****************************************************************************\
+* 							PAGE CACHE			 							   *
+\*****************************************************************************/
+
+/*
+		A fixed number of page frames over one file, evicted by CLOCK. A
+		dirty victim is written together with up to WRITE_BATCH - 1 other
+		dirty frames, sorted by page and coalesced into runs, and flush()
+		does the same for all of them. A miss on the page after the previous
+		miss reads READ_AHEAD pages in one call. Pinned frames are never
+		evicted.
+*/
+class disk_page_cache {
+ public:
+	typedef std::size_t									size_type;
+
+	enum {
+		PAGE_SIZE = 4096,
+		READ_AHEAD = 16,
+		WRITE_BATCH = 32,
+		MIN_FRAMES = 16
+	};
+
+ private:
+	enum { NONE = ~0u };
+
+	struct frame {
+		unsigned										page;
+		unsigned										pins;
+		bool											dirty;
+		bool											referenced;
+	};
+
+	int													_fd;
+	unsigned											_nframes;
+	frame*												_frames;
+	char*												_data;
+	int*												_table;
+	unsigned											_mask;
+	unsigned											_hand;
+	unsigned											_last_miss;
+	char*												_ahead;
+	char*												_run;
+	unsigned*											_batch;
+	size_type											_hits;
+	size_type											_reads;
+	size_type											_writes;
+
+	disk_page_cache(const disk_page_cache&);
+	disk_page_cache& operator=(const disk_page_cache&);
+
+ public:
+	disk_page_cache(int fd, unsigned frames)
+		: _fd(fd), _nframes(frames < MIN_FRAMES ? static_cast<unsigned>(MIN_FRAMES) : frames),
+		_frames(NULL), _data(NULL), _table(NULL), _mask(0), _hand(0), _last_miss(NONE),
+		_ahead(NULL), _run(NULL), _batch(NULL), _hits(0), _reads(0), _writes(0) {
+		unsigned slots = 1;
+		while (slots < 2 * _nframes)
+			slots <<= 1;
+		_mask = slots - 1;
+		_frames = new frame[_nframes];
+		_data = new char[static_cast<size_type>(_nframes) * PAGE_SIZE];
+		_table = new int[slots];
+		_ahead = new char[static_cast<size_type>(READ_AHEAD) * PAGE_SIZE];
+		_run = new char[static_cast<size_type>(WRITE_BATCH) * PAGE_SIZE];
+		_batch = new unsigned[_nframes];
+		drop();
+	}
+
+	~disk_page_cache(void) {
+		delete[] _batch;
+		delete[] _run;
+		delete[] _ahead;
+		delete[] _table;
+		delete[] _data;
+		delete[] _frames;
+	}
+
+	// Returns the frame holding page, read from the file if needed.
+	unsigned pin(unsigned page) {
+		int f = _lookup(page);
+		if (f >= 0) {
+			_hits++;
+			_frames[f].pins++;
+			_frames[f].referenced = true;
+			return (f);
+		}
+		if (_last_miss != NONE && page == _last_miss + 1)
+			return (_read_run(page));
+		unsigned g = _victim();
+		_read(data(g), page, 1);
+		_install(g, page, true);
+		_last_miss = page;
+		return (g);
+	}
+
+	// A page with no contents yet: zeroed, dirty, never read.
+	unsigned pin_new(unsigned page) {
+		int f = _lookup(page);
+		unsigned g = (f >= 0 ? static_cast<unsigned>(f) : _victim());
+		std::memset(data(g), 0, PAGE_SIZE);
+		if (f < 0)
+			_install(g, page, true);
+		else
+			_frames[g].pins++;
+		_frames[g].dirty = true;
+		return (g);
+	}
+
+	void unpin(unsigned f) {
+		_frames[f].pins--;
+	}
+
+	void touch(unsigned f) {
+		_frames[f].dirty = true;
+	}
+
+	char* data(unsigned f) const {
+		return (_data + static_cast<size_type>(f) * PAGE_SIZE);
+	}
+
+	// Asks the kernel to start reading page, unless it is cached here. A
+	// no-op where posix_fadvise is missing, as in loader.hpp.
+	void advise(unsigned page) const {
+#ifdef POSIX_FADV_WILLNEED
+		if (_lookup(page) < 0)
+			posix_fadvise(_fd, _offset(page), PAGE_SIZE, POSIX_FADV_WILLNEED);
+#else
+		(void)page;
+#endif
+	}
+
+	void flush(void) {
+		unsigned n = 0;
+		for (unsigned f = 0; f < _nframes; f++)
+			if (_frames[f].page != NONE && _frames[f].dirty)
+				_batch[n++] = f;
+		_write(n);
+	}
+
+	// Forgets every page, dirty or not.
+	void drop(void) {
+		for (unsigned f = 0; f < _nframes; f++) {
+			_frames[f].page = NONE;
+			_frames[f].pins = 0;
+			_frames[f].dirty = false;
+			_frames[f].referenced = false;
+		}
+		for (unsigned i = 0; i <= _mask; i++)
+			_table[i] = -1;
+		_hand = 0;
+		_last_miss = NONE;
+	}
+
+	unsigned frames(void) const {
+		return (_nframes);
+	}
+
+	size_type hits(void) const {
+		return (_hits);
+	}
+
+	// Pages read from and written to the file.
+	size_type reads(void) const {
+		return (_reads);
+	}
+
+	size_type writes(void) const {
+		return (_writes);
+	}
+
+ private:
+	static off_t _offset(unsigned page) {
+		return (static_cast<off_t>(page) * PAGE_SIZE);
+	}
+
+	unsigned _hash(unsigned page) const {
+		return ((page * 2654435761u) & _mask);
+	}
+
+	int _lookup(unsigned page) const {
+		for (unsigned i = _hash(page); _table[i] >= 0; i = (i + 1) & _mask)
+			if (_frames[_table[i]].page == page)
+				return (_table[i]);
+		return (-1);
+	}
+
+	void _install(unsigned f, unsigned page, bool pinned) {
+		unsigned i = _hash(page);
+		while (_table[i] >= 0)
+			i = (i + 1) & _mask;
+		_table[i] = f;
+		_frames[f].page = page;
+		_frames[f].pins = pinned;
+		_frames[f].dirty = false;
+		_frames[f].referenced = pinned;
+	}
+
+	// Linear probing with backward shift, so lookups need no tombstones.
+	void _uninstall(unsigned page) {
+		unsigned i = _hash(page);
+		while (_frames[_table[i]].page != page)
+			i = (i + 1) & _mask;
+		_table[i] = -1;
+		for (unsigned j = (i + 1) & _mask; _table[j] >= 0; j = (j + 1) & _mask) {
+			unsigned h = _hash(_frames[_table[j]].page);
+			if (((j - h) & _mask) >= ((j - i) & _mask)) {
+				_table[i] = _table[j];
+				_table[j] = -1;
+				i = j;
+			}
+		}
+	}
+
+	unsigned _victim(void) {
+		for (unsigned scanned = 0; scanned <= 2 * _nframes; scanned++) {
+			unsigned f = _hand;
+			_hand = (_hand + 1 == _nframes ? 0 : _hand + 1);
+			if (_frames[f].page == NONE)
+				return (f);
+			if (_frames[f].pins)
+				continue;
+			if (_frames[f].referenced) {
+				_frames[f].referenced = false;
+				continue;
+			}
+			if (_frames[f].dirty)
+				_write_behind(f);
+			_uninstall(_frames[f].page);
+			_frames[f].page = NONE;
+			return (f);
+		}
+		throw std::runtime_error("disk_map: every cached page is pinned");
+	}
+
+	void _write_behind(unsigned victim) {
+		unsigned n = 0;
+		_batch[n++] = victim;
+		for (unsigned f = 0; f < _nframes && n < WRITE_BATCH; f++)
+			if (f != victim && _frames[f].page != NONE && _frames[f].dirty && !_frames[f].pins)
+				_batch[n++] = f;
+		_write(n);
+	}
+
+	struct by_page {
+		const frame*									frames;
+
+		bool operator()(unsigned a, unsigned b) const {
+			return (frames[a].page < frames[b].page);
+		}
+	};
+
+	// Writes the frames in _batch[0, n) in page order, one call per run
+	// of consecutive pages.
+	void _write(unsigned n) {
+		by_page cmp;
+		cmp.frames = _frames;
+		std::sort(_batch, _batch + n, cmp);
+		for (unsigned i = 0; i < n; ) {
+			unsigned first = _frames[_batch[i]].page;
+			unsigned k = 0;
+			while (i + k < n && k < WRITE_BATCH && _frames[_batch[i + k]].page == first + k) {
+				std::memcpy(_run + static_cast<size_type>(k) * PAGE_SIZE, data(_batch[i + k]), PAGE_SIZE);
+				_frames[_batch[i + k]].dirty = false;
+				k++;
+			}
+			_pwrite(_run, first, k);
+			i += k;
+		}
+	}
+
+	// Pages cached when the run is read may be newer than the file; they
+	// are skipped even if evicted, and so written, in the meantime.
+	unsigned _read_run(unsigned page) {
+		ssize_t got = pread(_fd, _ahead, static_cast<size_type>(READ_AHEAD) * PAGE_SIZE, _offset(page));
+		if (got < PAGE_SIZE)
+			throw std::runtime_error("disk_map: short read");
+		unsigned k = static_cast<unsigned>(got / PAGE_SIZE);
+		_reads += k;
+		bool cached[READ_AHEAD];
+		for (unsigned i = 1; i < k; i++)
+			cached[i] = (_lookup(page + i) >= 0);
+		unsigned g = _victim();
+		std::memcpy(data(g), _ahead, PAGE_SIZE);
+		_install(g, page, true);
+		for (unsigned i = 1; i < k; i++) {
+			if (cached[i])
+				continue;
+			unsigned h = _victim();
+			std::memcpy(data(h), _ahead + static_cast<size_type>(i) * PAGE_SIZE, PAGE_SIZE);
+			_install(h, page + i, false);
+		}
+		_last_miss = page + k - 1;
+		return (g);
+	}
+
+	void _read(char* out, unsigned page, unsigned n) {
+		size_type len = static_cast<size_type>(n) * PAGE_SIZE;
+		if (pread(_fd, out, len, _offset(page)) != static_cast<ssize_t>(len))
+			throw std::runtime_error("disk_map: short read");
+		_reads += n;
+	}
+
+	void _pwrite(const char* in, unsigned page, unsigned n) {
+		size_type len = static_cast<size_type>(n) * PAGE_SIZE;
+		if (pwrite(_fd, in, len, _offset(page)) != static_cast<ssize_t>(len))
+			throw std::runtime_error("disk_map: write failed");
+		_writes += n;
+	}
+};
+
+// Keeps one page pinned for as long as it lives.
+class disk_page {
+	disk_page_cache&									_cache;
+	unsigned											_frame;
+
+	disk_page(const disk_page&);
+	disk_page& operator=(const disk_page&);
+
+ public:
+	disk_page(disk_page_cache& cache, unsigned page, bool fresh = false)
+		: _cache(cache), _frame(fresh ? cache.pin_new(page) : cache.pin(page)) {}
+
+	~disk_page(void) {
+		_cache.unpin(_frame);
+	}
+
+	char* data(void) const {
+		return (_cache.data(_frame));
+	}
+
+	void touch(void) {
+		_cache.touch(_frame);
+	}
+};
+
+struct disk_page_header {
+	unsigned short										kind;
+	unsigned short										count;
+	unsigned											next;
+	unsigned											prev;
+	unsigned											reserved;
+};
+
+struct disk_map_meta {
+	char												magic[4];
+	unsigned											version;
+	unsigned											page_size;
+	unsigned											key_size;
+	unsigned											mapped_size;
+	unsigned											root;
+	unsigned											pages;
+	unsigned											first_leaf;
+	unsigned											last_leaf;
+	unsigned											height;
+	unsigned long long									size;
+};
+
+/*****************************************************************************\
+* 							ITERATORS			 							   *
+\*****************************************************************************/
+
+// Holds a copy of the element it is on: the page may leave the cache.
+// Page 0 is the header, so leaf 0 stands for end().
+template <typename Map>
+class disk_map_iterator : public iterator<std::bidirectional_iterator_tag, typename Map::value_type> {
+ public:
+	typedef std::bidirectional_iterator_tag				iterator_category;
+	typedef typename Map::value_type					value_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef const value_type*							pointer;
+	typedef const value_type&							reference;
+
+ private:
+	const Map*											_map;
+	unsigned											_leaf;
+	unsigned											_slot;
+	value_type											_value;
+
+ public:
+	disk_map_iterator(void) : _map(NULL), _leaf(0), _slot(0), _value() {}
+
+	disk_map_iterator(const Map* owner, unsigned leaf, unsigned slot)
+		: _map(owner), _leaf(leaf), _slot(slot), _value() {
+		_map->_settle(_leaf, _slot, _value);
+	}
+
+	disk_map_iterator(const disk_map_iterator& x)
+		: _map(x._map), _leaf(x._leaf), _slot(x._slot), _value(x._value) {}
+
+	~disk_map_iterator(void) {}
+
+	disk_map_iterator& operator=(const disk_map_iterator& x) {
+		_map = x._map;
+		_leaf = x._leaf;
+		_slot = x._slot;
+		_value.~value_type();
+		new (&_value) value_type(x._value);
+		return (*this);
+	}
+
+	reference operator*(void) const {
+		return (_value);
+	}
+
+	pointer operator->(void) const {
+		return (&_value);
+	}
+
+	disk_map_iterator& operator++(void) {
+		_slot++;
+		_map->_settle(_leaf, _slot, _value);
+		return (*this);
+	}
+
+	disk_map_iterator operator++(int) {
+		disk_map_iterator tmp(*this);
+		++*this;
+		return (tmp);
+	}
+
+	disk_map_iterator& operator--(void) {
+		_map->_back(_leaf, _slot, _value);
+		return (*this);
+	}
+
+	disk_map_iterator operator--(int) {
+		disk_map_iterator tmp(*this);
+		--*this;
+		return (tmp);
+	}
+
+	bool operator==(const disk_map_iterator& x) const {
+		return (_leaf == x._leaf && _slot == x._slot);
+	}
+
+	bool operator!=(const disk_map_iterator& x) const {
+		return (!(*this == x));
+	}
+};
+
+// Sits on the element it yields, so dereferencing needs no temporary.
+template <typename Iter>
+class disk_map_reverse_iterator
+	: public iterator<std::bidirectional_iterator_tag, typename Iter::value_type> {
+ public:
+	typedef std::bidirectional_iterator_tag				iterator_category;
+	typedef typename Iter::value_type					value_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef typename Iter::pointer						pointer;
+	typedef typename Iter::reference					reference;
+
+ private:
+	Iter												_it;
+
+ public:
+	disk_map_reverse_iterator(void) : _it() {}
+
+	// it is one past the element to yield, as with std::reverse_iterator.
+	explicit disk_map_reverse_iterator(Iter it) : _it(it) {
+		--_it;
+	}
+
+	Iter base(void) const {
+		Iter tmp(_it);
+		return (++tmp);
+	}
+
+	reference operator*(void) const {
+		return (*_it);
+	}
+
+	pointer operator->(void) const {
+		return (&*_it);
+	}
+
+	disk_map_reverse_iterator& operator++(void) {
+		--_it;
+		return (*this);
+	}
+
+	disk_map_reverse_iterator operator++(int) {
+		disk_map_reverse_iterator tmp(*this);
+		--_it;
+		return (tmp);
+	}
+
+	disk_map_reverse_iterator& operator--(void) {
+		++_it;
+		return (*this);
+	}
+
+	disk_map_reverse_iterator operator--(int) {
+		disk_map_reverse_iterator tmp(*this);
+		++_it;
+		return (tmp);
+	}
+
+	bool operator==(const disk_map_reverse_iterator& x) const {
+		return (_it == x._it);
+	}
+
+	bool operator!=(const disk_map_reverse_iterator& x) const {
+		return (_it != x._it);
+	}
+};
+
+/*****************************************************************************\
+* 							DISK MAP			 							   *
+\*****************************************************************************/
+
+/*
+		An ordered map kept in a B+tree file, for indexes larger than
+		memory. Keys and mapped values are stored as raw bytes, so both must
+		be trivially copyable. Leaves hold the elements and are chained both
+		ways; inner pages hold separators. Only the pages in the cache are
+		in memory.
+
+		Iterators hold a copy of their element and are read-only; change a
+		value through insert_or_assign() or operator[]. Any change to the
+		map invalidates its iterators. Erasing never merges pages: a leaf
+		that empties stays in the chain and is skipped.
+
+		flush() writes the dirty pages and the header, and sync() also
+		forces them to the disk; the destructor flushes. A crash between two
+		flushes can leave the file torn.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, std::allocator<ft::pair<const Key, T> > >
+template <class Key, class T, class Compare = std::less<Key> >
+class disk_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef typename ft::enable_if<Key, ft::is_trivially_copyable<Key>::value>::type
+														key_type;
+	typedef typename ft::enable_if<T, ft::is_trivially_copyable<T>::value>::type
+														mapped_type;
+	typedef Compare										key_compare;
+	typedef disk_map_iterator<disk_map>					iterator;
+	typedef iterator									const_iterator;
+	typedef disk_map_reverse_iterator<iterator>			reverse_iterator;
+	typedef reverse_iterator							const_reverse_iterator;
+
+	friend class disk_map_iterator<disk_map>;
+
+ /*****************************************************************************\
+ * 							MEMBER CLASS			 						   *
+ \*****************************************************************************/
+	class value_compare : public std::binary_function<value_type, value_type, bool> {
+	 protected:
+		key_compare comp;
+
+	 public:
+		explicit value_compare(key_compare c = key_compare()) : comp(c) {}
+
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(x.first, y.first));
+		}
+	};
+
+	// What operator[] returns: reads through to the map and assigns
+	// with insert_or_assign().
+	class mapped_reference {
+		disk_map*										_map;
+		key_type										_key;
+
+	 public:
+		mapped_reference(disk_map* owner, const key_type& key) : _map(owner), _key(key) {}
+
+		operator mapped_type(void) const {
+			return (_map->at(_key));
+		}
+
+		mapped_reference& operator=(const mapped_type& x) {
+			_map->insert_or_assign(_key, x);
+			return (*this);
+		}
+
+		mapped_reference& operator=(const mapped_reference& x) {
+			return (*this = static_cast<mapped_type>(x));
+		}
+	};
+
+ private:
+	enum {
+		VERSION = 1,
+		PAGE = disk_page_cache::PAGE_SIZE,
+		LEAF = 1,
+		INNER = 2,
+		HEADER = sizeof(disk_page_header),
+		MAX_HEIGHT = 32,
+		LEAF_CAP = (PAGE - HEADER - 16) / (sizeof(Key) + sizeof(T)),
+		INNER_CAP = (PAGE - HEADER - 20) / (sizeof(Key) + sizeof(unsigned)),
+		LEAF_VALUES = HEADER + ((LEAF_CAP * sizeof(Key) + 15) & ~15),
+		INNER_KEYS = HEADER + (((INNER_CAP + 1) * sizeof(unsigned) + 15) & ~15)
+	};
+
+	int													_fd;
+	mutable disk_page_cache*							_cache;
+	disk_map_meta										_meta;
+	key_compare											_comp;
+
+	disk_map(const disk_map&);
+	disk_map& operator=(const disk_map&);
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	// Opens the map stored at path, or starts an empty one there; at most
+	// cache_pages pages of PAGE_SIZE bytes are kept in memory.
+	explicit disk_map(const char* path, unsigned cache_pages = 1024,
+					const key_compare& comp = key_compare())
+		: _fd(-1), _cache(NULL), _meta(), _comp(comp) {
+		if (LEAF_CAP < 4 || INNER_CAP < 4)
+			throw std::length_error("disk_map: elements too large for a page");
+		_fd = open(path, O_RDWR | O_CREAT, 0644);
+		if (_fd < 0)
+			throw std::runtime_error("disk_map: cannot open file");
+		struct stat st;
+		if (fstat(_fd, &st) != 0) {
+			close(_fd);
+			throw std::runtime_error("disk_map: cannot open file");
+		}
+		_cache = new disk_page_cache(_fd, cache_pages);
+		if (st.st_size == 0) {
+			_format();
+			return;
+		}
+		disk_map_meta m;
+		if (pread(_fd, &m, sizeof(m), 0) != static_cast<ssize_t>(sizeof(m)) || std::memcmp(m.magic, "ftbt", 4) != 0
+			|| m.version != VERSION || m.page_size != PAGE || m.key_size != sizeof(Key)
+			|| m.mapped_size != sizeof(T)) {
+			delete _cache;
+			close(_fd);
+			throw std::runtime_error("disk_map: not a disk_map file of this type");
+		}
+		_meta = m;
+	};
+
+	~disk_map(void) {
+		try {
+			flush();
+		} catch (...) {
+		}
+		delete _cache;
+		close(_fd);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type at(const key_type& k) const {
+		const_iterator it = find(k);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	// Inserts a default value for a missing key, as ft::map does.
+	mapped_reference operator[](const key_type& k) {
+		insert(value_type(k, mapped_type()));
+		return (mapped_reference(this, k));
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) const {
+		return (iterator(this, _meta.first_leaf, 0));
+	};
+
+	iterator end(void) const {
+		return (iterator(this, 0, 0));
+	};
+
+	reverse_iterator rbegin(void) const {
+		return (reverse_iterator(end()));
+	};
+
+	reverse_iterator rend(void) const {
+		return (reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_meta.size == 0);
+	};
+
+	size_type size(void) const {
+		return (static_cast<size_type>(_meta.size));
+	};
+
+	size_type max_size(void) const {
+		return (static_cast<size_type>(~0u) * LEAF_CAP);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		return (_insert(val.first, val.second, false));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		(void)position;
+		return (insert(val).first);
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			insert(*first);
+	};
+
+	ft::pair<iterator, bool> insert_or_assign(const key_type& k, const mapped_type& obj) {
+		return (_insert(k, obj, true));
+	};
+
+	void erase(iterator position) {
+		erase(position->first);
+	};
+
+	size_type erase(const key_type& k) {
+		unsigned leaf = _descend(k, NULL, NULL);
+		disk_page p(*_cache, leaf);
+		char* d = p.data();
+		unsigned n = _head(d).count;
+		unsigned i = _lower(_keys(d), n, k);
+		if (i == n || _comp(k, _keys(d)[i]))
+			return (0);
+		std::memmove(_keys(d) + i, _keys(d) + i + 1, (n - i - 1) * sizeof(Key));
+		std::memmove(_values(d) + i, _values(d) + i + 1, (n - i - 1) * sizeof(T));
+		_head(d).count--;
+		p.touch();
+		_meta.size--;
+		return (1);
+	};
+
+	void erase(iterator first, iterator last) {
+		if (first == last)
+			return;
+		bool to_end = (last == end());
+		key_type stop = (to_end ? key_type() : last->first);
+		key_type k = first->first;
+		for (;;) {
+			iterator it = lower_bound(k);
+			if (it == end() || (!to_end && !_comp(it->first, stop)))
+				break;
+			k = it->first;
+			erase(k);
+		}
+	};
+
+	void swap(disk_map& x) {
+		std::swap(_fd, x._fd);
+		std::swap(_cache, x._cache);
+		std::swap(_meta, x._meta);
+		std::swap(_comp, x._comp);
+	};
+
+	// Empties the map and truncates its file.
+	void clear(void) {
+		_cache->drop();
+		if (ftruncate(_fd, 0) != 0)
+			throw std::runtime_error("disk_map: cannot truncate file");
+		_format();
+	};
+
+	// Writes every dirty page and the header.
+	void flush(void) {
+		disk_page p(*_cache, 0, true);
+		std::memcpy(p.data(), &_meta, sizeof(_meta));
+		_cache->flush();
+	};
+
+	void sync(void) {
+		flush();
+		if (fdatasync(_fd) != 0)
+			throw std::runtime_error("disk_map: sync failed");
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) const {
+		iterator it = lower_bound(k);
+		if (it != end() && _comp(k, it->first))
+			return (end());
+		return (it);
+	};
+
+	size_type count(const key_type& k) const {
+		return (find(k) != end());
+	};
+
+	iterator lower_bound(const key_type& k) const {
+		unsigned leaf = _descend(k, NULL, NULL);
+		disk_page p(*_cache, leaf);
+		return (iterator(this, leaf, _lower(_keys(p.data()), _head(p.data()).count, k)));
+	};
+
+	iterator upper_bound(const key_type& k) const {
+		unsigned leaf = _descend(k, NULL, NULL);
+		disk_page p(*_cache, leaf);
+		return (iterator(this, leaf, _upper(_keys(p.data()), _head(p.data()).count, k)));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	// Copies the elements with keys in [lo, hi) to out, in order.
+	template <class OutputIterator>
+	OutputIterator range_scan(const key_type& lo, const key_type& hi, OutputIterator out) const {
+		if (!_comp(lo, hi))
+			return (out);
+		for (iterator it = lower_bound(lo); it != end() && _comp(it->first, hi); ++it) {
+			*out = *it;
+			++out;
+		}
+		return (out);
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+	value_compare value_comp(void) const {
+		return (value_compare(_comp));
+	};
+
+	const disk_page_cache& cache(void) const {
+		return (*_cache);
+	};
+
+	unsigned height(void) const {
+		return (_meta.height);
+	};
+
+	unsigned pages(void) const {
+		return (_meta.pages);
+	};
+
+ private:
+	static disk_page_header& _head(char* d) {
+		return (*reinterpret_cast<disk_page_header*>(d));
+	};
+
+	static Key* _keys(char* d) {
+		return (reinterpret_cast<Key*>(d + HEADER));
+	};
+
+	static T* _values(char* d) {
+		return (reinterpret_cast<T*>(d + LEAF_VALUES));
+	};
+
+	static unsigned* _children(char* d) {
+		return (reinterpret_cast<unsigned*>(d + HEADER));
+	};
+
+	static Key* _separators(char* d) {
+		return (reinterpret_cast<Key*>(d + INNER_KEYS));
+	};
+
+	unsigned _lower(const Key* keys, unsigned n, const key_type& k) const {
+		unsigned lo = 0;
+		while (n > 0) {
+			unsigned half = n / 2;
+			if (_comp(keys[lo + half], k)) {
+				lo += half + 1;
+				n -= half + 1;
+			} else {
+				n = half;
+			}
+		}
+		return (lo);
+	};
+
+	unsigned _upper(const Key* keys, unsigned n, const key_type& k) const {
+		unsigned lo = 0;
+		while (n > 0) {
+			unsigned half = n / 2;
+			if (!_comp(k, keys[lo + half])) {
+				lo += half + 1;
+				n -= half + 1;
+			} else {
+				n = half;
+			}
+		}
+		return (lo);
+	};
+
+	void _format(void) {
+		std::memset(&_meta, 0, sizeof(_meta));
+		std::memcpy(_meta.magic, "ftbt", 4);
+		_meta.version = VERSION;
+		_meta.page_size = PAGE;
+		_meta.key_size = sizeof(Key);
+		_meta.mapped_size = sizeof(T);
+		_meta.root = 1;
+		_meta.pages = 2;
+		_meta.first_leaf = 1;
+		_meta.last_leaf = 1;
+		_meta.height = 1;
+		disk_page p(*_cache, 1, true);
+		_head(p.data()).kind = LEAF;
+		flush();
+	};
+
+	unsigned _new_page(void) {
+		if (_meta.pages == ~0u)
+			throw std::length_error("disk_map: file full");
+		return (_meta.pages++);
+	};
+
+	// Follows the separators down to the leaf that holds, or would hold,
+	// k. path and slot, when given, receive each inner page passed and the
+	// child taken there.
+	unsigned _descend(const key_type& k, unsigned* path, unsigned* slot) const {
+		unsigned page = _meta.root;
+		for (unsigned level = 0; level + 1 < _meta.height; level++) {
+			disk_page p(*_cache, page);
+			char* d = p.data();
+			unsigned i = _upper(_separators(d), _head(d).count, k);
+			if (path) {
+				path[level] = page;
+				slot[level] = i;
+			}
+			page = _children(d)[i];
+		}
+		return (page);
+	};
+
+	// Moves (leaf, slot) forward to the next element if it is past the end
+	// of its leaf, and loads it into value.
+	void _settle(unsigned& leaf, unsigned& slot, value_type& value) const {
+		while (leaf != 0) {
+			disk_page p(*_cache, leaf);
+			char* d = p.data();
+			if (slot < _head(d).count) {
+				_load(d, slot, value);
+				if (_head(d).next)
+					_cache->advise(_head(d).next);
+				return;
+			}
+			leaf = _head(d).next;
+			slot = 0;
+		}
+		slot = 0;
+	};
+
+	void _back(unsigned& leaf, unsigned& slot, value_type& value) const {
+		if (leaf == 0) {
+			leaf = _meta.last_leaf;
+			disk_page p(*_cache, leaf);
+			slot = _head(p.data()).count;
+		}
+		while (leaf != 0) {
+			disk_page p(*_cache, leaf);
+			char* d = p.data();
+			if (slot > 0) {
+				_load(d, --slot, value);
+				return;
+			}
+			leaf = _head(d).prev;
+			if (leaf != 0) {
+				disk_page q(*_cache, leaf);
+				slot = _head(q.data()).count;
+			}
+		}
+		slot = 0;
+	};
+
+	static void _load(char* d, unsigned slot, value_type& value) {
+		value.~value_type();
+		new (&value) value_type(_keys(d)[slot], _values(d)[slot]);
+	};
+
+	ft::pair<iterator, bool> _insert(const key_type& k, const mapped_type& v, bool assign) {
+		unsigned path[MAX_HEIGHT];
+		unsigned slot[MAX_HEIGHT];
+		unsigned leaf = _descend(k, path, slot);
+		disk_page p(*_cache, leaf);
+		char* d = p.data();
+		unsigned n = _head(d).count;
+		unsigned i = _lower(_keys(d), n, k);
+		if (i < n && !_comp(k, _keys(d)[i])) {
+			if (assign) {
+				_values(d)[i] = v;
+				p.touch();
+			}
+			return (ft::make_pair(iterator(this, leaf, i), false));
+		}
+		p.touch();
+		_meta.size++;
+		if (n < LEAF_CAP) {
+			_leaf_insert(d, i, k, v);
+			return (ft::make_pair(iterator(this, leaf, i), true));
+		}
+		unsigned right = _new_page();
+		disk_page q(*_cache, right, true);
+		char* e = q.data();
+		// Appending to the last leaf leaves it full, so ascending loads
+		// pack their pages.
+		unsigned mid = (i == n && _head(d).next == 0 ? n : n / 2);
+		std::memcpy(_keys(e), _keys(d) + mid, (n - mid) * sizeof(Key));
+		std::memcpy(_values(e), _values(d) + mid, (n - mid) * sizeof(T));
+		_head(e).kind = LEAF;
+		_head(e).count = n - mid;
+		_head(e).next = _head(d).next;
+		_head(e).prev = leaf;
+		if (_head(d).next) {
+			disk_page r(*_cache, _head(d).next);
+			_head(r.data()).prev = right;
+			r.touch();
+		} else {
+			_meta.last_leaf = right;
+		}
+		_head(d).next = right;
+		_head(d).count = mid;
+		unsigned at = leaf;
+		if (i <= mid && mid < n) {
+			_leaf_insert(d, i, k, v);
+		} else {
+			_leaf_insert(e, i - mid, k, v);
+			at = right;
+			i -= mid;
+		}
+		_split_parent(path, slot, _keys(e)[0], right);
+		return (ft::make_pair(iterator(this, at, i), true));
+	};
+
+	static void _leaf_insert(char* d, unsigned i, const key_type& k, const mapped_type& v) {
+		unsigned n = _head(d).count;
+		std::memmove(_keys(d) + i + 1, _keys(d) + i, (n - i) * sizeof(Key));
+		std::memmove(_values(d) + i + 1, _values(d) + i, (n - i) * sizeof(T));
+		_keys(d)[i] = k;
+		_values(d)[i] = v;
+		_head(d).count = n + 1;
+	};
+
+	// Hangs child, whose keys start at key, right of the child that was
+	// split, splitting inner pages upwards as they fill.
+	void _split_parent(unsigned* path, unsigned* slot, key_type key, unsigned child) {
+		for (int level = static_cast<int>(_meta.height) - 2; level >= 0; level--) {
+			disk_page p(*_cache, path[level]);
+			char* d = p.data();
+			p.touch();
+			unsigned n = _head(d).count;
+			unsigned i = slot[level];
+			Key* keys = _separators(d);
+			unsigned* children = _children(d);
+			if (n < INNER_CAP) {
+				std::memmove(keys + i + 1, keys + i, (n - i) * sizeof(Key));
+				std::memmove(children + i + 2, children + i + 1, (n - i) * sizeof(unsigned));
+				keys[i] = key;
+				children[i + 1] = child;
+				_head(d).count = n + 1;
+				return;
+			}
+			Key all_keys[INNER_CAP + 1];
+			unsigned all_children[INNER_CAP + 2];
+			std::memcpy(all_keys, keys, i * sizeof(Key));
+			all_keys[i] = key;
+			std::memcpy(all_keys + i + 1, keys + i, (n - i) * sizeof(Key));
+			std::memcpy(all_children, children, (i + 1) * sizeof(unsigned));
+			all_children[i + 1] = child;
+			std::memcpy(all_children + i + 2, children + i + 1, (n - i) * sizeof(unsigned));
+			unsigned mid = (n + 1) / 2;
+			unsigned right = _new_page();
+			disk_page q(*_cache, right, true);
+			char* e = q.data();
+			_head(e).kind = INNER;
+			_head(e).count = n - mid;
+			std::memcpy(_separators(e), all_keys + mid + 1, (n - mid) * sizeof(Key));
+			std::memcpy(_children(e), all_children + mid + 1, (n - mid + 1) * sizeof(unsigned));
+			_head(d).count = mid;
+			std::memcpy(keys, all_keys, mid * sizeof(Key));
+			std::memcpy(children, all_children, (mid + 1) * sizeof(unsigned));
+			key = all_keys[mid];
+			child = right;
+		}
+		if (_meta.height == MAX_HEIGHT)
+			throw std::length_error("disk_map: tree too deep");
+		unsigned root = _new_page();
+		disk_page r(*_cache, root, true);
+		char* d = r.data();
+		_head(d).kind = INNER;
+		_head(d).count = 1;
+		_separators(d)[0] = key;
+		_children(d)[0] = _meta.root;
+		_children(d)[1] = child;
+		_meta.root = root;
+		_meta.height++;
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare>
+bool operator==(const disk_map<Key, T, Compare>& lhs, const disk_map<Key, T, Compare>& rhs) {
+	if (lhs.size() != rhs.size())
+		return (false);
+	typename disk_map<Key, T, Compare>::const_iterator i = lhs.begin();
+	typename disk_map<Key, T, Compare>::const_iterator j = rhs.begin();
+	for (; i != lhs.end(); ++i, ++j)
+		if (!(i->first == j->first && i->second == j->second))
+			return (false);
+	return (true);
+}
+
+template <class Key, class T, class Compare>
+bool operator!=(const disk_map<Key, T, Compare>& lhs, const disk_map<Key, T, Compare>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class T, class Compare>
+void swap(disk_map<Key, T, Compare>& lhs, disk_map<Key, T, Compare>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
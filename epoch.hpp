@@ -0,0 +1,215 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <cassert>
+#include <cstddef>
+
+#include "./thread.hpp"
+
+namespace ft {
+
+/*
+		Epoch-based reclamation. Readers pin the global epoch while they hold
+		pointers into a shared structure; writers retire unlinked memory into
+		the limbo list of the current epoch. The epoch only advances once
+		every pinned reader has seen it, so a list is freed two epochs after
+		it was filled, when no reader can still reach its entries.
+*/
+class epoch_domain {
+ public:
+	typedef void (*deleter_type)(void* context, void* ptr);
+
+ private:
+	enum { LIMBO_LISTS = 3, ADVANCE_EVERY = 64 };
+
+	struct record {
+		const void*				owner;
+		unsigned long			epoch;
+		int						active;
+		int						nesting;
+		record*					next;
+	};
+
+	struct retired {
+		void*					ptr;
+		deleter_type			deleter;
+		void*					context;
+		retired*				next;
+	};
+
+	struct cache {
+		unsigned long			domain;
+		record*					rec;
+	};
+
+	unsigned long				_epoch;
+	record*						_records;
+	retired*					_limbo[LIMBO_LISTS];
+	std::size_t					_pending;
+	spin_lock					_lock;
+	unsigned long				_id;
+
+	epoch_domain(const epoch_domain&);
+	epoch_domain& operator=(const epoch_domain&);
+
+	static unsigned long next_id(void) {
+		static unsigned long counter = 0;
+		return (__sync_add_and_fetch(&counter, 1));
+	}
+
+	record* local(void) {
+		static __thread cache last = { 0, NULL };
+		if (last.domain == _id)
+			return (last.rec);
+		const void* self = thread_id();
+		record* r = __atomic_load_n(&_records, __ATOMIC_ACQUIRE);
+		for (; r != NULL; r = r->next) {
+			if (r->owner == self)
+				break;
+		}
+		if (r == NULL) {
+			r = new record();
+			r->owner = self;
+			r->epoch = 0;
+			r->active = 0;
+			r->nesting = 0;
+			r->next = __atomic_load_n(&_records, __ATOMIC_RELAXED);
+			while (!__atomic_compare_exchange_n(&_records, &r->next, r, false,
+						__ATOMIC_RELEASE, __ATOMIC_RELAXED))
+				;
+		}
+		last.domain = _id;
+		last.rec = r;
+		return (r);
+	}
+
+	static void free_list(retired* x) {
+		while (x != NULL) {
+			retired* next = x->next;
+			x->deleter(x->context, x->ptr);
+			delete x;
+			x = next;
+		}
+	}
+
+	// Called with _lock held.
+	bool try_advance(void) {
+		unsigned long e = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+		for (record* r = __atomic_load_n(&_records, __ATOMIC_ACQUIRE); r != NULL; r = r->next) {
+			if (__atomic_load_n(&r->active, __ATOMIC_SEQ_CST)
+				&& __atomic_load_n(&r->epoch, __ATOMIC_SEQ_CST) != e)
+				return (false);
+		}
+		__atomic_store_n(&_epoch, e + 1, __ATOMIC_SEQ_CST);
+		retired* stale = _limbo[(e + 1) % LIMBO_LISTS];
+		_limbo[(e + 1) % LIMBO_LISTS] = NULL;
+		free_list(stale);
+		_pending = 0;
+		for (int i = 0; i < LIMBO_LISTS; i++) {
+			for (retired* x = _limbo[i]; x != NULL; x = x->next)
+				_pending++;
+		}
+		return (true);
+	}
+
+ public:
+	// The address of a thread-local object identifies the calling thread.
+	static const void* thread_id(void) {
+		static __thread char marker;
+		return (&marker);
+	}
+
+	epoch_domain(void) : _epoch(0), _records(NULL), _pending(0), _id(next_id()) {
+		for (int i = 0; i < LIMBO_LISTS; i++)
+			_limbo[i] = NULL;
+	}
+
+	// No thread may be inside a guard of this domain any more.
+	~epoch_domain(void) {
+		for (int i = 0; i < LIMBO_LISTS; i++)
+			free_list(_limbo[i]);
+		record* r = _records;
+		while (r != NULL) {
+			record* next = r->next;
+			delete r;
+			r = next;
+		}
+	}
+
+	void enter(void) {
+		record* r = local();
+		if (r->nesting++ != 0)
+			return;
+		__atomic_store_n(&r->epoch, __atomic_load_n(&_epoch, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+		__atomic_exchange_n(&r->active, 1, __ATOMIC_SEQ_CST);
+	}
+
+	void exit(void) {
+		record* r = local();
+		if (--r->nesting == 0)
+			__atomic_store_n(&r->active, 0, __ATOMIC_RELEASE);
+	}
+
+	void retire(void* ptr, deleter_type deleter, void* context) {
+		retired* x = new retired();
+		x->ptr = ptr;
+		x->deleter = deleter;
+		x->context = context;
+		scoped_lock<spin_lock> guard(_lock);
+		unsigned long e = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+		x->next = _limbo[e % LIMBO_LISTS];
+		_limbo[e % LIMBO_LISTS] = x;
+		if (++_pending >= ADVANCE_EVERY)
+			try_advance();
+	}
+
+	// Frees everything retired so far; blocks while readers are pinned.
+	void synchronize(void) {
+		for (int i = 0; i < LIMBO_LISTS; i++) {
+			while (true) {
+				{
+					scoped_lock<spin_lock> guard(_lock);
+					if (try_advance())
+						break;
+				}
+				sched_yield();
+			}
+		}
+	}
+};
+
+// Pins the epoch for the thread that made it, which must also be the one
+// to reassign or destroy it: enter and exit count on that thread's record.
+// A copy made on another thread pins for that thread instead.
+class epoch_guard {
+ private:
+	epoch_domain*				_domain;
+	const void*					_thread;
+
+ public:
+	explicit epoch_guard(epoch_domain& domain)
+		: _domain(&domain), _thread(epoch_domain::thread_id()) {
+		_domain->enter();
+	}
+
+	epoch_guard(const epoch_guard& x) : _domain(x._domain), _thread(epoch_domain::thread_id()) {
+		_domain->enter();
+	}
+
+	epoch_guard& operator=(const epoch_guard& x) {
+		assert(_thread == epoch_domain::thread_id());
+		x._domain->enter();
+		_domain->exit();
+		_domain = x._domain;
+		return (*this);
+	}
+
+	~epoch_guard(void) {
+		assert(_thread == epoch_domain::thread_id());
+		_domain->exit();
+	}
+};
+
+}
+
+#endif
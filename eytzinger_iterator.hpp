@@ -0,0 +1,142 @@
+#ifndef EYTZINGER_ITERATOR_H
+#define EYTZINGER_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+#include "./iterator_traits.hpp"
+
+namespace ft {
+
+/*
+		In-order navigation over an implicit 1-indexed tree (BFS layout):
+		the children of i are 2i and 2i + 1, index 0 stands for end().
+*/
+struct eytzinger {
+	static std::size_t first(std::size_t n) {
+		std::size_t i = (n == 0 ? 0 : 1);
+		while (i != 0 && 2 * i <= n)
+			i = 2 * i;
+		return (i);
+	}
+
+	static std::size_t last(std::size_t n) {
+		std::size_t i = (n == 0 ? 0 : 1);
+		while (i != 0 && 2 * i + 1 <= n)
+			i = 2 * i + 1;
+		return (i);
+	}
+
+	static std::size_t next(std::size_t i, std::size_t n) {
+		if (i == 0)
+			return (0);
+		if (2 * i + 1 <= n) {
+			i = 2 * i + 1;
+			while (2 * i <= n)
+				i = 2 * i;
+			return (i);
+		}
+		while (i & 1)
+			i >>= 1;
+		return (i >> 1);
+	}
+
+	static std::size_t prev(std::size_t i, std::size_t n) {
+		if (i == 0)
+			return (last(n));
+		if (2 * i <= n) {
+			i = 2 * i;
+			while (2 * i + 1 <= n)
+				i = 2 * i + 1;
+			return (i);
+		}
+		while (i != 0 && !(i & 1))
+			i >>= 1;
+		return (i >> 1);
+	}
+};
+
+template <typename T>
+class eytzinger_iterator : public iterator<std::bidirectional_iterator_tag, T> {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef T									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef T*									pointer;
+	typedef T&									reference;
+
+ protected:
+	pointer										values;
+	std::size_t									size;
+	std::size_t									index;
+
+ public:
+	eytzinger_iterator(void) : values(NULL), size(0), index(0) {}
+
+	eytzinger_iterator(pointer _values, std::size_t _size, std::size_t _index)
+		: values(_values), size(_size), index(_index) {}
+
+	template <typename U>
+	eytzinger_iterator(const eytzinger_iterator<U>& i)
+		: values(i.data()), size(i.count()), index(i.base()) {}
+
+	~eytzinger_iterator(void) {}
+
+	std::size_t base(void) const {
+		return (index);
+	}
+
+	pointer data(void) const {
+		return (values);
+	}
+
+	std::size_t count(void) const {
+		return (size);
+	}
+
+	reference operator*(void) const {
+		return (values[index]);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	eytzinger_iterator& operator++(void) {
+		index = eytzinger::next(index, size);
+		return (*this);
+	}
+
+	eytzinger_iterator operator++(int) {
+		eytzinger_iterator tmp(*this);
+		index = eytzinger::next(index, size);
+		return (tmp);
+	}
+
+	eytzinger_iterator& operator--(void) {
+		index = eytzinger::prev(index, size);
+		return (*this);
+	}
+
+	eytzinger_iterator operator--(int) {
+		eytzinger_iterator tmp(*this);
+		index = eytzinger::prev(index, size);
+		return (tmp);
+	}
+};
+
+template <typename IteratorL, typename IteratorR>
+inline bool operator==(const eytzinger_iterator<IteratorL>& lhs,
+						const eytzinger_iterator<IteratorR>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename IteratorL, typename IteratorR>
+inline bool operator!=(const eytzinger_iterator<IteratorL>& lhs,
+						const eytzinger_iterator<IteratorR>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef FILTERED_MAP_H
+#define FILTERED_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./bloom_filter.hpp"
+#include "./hash.hpp"
+#include "./map.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*
+		An ft::map with a counting Bloom filter kept beside it. A key the
+		filter has never seen is answered by find(), count(), at() and
+		erase() from one cache line, without walking the tree; only the
+		filter's false positives and real hits pay for the descent. The
+		filter is rebuilt twice as large whenever the map outgrows it.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>,
+		class Alloc = std::allocator<ft::pair<const Key, T> >, class Hash = ft::hash<Key> >
+class filtered_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Hash										hasher;
+	typedef Alloc										allocator_type;
+	typedef ft::map<Key, T, Compare, Alloc>				map_type;
+	typedef ft::counting_bloom_filter<Key, Hash, Alloc>	filter_type;
+	typedef typename map_type::value_compare			value_compare;
+	typedef typename map_type::iterator					iterator;
+	typedef typename map_type::const_iterator			const_iterator;
+	typedef typename map_type::reverse_iterator			reverse_iterator;
+	typedef typename map_type::const_reverse_iterator	const_reverse_iterator;
+
+ private:
+	map_type											_map;
+	filter_type											_filter;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit filtered_map(const key_compare& comp = key_compare(),
+				const hasher& hash = hasher(),
+				const allocator_type& alloc = allocator_type())
+		: _map(comp, alloc), _filter(0, hash, alloc)
+		{};
+
+	template <class InputIterator>
+	filtered_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const hasher& hash = hasher(),
+		const allocator_type& alloc = allocator_type())
+		: _map(first, last, comp, alloc), _filter(0, hash, alloc) {
+		_rebuild(_map.size());
+	};
+
+	filtered_map(const filtered_map& x) : _map(x._map), _filter(x._filter) {};
+
+	~filtered_map(void) {};
+
+	filtered_map& operator=(const filtered_map& x) {
+		if (this != &x) {
+			_map = x._map;
+			_filter = x._filter;
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type& at(const Key& key) {
+		iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	const mapped_type& at(const Key& key) const {
+		const_iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	mapped_type& operator[](const key_type& k) {
+		return (insert(ft::make_pair(k, mapped_type())).first->second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (_map.begin());
+	};
+
+	const_iterator begin(void) const {
+		return (_map.begin());
+	};
+
+	iterator end(void) {
+		return (_map.end());
+	};
+
+	const_iterator end(void) const {
+		return (_map.end());
+	};
+
+	reverse_iterator rbegin(void) {
+		return (_map.rbegin());
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (_map.rbegin());
+	};
+
+	reverse_iterator rend(void) {
+		return (_map.rend());
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (_map.rend());
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_map.empty());
+	};
+
+	size_type size(void) const {
+		return (_map.size());
+	};
+
+	size_type max_size(void) const {
+		return (_map.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		ft::pair<iterator, bool> res = _map.insert(val);
+		if (res.second)
+			_added(val.first);
+		return (res);
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		(void)position;
+		return (insert(val).first);
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			insert(*first);
+	};
+
+	void erase(iterator position) {
+		_filter.erase(position->first);
+		_map.erase(position);
+	};
+
+	size_type erase(const key_type& k) {
+		if (!_filter.may_contain(k))
+			return (0);
+		iterator it = _map.find(k);
+		if (it == end())
+			return (0);
+		erase(it);
+		return (1);
+	};
+
+	void erase(iterator first, iterator last) {
+		while (first != last)
+			erase(first++);
+	};
+
+	void swap(filtered_map& x) {
+		_map.swap(x._map);
+		_filter.swap(x._filter);
+	};
+
+	void clear(void) {
+		_map.clear();
+		_filter.reset(0);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) {
+		return (_filter.may_contain(k) ? _map.find(k) : end());
+	};
+
+	const_iterator find(const key_type& k) const {
+		return (_filter.may_contain(k) ? _map.find(k) : end());
+	};
+
+	size_type count(const key_type& k) const {
+		return (_filter.may_contain(k) && _map.count(k));
+	};
+
+	iterator lower_bound(const key_type& k) {
+		return (_map.lower_bound(k));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (_map.lower_bound(k));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		return (_map.upper_bound(k));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		return (_map.upper_bound(k));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		return (_map.equal_range(k));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (_map.equal_range(k));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	key_compare key_comp(void) const {
+		return (_map.key_comp());
+	};
+
+	value_compare value_comp(void) const {
+		return (_map.value_comp());
+	};
+
+	allocator_type get_allocator(void) const {
+		return (_map.get_allocator());
+	};
+
+	const filter_type& filter(void) const {
+		return (_filter);
+	};
+
+	// Expected share of absent keys that still reach the tree.
+	double false_positive_rate(void) const {
+		return (_filter.false_positive_rate());
+	};
+
+	size_type filter_bytes(void) const {
+		return (_filter.memory());
+	};
+
+ private:
+	void _added(const key_type& k) {
+		if (_map.size() > _filter.capacity())
+			_rebuild(_map.size() * 2);
+		else
+			_filter.insert(k);
+	};
+
+	void _rebuild(size_type capacity) {
+		_filter.reset(capacity);
+		for (const_iterator it = _map.begin(); it != _map.end(); ++it)
+			_filter.insert(it->first);
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare, class Alloc, class Hash>
+bool operator==(const filtered_map<Key, T, Compare, Alloc, Hash>& lhs,
+				const filtered_map<Key, T, Compare, Alloc, Hash>& rhs) {
+	return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class Key, class T, class Compare, class Alloc, class Hash>
+bool operator!=(const filtered_map<Key, T, Compare, Alloc, Hash>& lhs,
+				const filtered_map<Key, T, Compare, Alloc, Hash>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class T, class Compare, class Alloc, class Hash>
+void swap(filtered_map<Key, T, Compare, Alloc, Hash>& lhs, filtered_map<Key, T, Compare, Alloc, Hash>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "./flat_tree.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+/*
+		The elements live in a sorted array of the same pair<const Key, T>
+		that ft::map holds, so a key cannot be changed in place; flat_tree
+		shifts them by copy-construction rather than assignment.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class flat_map : public CONTAINER {
+	template <typename P>
+	struct FirstOfPair {
+		const Key& operator()(const P& x) const {
+			return (x.first);
+		}
+	};
+
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	typedef Key								key_type;
+	typedef T								mapped_type;
+	typedef Compare							key_compare;
+
+ /*****************************************************************************\
+ * 							MEMBER CLASS			 						   *
+ \*****************************************************************************/
+	class value_compare : public std::binary_function<value_type, value_type, bool> {
+		friend class flat_map<Key, T, Compare, Alloc>;
+
+	 protected:
+		Compare comp;
+
+		explicit value_compare(Compare c) : comp(c) {}
+
+	 public:
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(x.first, y.first));
+		}
+	};
+
+ private:
+	typedef flat_tree<key_type, value_type, FirstOfPair<value_type>, key_compare, Alloc>
+															Tree_struct;
+	Tree_struct												_tree;
+
+ public:
+	typedef Alloc											allocator_type;
+	typedef typename Tree_struct::iterator					iterator;
+	typedef typename Tree_struct::const_iterator			const_iterator;
+	typedef typename Tree_struct::reverse_iterator			reverse_iterator;
+	typedef typename Tree_struct::const_reverse_iterator	const_reverse_iterator;
+	typedef typename Tree_struct::size_type					size_type;
+	typedef typename Tree_struct::difference_type			difference_type;
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit flat_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()) : _tree(comp, alloc)
+				{};
+
+	template <class InputIterator>
+	flat_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type()) : _tree(first, last, comp, alloc)
+		{};
+
+	flat_map(const flat_map& x) : _tree(x._tree) {};
+
+	~flat_map(void) {};
+
+	flat_map& operator=(const flat_map& x) {
+		_tree = x._tree;
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type& at(const Key& key) {
+		iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	const mapped_type& at(const Key& key) const {
+		const_iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	mapped_type& operator[](const key_type& k) {
+		iterator x = lower_bound(k);
+		if (x == end() || key_comp()(k, x->first))
+			x = _tree.insert_unique(x, value_type(k, mapped_type()));
+		return (x->second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (_tree.begin());
+	};
+
+	const_iterator begin(void) const {
+		return (_tree.begin());
+	};
+
+	iterator end(void) {
+		return (_tree.end());
+	};
+
+	const_iterator end(void) const {
+		return (_tree.end());
+	};
+
+	reverse_iterator rbegin(void) {
+		return (_tree.rbegin());
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (_tree.rbegin());
+	};
+
+	reverse_iterator rend(void) {
+		return (_tree.rend());
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (_tree.rend());
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_tree.empty());
+	};
+
+	size_type size(void) const {
+		return (_tree.size());
+	};
+
+	size_type max_size(void) const {
+		return (_tree.max_size());
+	};
+
+	size_type capacity(void) const {
+		return (_tree.capacity());
+	};
+
+	void reserve(size_type n) {
+		_tree.reserve(n);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		return (_tree.insert_unique(val));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		return (_tree.insert_unique(position, val));
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		_tree.insert_unique(first, last);
+	};
+
+	void erase(iterator position) {
+		_tree.erase(position);
+	};
+
+	size_type erase(const key_type& k) {
+		return (_tree.erase(k));
+	};
+
+	void erase(iterator first, iterator last) {
+		_tree.erase(first, last);
+	};
+
+	void swap(flat_map& x) {
+		_tree.swap(x._tree);
+	};
+
+	void clear(void) {
+		_tree.clear();
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) {
+		return (_tree.find(k));
+	};
+
+	const_iterator find(const key_type& k) const {
+		return (_tree.find(k));
+	};
+
+	size_type count(const key_type& k) const {
+		return (find(k) != end());
+	};
+
+	iterator lower_bound(const key_type& k) {
+		return (_tree.lower_bound(k));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (_tree.lower_bound(k));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		return (_tree.upper_bound(k));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		return (_tree.upper_bound(k));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_tree.get_allocator());
+	};
+
+	key_compare key_comp(void) const {
+		return (_tree.key_comp());
+	};
+
+	value_compare value_comp(void) const {
+		return (value_compare(_tree.key_comp()));
+	};
+
+	template <typename K1, typename T1, typename C1, typename A1>
+	friend bool
+	operator==(const flat_map<K1, T1, C1, A1>&, const flat_map<K1, T1, C1, A1>&);
+
+	template <typename K1, typename T1, typename C1, typename A1>
+	friend bool
+	operator<(const flat_map<K1, T1, C1, A1>&, const flat_map<K1, T1, C1, A1>&);
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare, class Alloc>
+void swap(flat_map<Key, T, Compare, Alloc>& lhs, flat_map<Key, T, Compare, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (lhs._tree == rhs._tree);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (lhs._tree < rhs._tree);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (!(rhs < lhs));
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const flat_map<Key, T, Compare, Alloc>& lhs,
+				const flat_map<Key, T, Compare, Alloc>& rhs) {
+	return (!(lhs < rhs));
+}
+
+};
+#endif
@@ -0,0 +1,242 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include <functional>
+#include <memory>
+
+#include "./flat_tree.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+#define CONTAINER Container<Key, Alloc>
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+class flat_set : public CONTAINER {
+	template <typename V>
+	struct Identity {
+		const V& operator()(const V& x) const {
+			return (x);
+		}
+	};
+
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	typedef Key								key_type;
+	typedef Compare							key_compare;
+	typedef Compare							value_compare;
+
+ private:
+	typedef flat_tree<key_type, value_type, Identity<value_type>, key_compare, Alloc>
+															Tree_struct;
+	Tree_struct												_tree;
+
+ public:
+	typedef typename Tree_struct::allocator_type			allocator_type;
+	typedef typename Tree_struct::const_iterator			iterator;
+	typedef typename Tree_struct::const_iterator			const_iterator;
+	typedef typename Tree_struct::const_reverse_iterator	reverse_iterator;
+	typedef typename Tree_struct::const_reverse_iterator	const_reverse_iterator;
+	typedef typename Tree_struct::size_type					size_type;
+	typedef typename Tree_struct::difference_type			difference_type;
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit flat_set(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()) : _tree(comp, alloc)
+				{};
+
+	template <class InputIterator>
+	flat_set(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type()) : _tree(first, last, comp, alloc)
+		{};
+
+	flat_set(const flat_set& x) : _tree(x._tree) {};
+
+	~flat_set(void) {};
+
+	flat_set& operator=(const flat_set& x) {
+		_tree = x._tree;
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) const {
+		return (_tree.begin());
+	};
+
+	iterator end(void) const {
+		return (_tree.end());
+	};
+
+	reverse_iterator rbegin(void) const {
+		return (_tree.rbegin());
+	};
+
+	reverse_iterator rend(void) const {
+		return (_tree.rend());
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_tree.empty());
+	};
+
+	size_type size(void) const {
+		return (_tree.size());
+	};
+
+	size_type max_size(void) const {
+		return (_tree.max_size());
+	};
+
+	size_type capacity(void) const {
+		return (_tree.capacity());
+	};
+
+	void reserve(size_type n) {
+		_tree.reserve(n);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		ft::pair<typename Tree_struct::iterator, bool> res = _tree.insert_unique(val);
+		return (ft::make_pair(iterator(res.first), res.second));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		return (_tree.insert_unique(position, val));
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		_tree.insert_unique(first, last);
+	};
+
+	void erase(iterator position) {
+		_tree.erase(position);
+	};
+
+	size_type erase(const key_type& k) {
+		return (_tree.erase(k));
+	};
+
+	void erase(iterator first, iterator last) {
+		_tree.erase(first, last);
+	};
+
+	void swap(flat_set& x) {
+		_tree.swap(x._tree);
+	};
+
+	void clear(void) {
+		_tree.clear();
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) const {
+		return (_tree.find(k));
+	};
+
+	size_type count(const key_type& k) const {
+		return (find(k) != end());
+	};
+
+	iterator lower_bound(const key_type& k) const {
+		return (_tree.lower_bound(k));
+	};
+
+	iterator upper_bound(const key_type& k) const {
+		return (_tree.upper_bound(k));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_tree.get_allocator());
+	};
+
+	key_compare key_comp(void) const {
+		return (_tree.key_comp());
+	};
+
+	value_compare value_comp(void) const {
+		return (_tree.key_comp());
+	};
+
+	template <typename K1, typename C1, typename A1>
+	friend bool
+	operator==(const flat_set<K1, C1, A1>&, const flat_set<K1, C1, A1>&);
+
+	template <typename K1, typename C1, typename A1>
+	friend bool
+	operator<(const flat_set<K1, C1, A1>&, const flat_set<K1, C1, A1>&);
+};
+#undef CONTAINER
+
+template <class Key, class Compare, class Alloc>
+void swap(flat_set<Key, Compare, Alloc>& lhs, flat_set<Key, Compare, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator==(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (lhs._tree == rhs._tree);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (lhs._tree < rhs._tree);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<=(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (!(rhs < lhs));
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (rhs < lhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>=(const flat_set<Key, Compare, Alloc>& lhs,
+				const flat_set<Key, Compare, Alloc>& rhs) {
+	return (!(lhs < rhs));
+}
+
+};
+#endif
@@ -0,0 +1,467 @@
+#ifndef FLAT_TREE_H
+#define FLAT_TREE_H
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./algorithm.hpp"
+#include "./random_access_iterator.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./vector.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+/*
+		A sorted array of Val with unique keys. Elements are never assigned,
+		only copy-constructed and destroyed, so Val may hold a const key, as
+		flat_map's pair<const Key, T> does. Inserts and erases shift the
+		elements past the position one slot at a time; if a copy throws
+		during the shift, the elements not yet moved are dropped so that
+		what is left stays sorted.
+*/
+#define CONTAINER Container<Val, Alloc>
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = std::allocator<Val> >
+class flat_tree : public CONTAINER {
+public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key 										key_type;
+	typedef Compare 									key_compare;
+	typedef Alloc 										allocator_type;
+	typedef ft::random_access_iterator<pointer>			iterator;
+	typedef ft::random_access_iterator<const_pointer>	const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+private:
+	struct value_less {
+		key_compare comp;
+
+		explicit value_less(const key_compare& c) : comp(c) {}
+
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(KeyOfValue()(x), KeyOfValue()(y)));
+		}
+	};
+
+	struct pointer_less {
+		value_less less;
+
+		explicit pointer_less(const value_less& l) : less(l) {}
+
+		bool operator()(const_pointer x, const_pointer y) const {
+			return (less(*x, *y));
+		}
+	};
+
+		allocator_type							_alloc;
+		pointer									_data;
+		size_type								_size;
+		size_type								_capacity;
+		key_compare								_comp;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit flat_tree(const key_compare& comp = key_compare(),
+					const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _data(NULL), _size(0), _capacity(0), _comp(comp) {};
+
+	template <class InputIterator>
+	flat_tree(InputIterator first, InputIterator last,
+					const key_compare& comp = key_compare(),
+					const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _data(NULL), _size(0), _capacity(0), _comp(comp) {
+		try {
+			insert_unique(first, last);
+		} catch (...) {
+			_release();
+			throw;
+		}
+	};
+
+	flat_tree(const flat_tree& x)
+		: _alloc(x._alloc), _data(NULL), _size(0), _capacity(0), _comp(x._comp) {
+		if (x._size == 0)
+			return;
+		_data = _alloc.allocate(x._size);
+		_capacity = x._size;
+		try {
+			_copy(x._data, x._data + x._size, _data);
+		} catch (...) {
+			_alloc.deallocate(_data, _capacity);
+			throw;
+		}
+		_size = x._size;
+	};
+
+	flat_tree& operator=(const flat_tree& rhs) {
+		if (this != &rhs) {
+			flat_tree tmp(rhs);
+			swap(tmp);
+		}
+		return (*this);
+	};
+
+	~flat_tree(void) {
+		_release();
+	};
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type max_size(void) const {
+		return (_alloc.max_size());
+	};
+
+	size_type capacity(void) const {
+		return (_capacity);
+	};
+
+	void reserve(size_type n) {
+		if (n > max_size())
+			throw std::length_error("flat_tree::reserve");
+		if (n <= _capacity)
+			return;
+		pointer data = _alloc.allocate(n);
+		try {
+			_copy(_data, _data + _size, data);
+		} catch (...) {
+			_alloc.deallocate(data, n);
+			throw;
+		}
+		size_type size = _size;
+		_release();
+		_data = data;
+		_size = size;
+		_capacity = n;
+	};
+
+	void swap(flat_tree& x) {
+		if (this == &x)
+			return;
+		std::swap(_alloc, x._alloc);
+		std::swap(_data, x._data);
+		std::swap(_size, x._size);
+		std::swap(_capacity, x._capacity);
+		std::swap(_comp, x._comp);
+	};
+
+	void clear(void) {
+		_destroy(_data, _data + _size);
+		_size = 0;
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+	allocator_type get_allocator(void) const { return (_alloc); };
+
+	iterator begin(void) { return (iterator(_data)); };
+
+	const_iterator begin(void) const { return (const_iterator(_data)); };
+
+	iterator end(void) { return (iterator(_data + _size)); };
+
+	const_iterator end(void) const { return (const_iterator(_data + _size)); };
+
+	reverse_iterator rbegin(void) { return (reverse_iterator(end())); };
+
+	const_reverse_iterator rbegin(void) const { return (const_reverse_iterator(end())); };
+
+	reverse_iterator rend(void) { return (reverse_iterator(begin())); };
+
+	const_reverse_iterator rend(void) const { return (const_reverse_iterator(begin())); };
+
+	iterator lower_bound(const key_type& k) {
+		return (begin() + (_lower_bound(k) - _data));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (begin() + (_lower_bound(k) - _data));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		return (begin() + (_upper_bound(k) - _data));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		return (begin() + (_upper_bound(k) - _data));
+	};
+
+	iterator find(const key_type& k) {
+		iterator it = lower_bound(k);
+		if (it != end() && !_comp(k, KeyOfValue()(*it)))
+			return (it);
+		return (end());
+	};
+
+	const_iterator find(const key_type& k) const {
+		const_iterator it = lower_bound(k);
+		if (it != end() && !_comp(k, KeyOfValue()(*it)))
+			return (it);
+		return (end());
+	};
+
+	ft::pair<iterator, bool> insert_unique(const value_type& data) {
+		iterator pos = lower_bound(KeyOfValue()(data));
+		if (pos != end() && !_comp(KeyOfValue()(data), KeyOfValue()(*pos)))
+			return (ft::make_pair(pos, false));
+		return (ft::make_pair(_insert_at(pos - begin(), data), true));
+	};
+
+	iterator insert_unique(const_iterator hint, const value_type& data) {
+		const key_type& k = KeyOfValue()(data);
+		if ((hint == end() || _comp(k, KeyOfValue()(*hint)))
+			&& (hint == begin() || _comp(KeyOfValue()(*(hint - 1)), k))) {
+			return (_insert_at(hint - begin(), data));
+		}
+		return (insert_unique(data).first);
+	};
+
+	// Appends the whole batch, sorts it once and merges it into the
+	// existing run; existing keys win over the new ones like map::insert.
+	template <class InputIterator>
+	void insert_unique(InputIterator first, InputIterator last) {
+		size_type old_size = _size;
+		try {
+			while (first != last) {
+				_append(*first);
+				++first;
+			}
+			if (_size != old_size)
+				_sort_unique(old_size);
+		} catch (...) {
+			_destroy(_data + old_size, _data + _size);
+			_size = old_size;
+			throw;
+		}
+	};
+
+	iterator erase(const_iterator position) {
+		return (_erase(position - begin(), position - begin() + 1));
+	};
+
+	iterator erase(const_iterator first, const_iterator last) {
+		return (_erase(first - begin(), last - begin()));
+	};
+
+	size_type erase(const key_type& k) {
+		iterator it = find(k);
+		if (it == end())
+			return (0);
+		erase(it);
+		return (1);
+	};
+
+ private:
+
+	void _construct(pointer p, const value_type& val) {
+		_alloc.construct(p, val);
+	};
+
+	void _destroy(pointer first, pointer last) {
+		for (; first != last; ++first)
+			_alloc.destroy(first);
+	};
+
+	// Copies [first, last) into raw memory at out; on a throw the copies
+	// already made are destroyed.
+	pointer _copy(const_pointer first, const_pointer last, pointer out) {
+		pointer start = out;
+		try {
+			for (; first != last; ++first, ++out)
+				_construct(out, *first);
+		} catch (...) {
+			_destroy(start, out);
+			throw;
+		}
+		return (out);
+	};
+
+	void _release(void) {
+		_destroy(_data, _data + _size);
+		if (_data)
+			_alloc.deallocate(_data, _capacity);
+		_data = NULL;
+		_size = 0;
+		_capacity = 0;
+	};
+
+	void _append(const value_type& val) {
+		if (_size == _capacity)
+			reserve(_capacity ? _capacity * 2 : 1);
+		_construct(_data + _size, val);
+		_size++;
+	};
+
+	// Branch-free binary search: the halving step only selects the next
+	// base, so the compiler lowers it to a conditional move.
+	const_pointer _lower_bound(const key_type& k) const {
+		const_pointer base = _data;
+		size_type n = _size;
+
+		if (n == 0)
+			return (base);
+		while (n > 1) {
+			size_type half = n >> 1;
+			base = _comp(KeyOfValue()(base[half]), k) ? base + half : base;
+			n -= half;
+		}
+		return (base + _comp(KeyOfValue()(*base), k));
+	};
+
+	const_pointer _upper_bound(const key_type& k) const {
+		const_pointer base = _data;
+		size_type n = _size;
+
+		if (n == 0)
+			return (base);
+		while (n > 1) {
+			size_type half = n >> 1;
+			base = !_comp(k, KeyOfValue()(base[half])) ? base + half : base;
+			n -= half;
+		}
+		return (base + !_comp(k, KeyOfValue()(*base)));
+	};
+
+	// A full array grows into a new one, which leaves this one untouched
+	// if a copy throws. Otherwise the tail moves up a slot from the back.
+	iterator _insert_at(size_type i, const value_type& data) {
+		if (_size == _capacity) {
+			size_type capacity = _capacity ? _capacity * 2 : 1;
+			pointer fresh = _alloc.allocate(capacity);
+			pointer made = fresh;
+			try {
+				made = _copy(_data, _data + i, fresh);
+				_construct(made, data);
+				made++;
+				made = _copy(_data + i, _data + _size, made);
+			} catch (...) {
+				_destroy(fresh, made);
+				_alloc.deallocate(fresh, capacity);
+				throw;
+			}
+			size_type size = _size + 1;
+			_release();
+			_data = fresh;
+			_size = size;
+			_capacity = capacity;
+			return (begin() + i);
+		}
+		size_type hole = _size;
+		try {
+			for (; hole > i; hole--) {
+				_construct(_data + hole, _data[hole - 1]);
+				_alloc.destroy(_data + hole - 1);
+			}
+			_construct(_data + i, data);
+		} catch (...) {
+			_destroy(_data + hole + 1, _data + _size + 1);
+			_size = hole;
+			throw;
+		}
+		_size++;
+		return (begin() + i);
+	};
+
+	iterator _erase(size_type first, size_type last) {
+		if (first == last)
+			return (begin() + first);
+		_destroy(_data + first, _data + last);
+		size_type hole = first;
+		size_type next = last;
+		try {
+			for (; next != _size; hole++, next++) {
+				_construct(_data + hole, _data[next]);
+				_alloc.destroy(_data + next);
+			}
+		} catch (...) {
+			_destroy(_data + next, _data + _size);
+			_size = hole;
+			throw;
+		}
+		_size = hole;
+		return (begin() + first);
+	};
+
+	// Sorts [from, end) and merges it with the already sorted [0, from)
+	// into a new array, keeping the first of each run of equal keys. The
+	// new elements are sorted through pointers, since they cannot be
+	// assigned.
+	void _sort_unique(size_type from) {
+		value_less less(_comp);
+		ft::vector<const_pointer> order;
+		order.reserve(_size - from);
+		for (const_pointer p = _data + from; p != _data + _size; ++p)
+			order.push_back(p);
+		ft::stable_sort(order.begin(), order.end(), pointer_less(less));
+
+		pointer fresh = _alloc.allocate(_capacity);
+		pointer out = fresh;
+		try {
+			const_pointer a = _data;
+			const_pointer mid = _data + from;
+			std::size_t b = 0;
+			while (a != mid || b != order.size()) {
+				const_pointer next;
+				if (b == order.size() || (a != mid && !less(*order[b], *a)))
+					next = a++;
+				else
+					next = order[b++];
+				if (out == fresh || less(out[-1], *next)) {
+					_construct(out, *next);
+					out++;
+				}
+			}
+		} catch (...) {
+			_destroy(fresh, out);
+			_alloc.deallocate(fresh, _capacity);
+			throw;
+		}
+		size_type capacity = _capacity;
+		_release();
+		_data = fresh;
+		_size = out - fresh;
+		_capacity = capacity;
+	};
+};
+#undef CONTAINER
+
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline bool operator==(const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
+							const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		return (x.size() == y.size() &&
+						ft::equal(x.begin(), x.end(), y.begin()));
+	}
+
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline bool operator!=(const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
+							const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		return (!(x == y));
+	}
+
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline bool operator<(const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
+							const flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+	}
+
+};
+#endif
@@ -0,0 +1,287 @@
+#ifndef FROZEN_MAP_H
+#define FROZEN_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./algorithm.hpp"
+#include "./eytzinger_iterator.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./map.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class frozen_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Alloc										allocator_type;
+	typedef ft::eytzinger_iterator<const value_type>	iterator;
+	typedef ft::eytzinger_iterator<const value_type>	const_iterator;
+	typedef ft::reverse_iterator<const_iterator>		reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+ private:
+	typedef typename Alloc::template rebind<Key>::other	Key_allocator;
+
+	// Descendants four levels down sit in 16 consecutive slots.
+	enum { PREFETCH_STRIDE = 16 };
+
+	allocator_type										_alloc;
+	Key_allocator										_key_alloc;
+	key_type*											_keys;
+	pointer												_values;
+	size_type											_size;
+	key_compare											_comp;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit frozen_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _key_alloc(alloc), _keys(NULL), _values(NULL), _size(0), _comp(comp)
+		{};
+
+	// [first, last) must be sorted by comp; repeated keys keep the first one.
+	// Out of order elements are dropped rather than misplaced.
+	template <class ForwardIterator>
+	frozen_map(ForwardIterator first, ForwardIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _key_alloc(alloc), _keys(NULL), _values(NULL), _size(0), _comp(comp) {
+		_build(first, last);
+	};
+
+	template <class MapAlloc, class Balance>
+	explicit frozen_map(const ft::map<Key, T, Compare, MapAlloc, Balance>& m,
+		const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _key_alloc(alloc), _keys(NULL), _values(NULL), _size(0), _comp(m.key_comp()) {
+		_build(m.begin(), m.end());
+	};
+
+	frozen_map(const frozen_map& x)
+		: _alloc(x._alloc), _key_alloc(x._key_alloc), _keys(NULL), _values(NULL), _size(0), _comp(x._comp) {
+		_allocate(x._size);
+		for (size_type i = 1; i <= x._size; i++) {
+			_key_alloc.construct(_keys + i, x._keys[i]);
+			_alloc.construct(_values + i, x._values[i]);
+		}
+	};
+
+	~frozen_map(void) {
+		_destroy();
+	};
+
+	frozen_map& operator=(const frozen_map& x) {
+		if (this != &x) {
+			frozen_map tmp(x);
+			swap(tmp);
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	const mapped_type& at(const Key& key) const {
+		const_iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	const_iterator begin(void) const {
+		return (const_iterator(_values, _size, eytzinger::first(_size)));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(_values, _size, 0));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type max_size(void) const {
+		return (_alloc.max_size());
+	};
+
+	void swap(frozen_map& x) {
+		std::swap(_alloc, x._alloc);
+		std::swap(_key_alloc, x._key_alloc);
+		std::swap(_keys, x._keys);
+		std::swap(_values, x._values);
+		std::swap(_size, x._size);
+		std::swap(_comp, x._comp);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	const_iterator find(const key_type& k) const {
+		size_type i = _lower_bound(k);
+		if (i != 0 && !_comp(k, _keys[i]))
+			return (const_iterator(_values, _size, i));
+		return (end());
+	};
+
+	size_type count(const key_type& k) const {
+		return (find(k) != end());
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (const_iterator(_values, _size, _lower_bound(k)));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		return (const_iterator(_values, _size, _upper_bound(k)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+ private:
+
+	void _prefetch(size_type i) const {
+		if (i * PREFETCH_STRIDE <= _size)
+			__builtin_prefetch(_keys + i * PREFETCH_STRIDE);
+	};
+
+	// The descent records each step as one bit of i (1 = went right), so the
+	// answer is the last node where it went left: strip the trailing ones
+	// and that final left turn.
+	size_type _lower_bound(const key_type& k) const {
+		size_type i = 1;
+		while (i <= _size) {
+			_prefetch(i);
+			i = 2 * i + _comp(_keys[i], k);
+		}
+		return (i >> __builtin_ffsl(~i));
+	};
+
+	size_type _upper_bound(const key_type& k) const {
+		size_type i = 1;
+		while (i <= _size) {
+			_prefetch(i);
+			i = 2 * i + !_comp(k, _keys[i]);
+		}
+		return (i >> __builtin_ffsl(~i));
+	};
+
+	void _allocate(size_type n) {
+		if (n == 0)
+			return;
+		_keys = _key_alloc.allocate(n + 1);
+		_values = _alloc.allocate(n + 1);
+		_size = n;
+	};
+
+	void _destroy(void) {
+		if (_size == 0)
+			return;
+		for (size_type i = 1; i <= _size; i++) {
+			_key_alloc.destroy(_keys + i);
+			_alloc.destroy(_values + i);
+		}
+		_key_alloc.deallocate(_keys, _size + 1);
+		_alloc.deallocate(_values, _size + 1);
+		_keys = NULL;
+		_values = NULL;
+		_size = 0;
+	};
+
+	// Two passes: count the keys to keep, then walk the implicit tree in
+	// order and drop each element into its BFS slot. Both passes keep a key
+	// only when it is greater than the last one kept.
+	template <class ForwardIterator>
+	void _build(ForwardIterator first, ForwardIterator last) {
+		size_type n = 0;
+		for (ForwardIterator it = first, kept = first; it != last; ++it) {
+			if (it == first || _comp(kept->first, it->first)) {
+				kept = it;
+				n++;
+			}
+		}
+		_allocate(n);
+		size_type i = eytzinger::first(n);
+		size_type prev = 0;
+		for (; first != last; ++first) {
+			if (prev != 0 && !_comp(_keys[prev], first->first))
+				continue;
+			_key_alloc.construct(_keys + i, first->first);
+			_alloc.construct(_values + i, value_type(first->first, first->second));
+			prev = i;
+			i = eytzinger::next(i, n);
+		}
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare, class Alloc>
+void swap(frozen_map<Key, T, Compare, Alloc>& lhs, frozen_map<Key, T, Compare, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const frozen_map<Key, T, Compare, Alloc>& lhs,
+				const frozen_map<Key, T, Compare, Alloc>& rhs) {
+	return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const frozen_map<Key, T, Compare, Alloc>& lhs,
+				const frozen_map<Key, T, Compare, Alloc>& rhs) {
+	return (!(lhs == rhs));
+}
+
+};
+#endif
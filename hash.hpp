@@ -0,0 +1,54 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <string>
+
+namespace ft {
+
+// MurmurHash3 finalizer: every input bit reaches every output bit, so the
+// low bits alone are good enough to pick a bucket or a shard.
+inline std::size_t hash_mix(unsigned long long x) {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return (static_cast<std::size_t>(x));
+}
+
+inline std::size_t hash_bytes(const void* data, std::size_t len) {
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	unsigned long long h = 0xcbf29ce484222325ULL;
+	for (std::size_t i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 0x100000001b3ULL;
+	}
+	return (hash_mix(h));
+}
+
+// Integral and enumeration keys; other types need a specialization.
+template <typename T>
+struct hash {
+	std::size_t operator()(const T& x) const {
+		return (hash_mix(static_cast<unsigned long long>(x)));
+	}
+};
+
+template <typename T>
+struct hash<T*> {
+	std::size_t operator()(T* x) const {
+		return (hash_mix(reinterpret_cast<std::size_t>(x)));
+	}
+};
+
+template <>
+struct hash<std::string> {
+	std::size_t operator()(const std::string& x) const {
+		return (hash_bytes(x.data(), x.size()));
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,500 @@
+#ifndef INTRUSIVE_RBTREE_H
+#define INTRUSIVE_RBTREE_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+#include "./iterator_traits.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./tree_balance.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*
+		Links embedded in a user object. Copying an object never copies its
+		links, and an object can carry one hook per tree it belongs to.
+*/
+struct rbtree_hook {
+	rbtree_hook*				parent;
+	rbtree_hook*				left;
+	rbtree_hook*				right;
+	Color						color;
+	int							rank;
+
+	rbtree_hook(void) : parent(NULL), left(NULL), right(NULL), color(BLACK), rank(0) {}
+
+	rbtree_hook(const rbtree_hook&) : parent(NULL), left(NULL), right(NULL), color(BLACK), rank(0) {}
+
+	rbtree_hook& operator=(const rbtree_hook&) {
+		return (*this);
+	}
+
+	bool is_linked(void) const {
+		return (parent != NULL);
+	}
+
+	void unlink(void) {
+		parent = NULL;
+		left = NULL;
+		right = NULL;
+	}
+};
+
+template <typename T, rbtree_hook T::*Hook>
+struct intrusive_traits {
+	static std::ptrdiff_t offset(void) {
+		T* base = reinterpret_cast<T*>(sizeof(T));
+		return (reinterpret_cast<char*>(&(base->*Hook)) - reinterpret_cast<char*>(base));
+	}
+
+	static rbtree_hook* to_hook(T& value) {
+		return (&(value.*Hook));
+	}
+
+	static T* to_value(rbtree_hook* hook) {
+		return (reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset()));
+	}
+
+	static rbtree_hook* next(rbtree_hook* x, rbtree_hook* leaf) {
+		if (x->right != leaf)
+			return (tree_algorithms::minimum(x->right, leaf));
+		rbtree_hook* y = x->parent;
+		while (y != leaf && x == y->right) {
+			x = y;
+			y = y->parent;
+		}
+		return (y);
+	}
+
+	// From the header, steps to the largest element.
+	static rbtree_hook* prev(rbtree_hook* x, rbtree_hook* leaf) {
+		if (x == leaf) {
+			x = leaf->left;
+			while (x->right != leaf)
+				x = x->right;
+			return (x);
+		}
+		if (x->left != leaf) {
+			x = x->left;
+			while (x->right != leaf)
+				x = x->right;
+			return (x);
+		}
+		rbtree_hook* y = x->parent;
+		while (y != leaf && x == y->left) {
+			x = y;
+			y = y->parent;
+		}
+		return (y);
+	}
+};
+
+template <typename V, typename T, rbtree_hook T::*Hook>
+class intrusive_iterator : public iterator<std::bidirectional_iterator_tag, V> {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef V									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef V*									pointer;
+	typedef V&									reference;
+	typedef intrusive_traits<T, Hook>			traits;
+
+ protected:
+	rbtree_hook*								node;
+	rbtree_hook*								header;
+
+ public:
+	intrusive_iterator(void) : node(NULL), header(NULL) {}
+
+	intrusive_iterator(rbtree_hook* _node, rbtree_hook* _header) : node(_node), header(_header) {}
+
+	template <typename U>
+	intrusive_iterator(const intrusive_iterator<U, T, Hook>& i) : node(i.base()), header(i.leaf()) {}
+
+	~intrusive_iterator(void) {}
+
+	rbtree_hook* base(void) const {
+		return (node);
+	}
+
+	rbtree_hook* leaf(void) const {
+		return (header);
+	}
+
+	reference operator*(void) const {
+		return (*traits::to_value(node));
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	intrusive_iterator& operator++(void) {
+		node = traits::next(node, header);
+		return (*this);
+	}
+
+	intrusive_iterator operator++(int) {
+		intrusive_iterator tmp(*this);
+		node = traits::next(node, header);
+		return (tmp);
+	}
+
+	intrusive_iterator& operator--(void) {
+		node = traits::prev(node, header);
+		return (*this);
+	}
+
+	intrusive_iterator operator--(int) {
+		intrusive_iterator tmp(*this);
+		node = traits::prev(node, header);
+		return (tmp);
+	}
+};
+
+template <typename VL, typename VR, typename T, rbtree_hook T::*Hook>
+inline bool operator==(const intrusive_iterator<VL, T, Hook>& lhs,
+						const intrusive_iterator<VR, T, Hook>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename VL, typename VR, typename T, rbtree_hook T::*Hook>
+inline bool operator!=(const intrusive_iterator<VL, T, Hook>& lhs,
+						const intrusive_iterator<VR, T, Hook>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+/*
+		Balanced tree over objects the caller owns: insert and erase only
+		relink the hook named by Hook, nothing is allocated or copied.
+		Objects must stay put while linked and be erased before they die.
+		The header is the sentinel leaf and its left link holds the root, so
+		the tree itself cannot be copied.
+*/
+template <class T, rbtree_hook T::*Hook, class Compare = std::less<T>, class Balance = rb_balance>
+class intrusive_rbtree {
+ public:
+	typedef T												value_type;
+	typedef T&												reference;
+	typedef const T&										const_reference;
+	typedef T*												pointer;
+	typedef const T*										const_pointer;
+	typedef std::size_t										size_type;
+	typedef std::ptrdiff_t									difference_type;
+	typedef Compare											value_compare;
+	typedef ft::intrusive_iterator<T, T, Hook>				iterator;
+	typedef ft::intrusive_iterator<const T, T, Hook>		const_iterator;
+	typedef ft::reverse_iterator<iterator>					reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+ private:
+	typedef intrusive_traits<T, Hook>						traits;
+
+	rbtree_hook												_header;
+	size_type												_size;
+	value_compare											_comp;
+
+	intrusive_rbtree(const intrusive_rbtree&);
+	intrusive_rbtree& operator=(const intrusive_rbtree&);
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit intrusive_rbtree(const value_compare& comp = value_compare())
+		: _header(), _size(0), _comp(comp) {
+		_header.left = _leaf();
+	};
+
+	// Unlinks every element; the objects themselves are left alone.
+	~intrusive_rbtree(void) {
+		clear();
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (iterator(_first(), _leaf()));
+	};
+
+	const_iterator begin(void) const {
+		return (const_iterator(_first(), _leaf()));
+	};
+
+	iterator end(void) {
+		return (iterator(_leaf(), _leaf()));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(_leaf(), _leaf()));
+	};
+
+	reverse_iterator rbegin(void) {
+		return (reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	reverse_iterator rend(void) {
+		return (reverse_iterator(begin()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+	// O(1): the hook already knows where the object sits.
+	iterator iterator_to(reference value) {
+		return (iterator(traits::to_hook(value), _leaf()));
+	};
+
+	const_iterator iterator_to(const_reference value) const {
+		return (const_iterator(traits::to_hook(const_cast<reference>(value)), _leaf()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	// Links value unless an equivalent element is already in the tree.
+	ft::pair<iterator, bool> insert(reference value) {
+		rbtree_hook* parent = _leaf();
+		rbtree_hook* x = _root();
+		bool left = true;
+		while (x != _leaf()) {
+			parent = x;
+			if (_comp(value, *traits::to_value(x))) {
+				left = true;
+				x = x->left;
+			} else if (_comp(*traits::to_value(x), value)) {
+				left = false;
+				x = x->right;
+			} else {
+				return (ft::make_pair(iterator(x, _leaf()), false));
+			}
+		}
+		return (ft::make_pair(_link(traits::to_hook(value), parent, left), true));
+	};
+
+	// Links value after any equivalent elements.
+	iterator insert_equal(reference value) {
+		rbtree_hook* parent = _leaf();
+		rbtree_hook* x = _root();
+		bool left = true;
+		while (x != _leaf()) {
+			parent = x;
+			left = _comp(value, *traits::to_value(x));
+			x = left ? x->left : x->right;
+		}
+		return (_link(traits::to_hook(value), parent, left));
+	};
+
+	void erase(iterator position) {
+		rbtree_hook* z = position.base();
+		Balance::erase(z, _header.left, _leaf());
+		z->unlink();
+		_size--;
+	};
+
+	void erase(reference value) {
+		erase(iterator_to(value));
+	};
+
+	void erase(iterator first, iterator last) {
+		while (first != last)
+			erase(first++);
+	};
+
+	void clear(void) {
+		rbtree_hook* x = _root();
+		while (x != _leaf()) {
+			if (x->left != _leaf()) {
+				rbtree_hook* l = x->left;
+				x->left = l->right;
+				l->right = x;
+				x = l;
+			} else {
+				rbtree_hook* r = x->right;
+				x->unlink();
+				x = r;
+			}
+		}
+		_header.left = _leaf();
+		_size = 0;
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const_reference value) {
+		return (find(value, _comp));
+	};
+
+	const_iterator find(const_reference value) const {
+		return (find(value, _comp));
+	};
+
+	// comp must order Key against T both ways, consistently with Compare.
+	template <class Key, class KeyCompare>
+	iterator find(const Key& k, KeyCompare comp) {
+		rbtree_hook* x = _lower_bound(k, comp);
+		if (x == _leaf() || comp(k, *traits::to_value(x)))
+			return (end());
+		Balance::on_access(x, _header.left, _leaf());
+		return (iterator(x, _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	const_iterator find(const Key& k, KeyCompare comp) const {
+		rbtree_hook* x = _lower_bound(k, comp);
+		if (x == _leaf() || comp(k, *traits::to_value(x)))
+			return (end());
+		return (const_iterator(x, _leaf()));
+	};
+
+	size_type count(const_reference value) const {
+		return (find(value) != end());
+	};
+
+	iterator lower_bound(const_reference value) {
+		return (iterator(_lower_bound(value, _comp), _leaf()));
+	};
+
+	const_iterator lower_bound(const_reference value) const {
+		return (const_iterator(_lower_bound(value, _comp), _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	iterator lower_bound(const Key& k, KeyCompare comp) {
+		return (iterator(_lower_bound(k, comp), _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	const_iterator lower_bound(const Key& k, KeyCompare comp) const {
+		return (const_iterator(_lower_bound(k, comp), _leaf()));
+	};
+
+	iterator upper_bound(const_reference value) {
+		return (iterator(_upper_bound(value, _comp), _leaf()));
+	};
+
+	const_iterator upper_bound(const_reference value) const {
+		return (const_iterator(_upper_bound(value, _comp), _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	iterator upper_bound(const Key& k, KeyCompare comp) {
+		return (iterator(_upper_bound(k, comp), _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	const_iterator upper_bound(const Key& k, KeyCompare comp) const {
+		return (const_iterator(_upper_bound(k, comp), _leaf()));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const_reference value) {
+		return (ft::make_pair(lower_bound(value), upper_bound(value)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const_reference value) const {
+		return (ft::make_pair(lower_bound(value), upper_bound(value)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	value_compare value_comp(void) const {
+		return (_comp);
+	};
+
+ private:
+
+	rbtree_hook* _leaf(void) const {
+		return (const_cast<rbtree_hook*>(&_header));
+	};
+
+	rbtree_hook* _root(void) const {
+		return (_header.left);
+	};
+
+	rbtree_hook* _first(void) const {
+		rbtree_hook* x = _root();
+		if (x == _leaf())
+			return (x);
+		return (tree_algorithms::minimum(x, _leaf()));
+	};
+
+	iterator _link(rbtree_hook* z, rbtree_hook* parent, bool left) {
+		z->parent = parent;
+		z->left = _leaf();
+		z->right = _leaf();
+		z->color = RED;
+		z->rank = 0;
+		Balance::init(z);
+		if (parent == _leaf())
+			_header.left = z;
+		else if (left)
+			parent->left = z;
+		else
+			parent->right = z;
+		Balance::insert_fix(z, _header.left, _leaf());
+		_size++;
+		return (iterator(z, _leaf()));
+	};
+
+	template <class Key, class KeyCompare>
+	rbtree_hook* _lower_bound(const Key& k, KeyCompare comp) const {
+		rbtree_hook* x = _root();
+		rbtree_hook* res = _leaf();
+		while (x != _leaf()) {
+			if (!comp(*traits::to_value(x), k)) {
+				res = x;
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		return (res);
+	};
+
+	template <class Key, class KeyCompare>
+	rbtree_hook* _upper_bound(const Key& k, KeyCompare comp) const {
+		rbtree_hook* x = _root();
+		rbtree_hook* res = _leaf();
+		while (x != _leaf()) {
+			if (comp(k, *traits::to_value(x))) {
+				res = x;
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		return (res);
+	};
+};
+
+}
+
+#endif
@@ -0,0 +1,671 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "./algorithm.hpp"
+#include "./iterator_traits.hpp"
+#include "./map.hpp"
+#include "./thread.hpp"
+#include "./type_traits.hpp"
+#include "./utility.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+/*
+		Loads a text file of records, one per line, into a map in three
+		stages that run at once and hand off through bounded queues:
+
+			read	read()s the file in large chunks, each cut after its
+					last newline and the rest carried into the next
+			parse	turns each line into a pair<Key, T> and gathers the
+					pairs in batches
+			sort	stable-sorts each batch as it arrives (the caller)
+
+		Once the input is drained, what the map held and the sorted batches
+		are merged, in that order, into one increasing sequence for
+		map::assign_sorted, which builds the tree in O(n). A key that occurs
+		more than once keeps its first value, as with insert(). Blank lines
+		are skipped; lines the parser refuses are counted and dropped.
+*/
+
+/*****************************************************************************\
+* 							PARSERS				 							   *
+\*****************************************************************************/
+
+inline bool is_field_blank(char c) {
+	return (c == ' ' || c == '\t' || c == '\r');
+}
+
+inline void skip_field_blanks(const char*& first, const char* last) {
+	while (first != last && is_field_blank(*first))
+		first++;
+}
+
+// Each reads the field that starts at first, leaves first just past it
+// and returns false if there is none or it is out of range.
+template <typename T, bool Integral = is_integral<T>::value>
+struct field_parser;
+
+template <typename T>
+struct field_parser<T, true> {
+	bool operator()(const char*& first, const char* last, T& out) const {
+		const char* p = first;
+		bool negative = false;
+		if (p != last && (*p == '-' || *p == '+'))
+			negative = (*p++ == '-');
+		if (p == last || *p < '0' || *p > '9')
+			return (false);
+		unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+		if (negative) {
+			if (!std::numeric_limits<T>::is_signed)
+				return (false);
+			limit++;
+		}
+		unsigned long long v = 0;
+		for (; p != last && *p >= '0' && *p <= '9'; p++) {
+			unsigned d = *p - '0';
+			if (v > (limit - d) / 10)
+				return (false);
+			v = v * 10 + d;
+		}
+		if (negative && v != 0)
+			out = static_cast<T>(-static_cast<long long>(v - 1) - 1);
+		else
+			out = static_cast<T>(v);
+		first = p;
+		return (true);
+	}
+};
+
+template <typename T>
+struct float_field_parser {
+	bool operator()(const char*& first, const char* last, T& out) const {
+		char buf[64];
+		std::size_t n = 0;
+		while (first + n != last && !is_field_blank(first[n]) && n < sizeof(buf) - 1) {
+			buf[n] = first[n];
+			n++;
+		}
+		if (n == 0)
+			return (false);
+		buf[n] = '\0';
+		char* end;
+		errno = 0;
+		double v = std::strtod(buf, &end);
+		if (end == buf || errno == ERANGE)
+			return (false);
+		out = static_cast<T>(v);
+		first += end - buf;
+		return (true);
+	}
+};
+
+template <>
+struct field_parser<float, false> : float_field_parser<float> {};
+
+template <>
+struct field_parser<double, false> : float_field_parser<double> {};
+
+// One run of non-blank characters.
+template <>
+struct field_parser<std::string, false> {
+	bool operator()(const char*& first, const char* last, std::string& out) const {
+		const char* p = first;
+		while (p != last && !is_field_blank(*p))
+			p++;
+		if (p == first)
+			return (false);
+		out.assign(first, p);
+		first = p;
+		return (true);
+	}
+};
+
+// A key and a value separated by blanks, e.g. "42 3.5" or "apple 7".
+template <typename Key, typename T>
+struct record_parser {
+	bool operator()(const char* first, const char* last, ft::pair<Key, T>& out) const {
+		skip_field_blanks(first, last);
+		if (!field_parser<Key>()(first, last, out.first))
+			return (false);
+		if (first == last || !is_field_blank(*first))
+			return (false);
+		skip_field_blanks(first, last);
+		if (!field_parser<T>()(first, last, out.second))
+			return (false);
+		skip_field_blanks(first, last);
+		return (first == last);
+	}
+};
+
+/*****************************************************************************\
+* 							STATISTICS			 							   *
+\*****************************************************************************/
+
+struct load_stage {
+	double												busy;
+	double												waiting;
+	unsigned long long									items;
+
+	load_stage(void) : busy(0), waiting(0), items(0) {}
+
+	// Items per second of work, leaving out the time spent on the queues.
+	double rate(void) const {
+		return (busy > 0 ? items / busy : 0);
+	}
+};
+
+// Items are bytes for read and records for the other stages; build is
+// the final merge and assign_sorted, after the pipeline has drained.
+struct load_stats {
+	load_stage											read;
+	load_stage											parse;
+	load_stage											sort;
+	load_stage											build;
+	unsigned long long									rejected;
+	double												elapsed;
+
+	load_stats(void) : rejected(0), elapsed(0) {}
+};
+
+inline void print_load_stage(std::ostream& os, const char* name, const load_stage& s,
+							const char* unit, double scale) {
+	os << name << s.items / scale << ' ' << unit << " in " << s.busy << " s busy, "
+		<< s.waiting << " s waiting: " << s.rate() / scale << ' ' << unit << "/s\n";
+}
+
+inline std::ostream& operator<<(std::ostream& os, const load_stats& st) {
+	print_load_stage(os, "read   ", st.read, "MB", 1e6);
+	print_load_stage(os, "parse  ", st.parse, "Mrec", 1e6);
+	print_load_stage(os, "sort   ", st.sort, "Mrec", 1e6);
+	print_load_stage(os, "build  ", st.build, "Mrec", 1e6);
+	os << "rejected " << st.rejected << ", elapsed " << st.elapsed << " s\n";
+	return (os);
+}
+
+/*****************************************************************************\
+* 							STAGES				 							   *
+\*****************************************************************************/
+
+// A growable byte buffer that only moves by swap.
+class load_chunk {
+ public:
+	char*												data;
+	std::size_t											size;
+	std::size_t											capacity;
+
+	load_chunk(void) : data(NULL), size(0), capacity(0) {}
+
+	~load_chunk(void) {
+		delete[] data;
+	}
+
+	void reserve(std::size_t n) {
+		if (n <= capacity)
+			return;
+		char* p = new char[n];
+		if (size)
+			std::memcpy(p, data, size);
+		delete[] data;
+		data = p;
+		capacity = n;
+	}
+
+	void swap(load_chunk& x) {
+		std::swap(data, x.data);
+		std::swap(size, x.size);
+		std::swap(capacity, x.capacity);
+	}
+
+ private:
+	load_chunk(const load_chunk&);
+	load_chunk& operator=(const load_chunk&);
+};
+
+inline void swap(load_chunk& x, load_chunk& y) {
+	x.swap(y);
+}
+
+struct load_reader {
+	int													fd;
+	std::size_t											chunk_bytes;
+	bounded_queue<load_chunk>&							out;
+	load_stage											stage;
+	bool												failed;
+
+	load_reader(int _fd, std::size_t _chunk_bytes, bounded_queue<load_chunk>& _out)
+		: fd(_fd), chunk_bytes(_chunk_bytes), out(_out), stage(), failed(false) {}
+
+	void operator()(void) {
+		double start = monotonic_seconds();
+		try {
+			_run();
+		} catch (...) {
+			failed = true;
+		}
+		out.close();
+		stage.waiting = out.push_wait();
+		stage.busy = monotonic_seconds() - start - stage.waiting;
+	}
+
+ private:
+	void _run(void) {
+		load_chunk cur;
+		load_chunk next;
+		bool eof = false;
+		while (!eof) {
+			// A line longer than the buffer doubles it until it fits.
+			cur.reserve(std::max(chunk_bytes, cur.size * 2));
+			while (cur.size < cur.capacity && !eof) {
+				ssize_t n = ::read(fd, cur.data + cur.size, cur.capacity - cur.size);
+				if (n < 0 && errno == EINTR)
+					continue;
+				if (n < 0) {
+					failed = true;
+					return;
+				}
+				eof = (n == 0);
+				cur.size += n;
+				stage.items += n;
+			}
+			std::size_t cut = cur.size;
+			if (!eof)
+				while (cut && cur.data[cut - 1] != '\n')
+					cut--;
+			if (cut == 0 && !eof)
+				continue;
+			next.size = 0;
+			next.reserve(cur.size - cut);
+			if (cur.size != cut)
+				std::memcpy(next.data, cur.data + cut, cur.size - cut);
+			next.size = cur.size - cut;
+			cur.size = cut;
+			if (cut && !out.push(cur))
+				return;
+			cur.swap(next);
+		}
+	}
+};
+
+template <typename Record, typename Parse>
+struct load_parser {
+	bounded_queue<load_chunk>&							in;
+	bounded_queue<ft::vector<Record> >&					out;
+	Parse												parse;
+	std::size_t											batch_records;
+	load_stage											stage;
+	unsigned long long									rejected;
+	bool												failed;
+
+	load_parser(bounded_queue<load_chunk>& _in, bounded_queue<ft::vector<Record> >& _out,
+				const Parse& _parse, std::size_t _batch_records)
+		: in(_in), out(_out), parse(_parse), batch_records(_batch_records ? _batch_records : 1),
+		stage(), rejected(0), failed(false) {}
+
+	void operator()(void) {
+		double start = monotonic_seconds();
+		try {
+			_run();
+		} catch (...) {
+			failed = true;
+		}
+		in.close();
+		out.close();
+		stage.waiting = in.pop_wait() + out.push_wait();
+		stage.busy = monotonic_seconds() - start - stage.waiting;
+	}
+
+ private:
+	void _run(void) {
+		load_chunk chunk;
+		ft::vector<Record> batch;
+		Record r;
+		batch.reserve(batch_records);
+		while (in.pop(chunk)) {
+			const char* p = chunk.data;
+			const char* end = p + chunk.size;
+			while (p != end) {
+				const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+				if (eol == NULL)
+					eol = end;
+				const char* q = p;
+				skip_field_blanks(q, eol);
+				if (q != eol) {
+					if (parse(p, eol, r)) {
+						batch.push_back(r);
+						stage.items++;
+					} else {
+						rejected++;
+					}
+				}
+				p = (eol == end ? end : eol + 1);
+				if (batch.size() >= batch_records) {
+					if (!out.push(batch))
+						return;
+					batch.clear();
+					batch.reserve(batch_records);
+				}
+			}
+		}
+		if (!batch.empty())
+			out.push(batch);
+	}
+};
+
+template <typename Record, typename Compare>
+struct record_key_less {
+	Compare												comp;
+
+	explicit record_key_less(const Compare& _comp) : comp(_comp) {}
+
+	bool operator()(const Record& a, const Record& b) const {
+		return (comp(a.first, b.first));
+	}
+};
+
+/*
+		K-way merge of sorted runs that it owns, each freed once drained.
+		Equal keys come out of the lowest-numbered run first and only the
+		first of them is kept, so the result is strictly increasing.
+*/
+template <typename Record, typename Compare>
+class run_merge {
+ public:
+	typedef std::size_t									size_type;
+
+ private:
+	ft::vector<ft::vector<Record>*>						_runs;
+	ft::vector<size_type>								_pos;
+	ft::vector<size_type>								_heap;
+	ft::vector<size_type>								_drained;
+	Compare												_comp;
+
+	run_merge(const run_merge&);
+	run_merge& operator=(const run_merge&);
+
+ public:
+	explicit run_merge(const Compare& comp) : _comp(comp) {}
+
+	~run_merge(void) {
+		for (size_type i = 0; i < _runs.size(); i++)
+			delete _runs[i];
+	}
+
+	// Takes the contents of run, which must be sorted and stable.
+	void add(ft::vector<Record>& run) {
+		_runs.push_back(NULL);
+		_runs.back() = new ft::vector<Record>();
+		_runs.back()->swap(run);
+	}
+
+	void start(void) {
+		_pos.assign(_runs.size(), size_type(0));
+		_heap.clear();
+		for (size_type i = 0; i < _runs.size(); i++)
+			if (!_runs[i]->empty())
+				_heap.push_back(i);
+		for (size_type i = _heap.size() / 2; i-- > 0; )
+			_sift_down(i);
+	}
+
+	bool empty(void) const {
+		return (_heap.empty());
+	}
+
+	const Record& front(void) const {
+		return ((*_runs[_heap[0]])[_pos[_heap[0]]]);
+	}
+
+	void pop(void) {
+		const Record& last = front();
+		_advance();
+		while (!_heap.empty() && !_comp(last.first, front().first))
+			_advance();
+		for (size_type i = 0; i < _drained.size(); i++) {
+			delete _runs[_drained[i]];
+			_runs[_drained[i]] = NULL;
+		}
+		_drained.clear();
+	}
+
+ private:
+	const Record& _at(size_type run) const {
+		return ((*_runs[run])[_pos[run]]);
+	}
+
+	bool _less(size_type a, size_type b) const {
+		if (_comp(_at(a).first, _at(b).first))
+			return (true);
+		return (!_comp(_at(b).first, _at(a).first) && a < b);
+	}
+
+	// Drained runs are freed by pop() once the element it compares
+	// against is no longer needed.
+	void _advance(void) {
+		size_type top = _heap[0];
+		if (++_pos[top] == _runs[top]->size()) {
+			_drained.push_back(top);
+			_heap[0] = _heap.back();
+			_heap.pop_back();
+		}
+		if (!_heap.empty())
+			_sift_down(0);
+	}
+
+	void _sift_down(size_type i) {
+		size_type n = _heap.size();
+		while (true) {
+			size_type min = i;
+			size_type l = 2 * i + 1;
+			if (l < n && _less(_heap[l], _heap[min]))
+				min = l;
+			if (l + 1 < n && _less(_heap[l + 1], _heap[min]))
+				min = l + 1;
+			if (min == i)
+				return;
+			std::swap(_heap[i], _heap[min]);
+			i = min;
+		}
+	}
+};
+
+template <typename Merge, typename Record>
+class run_merge_iterator : public iterator<std::input_iterator_tag, Record> {
+ public:
+	typedef std::input_iterator_tag						iterator_category;
+	typedef Record										value_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef const Record*								pointer;
+	typedef const Record&								reference;
+
+ private:
+	Merge*												_merge;
+
+ public:
+	explicit run_merge_iterator(Merge* merge = NULL) : _merge(merge) {}
+
+	reference operator*(void) const {
+		return (_merge->front());
+	}
+
+	pointer operator->(void) const {
+		return (&_merge->front());
+	}
+
+	run_merge_iterator& operator++(void) {
+		_merge->pop();
+		return (*this);
+	}
+
+	bool operator==(const run_merge_iterator& x) const {
+		return ((!_merge || _merge->empty()) == (!x._merge || x._merge->empty()));
+	}
+
+	bool operator!=(const run_merge_iterator& x) const {
+		return (!(*this == x));
+	}
+};
+
+// A file opened for reading, closed when this goes.
+class load_file {
+	int													_fd;
+
+	load_file(const load_file&);
+	load_file& operator=(const load_file&);
+
+ public:
+	explicit load_file(const char* path) : _fd(::open(path, O_RDONLY)) {
+		if (_fd < 0)
+			throw std::runtime_error("loader: cannot open file");
+#ifdef POSIX_FADV_SEQUENTIAL
+		posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	}
+
+	~load_file(void) {
+		::close(_fd);
+	}
+
+	int fd(void) const {
+		return (_fd);
+	}
+};
+
+/*
+		Both worker threads. Destroying it, on success or after a throw,
+		closes the queues so that neither worker stays blocked, then joins
+		them.
+*/
+template <typename Record, typename Parse>
+class load_pipeline {
+ public:
+	bounded_queue<load_chunk>							chunks;
+	bounded_queue<ft::vector<Record> >					batches;
+	load_reader											reader;
+	load_parser<Record, Parse>							parser;
+
+ private:
+	thread												_reader_thread;
+	thread												_parser_thread;
+
+	load_pipeline(const load_pipeline&);
+	load_pipeline& operator=(const load_pipeline&);
+
+ public:
+	load_pipeline(int fd, const Parse& parse, std::size_t chunk_bytes, std::size_t batch_records,
+				std::size_t queue_depth)
+		: chunks(queue_depth), batches(queue_depth), reader(fd, chunk_bytes, chunks),
+		parser(chunks, batches, parse, batch_records) {
+		if (!_reader_thread.start(&reader) || !_parser_thread.start(&parser)) {
+			_shut();
+			throw std::runtime_error("loader: cannot start thread");
+		}
+	}
+
+	~load_pipeline(void) {
+		_shut();
+	}
+
+	// Waits for both workers to finish.
+	void join(void) {
+		_parser_thread.join();
+		_reader_thread.join();
+	}
+
+ private:
+	void _shut(void) {
+		chunks.close();
+		batches.close();
+		join();
+	}
+};
+
+struct load_options {
+	std::size_t											chunk_bytes;
+	std::size_t											batch_records;
+	std::size_t											queue_depth;
+
+	load_options(void) : chunk_bytes(4 << 20), batch_records(1 << 16), queue_depth(4) {}
+};
+
+/*****************************************************************************\
+* 							LOAD				 							   *
+\*****************************************************************************/
+
+// Adds the records of the file at path to m, parsing each line with
+// parse(first, last, pair<Key, T>&), which returns false to reject it.
+// Throws std::runtime_error if the file cannot be read; m is then left
+// as it was.
+template <class Key, class T, class Compare, class Alloc, class Balance, class Parse>
+load_stats load_records(const char* path, map<Key, T, Compare, Alloc, Balance>& m, Parse parse,
+						const load_options& options = load_options()) {
+	typedef ft::pair<Key, T>							record;
+	typedef record_key_less<record, Compare>			key_less;
+	typedef run_merge<record, Compare>					merge_type;
+
+	load_stats st;
+	double start = monotonic_seconds();
+	load_file file(path);
+	merge_type merge(m.key_comp());
+	// What m holds goes first, so that its keys keep their values.
+	ft::vector<record> batch;
+	batch.reserve(m.size());
+	for (typename map<Key, T, Compare, Alloc, Balance>::iterator it = m.begin(); it != m.end(); ++it)
+		batch.push_back(record(it->first, it->second));
+	merge.add(batch);
+	st.build.busy = monotonic_seconds() - start;
+	{
+		load_pipeline<record, Parse> pipe(file.fd(), parse, options.chunk_bytes, options.batch_records,
+										options.queue_depth);
+		double sort_start = monotonic_seconds();
+		key_less less(m.key_comp());
+		while (pipe.batches.pop(batch)) {
+			if (!batch.empty())
+				ft::stable_sort(&batch[0], &batch[0] + batch.size(), less);
+			st.sort.items += batch.size();
+			merge.add(batch);
+		}
+		pipe.join();
+		st.sort.waiting = pipe.batches.pop_wait();
+		st.sort.busy = monotonic_seconds() - sort_start - st.sort.waiting;
+		if (pipe.reader.failed)
+			throw std::runtime_error("loader: read failed");
+		if (pipe.parser.failed)
+			throw std::runtime_error("loader: parse failed");
+		st.read = pipe.reader.stage;
+		st.parse = pipe.parser.stage;
+		st.rejected = pipe.parser.rejected;
+	}
+	double build_start = monotonic_seconds();
+	merge.start();
+	m.assign_sorted(run_merge_iterator<merge_type, record>(&merge),
+					run_merge_iterator<merge_type, record>());
+	st.build.items = m.size();
+	st.build.busy += monotonic_seconds() - build_start;
+	st.elapsed = monotonic_seconds() - start;
+	return (st);
+}
+
+template <class Key, class T, class Compare, class Alloc, class Balance>
+load_stats load_records(const char* path, map<Key, T, Compare, Alloc, Balance>& m,
+						const load_options& options = load_options()) {
+	return (load_records(path, m, record_parser<Key, T>(), options));
+}
+
+}
+
+#endif
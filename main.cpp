@@ -6,7 +6,31 @@
 #include "vector.hpp"
 #include "map.hpp"
 #include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
 #include <sys/time.h>
+#ifndef STD
+	#include "adaptive_map.hpp"
+	#include "flat_map.hpp"
+	#include "flat_set.hpp"
+	#include "frozen_map.hpp"
+	#include "intrusive_rbtree.hpp"
+	#include "parallel.hpp"
+	#include "persistent_map.hpp"
+	#include "radix_map.hpp"
+	#include "serialize.hpp"
+	#include "string_radix_map.hpp"
+	#include "concurrent_map.hpp"
+	#include "disk_map.hpp"
+	#include "loader.hpp"
+	#include "checkpoint.hpp"
+	#include "filtered_map.hpp"
+	#include "sharded_map.hpp"
+	#include "thread.hpp"
+#endif
 
 #define NS ft
 #define PRINTNS "ft"
@@ -180,10 +204,1394 @@ void test_map()
 
 };
 
+/*
+		The containers and algorithms built on top of vector and map. Each
+		case runs on the ft type in the ft build and on the std type that
+		should behave the same in the std build, so ftmap.txt and stdmap.txt
+		must still match line for line.
+*/
+
+// A fixed key sequence, the same in both builds.
+int next_key(unsigned& seed, int range)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (static_cast<int>((seed >> 8) % static_cast<unsigned>(range)));
+}
+
+template<typename Map>
+void write_pairs(const Map& m, std::ofstream& os) {
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		os << it->first << " => " << it->second << "\n";
+	os << m.size() << "\n";
+}
+
+template<typename Set>
+void write_keys(const Set& s, std::ofstream& os) {
+	for (typename Set::const_iterator it = s.begin(); it != s.end(); ++it)
+		os << *it << " ";
+	os << "\n" << s.size() << "\n";
+}
+
+void test_flat_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<int, std::string>			map_type;
+	typedef std::set<int>						set_type;
+#else
+	typedef ft::flat_map<int, std::string>		map_type;
+	typedef ft::flat_set<int>					set_type;
+#endif
+	unsigned seed = 26;
+	map_type m;
+	set_type s;
+	for (int i = 0; i < 300; i++) {
+		int k = next_key(seed, 120);
+		m[k] += static_cast<char>('a' + i % 26);
+		s.insert(k);
+	}
+	map_type::iterator hint = m.lower_bound(60);
+	m.insert(hint, map_type::value_type(-1, "hinted"));
+	m.insert(m.end(), map_type::value_type(500, "end"));
+	m.erase(m.find(m.begin()->first));
+	os << m.erase(30) << m.erase(1000) << "\n";
+	m.erase(m.lower_bound(80), m.upper_bound(90));
+	os << m.count(85) << m.count(100) << m.at(500) << "\n";
+	for (map_type::reverse_iterator it = m.rbegin(); it != m.rend() && it->first > 100; ++it)
+		os << it->first << " ";
+	os << "\n";
+	map_type copy(m.begin(), m.end());
+	os << (copy == m) << (copy < m) << "\n";
+	write_pairs(m, os);
+	s.erase(s.lower_bound(10), s.lower_bound(50));
+	write_keys(s, os);
+}
+
+void test_frozen_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<int, int>					source_type;
+	typedef std::map<int, int>					frozen_type;
+#else
+	typedef ft::map<int, int>					source_type;
+	typedef ft::frozen_map<int, int>			frozen_type;
+#endif
+	unsigned seed = 27;
+	source_type src;
+	for (int i = 0; i < 500; i++)
+		src[next_key(seed, 2000)] = i;
+	frozen_type f(src.begin(), src.end());
+	frozen_type empty;
+	os << f.size() << " " << empty.size() << " " << (empty.find(3) == empty.end()) << "\n";
+	for (int k = -5; k < 2010; k += 37) {
+		frozen_type::const_iterator it = f.find(k);
+		frozen_type::const_iterator lo = f.lower_bound(k);
+		frozen_type::const_iterator hi = f.upper_bound(k);
+		os << k << ": " << (it == f.end() ? -1 : it->second)
+			<< " " << (lo == f.end() ? -1 : lo->first)
+			<< " " << (hi == f.end() ? -1 : hi->first) << " " << f.count(k) << "\n";
+	}
+	for (frozen_type::const_reverse_iterator it = f.rbegin(); it != f.rend(); ++it)
+		os << it->first << " ";
+	os << "\n" << f.at(f.begin()->first) << "\n";
+	write_pairs(f, os);
+}
+
+void test_find_batch(std::ofstream& os)
+{
+	typedef NS::map<int, int>					map_type;
+	unsigned seed = 28;
+	map_type m;
+	for (int i = 0; i < 1000; i++)
+		m[next_key(seed, 3000)] = i;
+	int keys[64];
+	map_type::iterator found[64];
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < 64; i++)
+			keys[i] = (round == 0 ? i * 47 : next_key(seed, 3100));
+#ifdef STD
+		for (int i = 0; i < 64; i++)
+			found[i] = m.find(keys[i]);
+#else
+		m.find_batch(keys, keys + 64, found);
+#endif
+		for (int i = 0; i < 64; i++)
+			os << keys[i] << ":" << (found[i] == m.end() ? -1 : found[i]->second) << " ";
+		os << "\n";
+	}
+}
+
+// A persistent_map snapshot is a copy that costs nothing to take.
+#ifdef STD
+typedef std::map<int, std::string>				persistent_type;
+
+void persistent_assign(persistent_type& m, int k, const std::string& v)
+{
+	m[k] = v;
+}
+#else
+typedef ft::persistent_map<int, std::string>	persistent_type;
+
+void persistent_assign(persistent_type& m, int k, const std::string& v)
+{
+	m.insert_or_assign(k, v);
+}
+#endif
+
+void test_persistent_map(std::ofstream& os)
+{
+	unsigned seed = 29;
+	persistent_type m;
+	persistent_type versions[4];
+	for (int v = 0; v < 4; v++) {
+		for (int i = 0; i < 100; i++) {
+			int k = next_key(seed, 300);
+			if (i % 4 == 3)
+				m.erase(k);
+			else if (i % 4 == 2)
+				persistent_assign(m, k, "assigned");
+			else
+				m.insert(persistent_type::value_type(k, "inserted"));
+		}
+#ifdef STD
+		versions[v] = m;
+#else
+		versions[v] = m.snapshot();
+#endif
+	}
+	m.clear();
+	os << m.size() << "\n";
+	for (int v = 0; v < 4; v++) {
+		persistent_type::const_iterator lo = versions[v].lower_bound(100);
+		persistent_type::const_iterator hi = versions[v].upper_bound(200);
+		os << versions[v].count(150) << " " << std::distance(lo, hi) << "\n";
+		write_pairs(versions[v], os);
+	}
+}
+
+// Inserts the keys of one residue class and erases every third of them,
+// reading the rest of the map as it goes.
+template<typename Map>
+struct concurrent_writer {
+	Map*										map;
+	int											part;
+	int											parts;
+	long										seen;
+
+	void operator()(void) {
+		typename Map::mapped_type v;
+		for (int k = part; k < 4000; k += parts) {
+			map->insert(typename Map::value_type(k, k * 2));
+			if (map->find(k + 1, v))
+				seen++;
+		}
+		for (int k = part; k < 4000; k += 3 * parts)
+			map->erase(k);
+	}
+};
+
+#ifdef STD
+struct std_concurrent_map : std::map<int, int> {
+	bool find(int k, int& out) const {
+		const_iterator it = std::map<int, int>::find(k);
+		if (it == end())
+			return (false);
+		out = it->second;
+		return (true);
+	}
+};
+#endif
+
+// Runs the writers together in the ft build and one by one in the std
+// build, then prints what is left.
+template<typename Map>
+void run_writers(Map& m, std::ofstream& os)
+{
+	enum { WRITERS = 4 };
+	concurrent_writer<Map> writers[WRITERS];
+	for (int i = 0; i < WRITERS; i++) {
+		writers[i].map = &m;
+		writers[i].part = i;
+		writers[i].parts = WRITERS;
+		writers[i].seen = 0;
+	}
+#ifdef STD
+	for (int i = 0; i < WRITERS; i++)
+		writers[i]();
+#else
+	{
+		ft::thread threads[WRITERS];
+		for (int i = 0; i < WRITERS; i++)
+			threads[i].start(&writers[i]);
+	}
+#endif
+	int v = -1;
+	os << m.find(7, v) << " " << v << " " << m.find(12, v) << " " << m.count(4001) << "\n";
+	typename Map::const_iterator lo = m.lower_bound(1000);
+	typename Map::const_iterator hi = m.upper_bound(1100);
+	for (; lo != hi; ++lo)
+		os << lo->first << " ";
+	os << "\n";
+	write_pairs(m, os);
+}
+
+void test_concurrent_map(std::ofstream& os)
+{
+#ifdef STD
+	std_concurrent_map m;
+#else
+	ft::concurrent_map<int, int> m;
+#endif
+	run_writers(m, os);
+}
+
+void test_sharded_map(std::ofstream& os)
+{
+#ifdef STD
+	std_concurrent_map m;
+#else
+	ft::sharded_map<int, int, 8> m;
+#endif
+	run_writers(m, os);
+}
+
+template<typename Map>
+void run_balanced(std::ofstream& os)
+{
+	unsigned seed = 32;
+	Map m;
+	for (int i = 0; i < 3000; i++) {
+		int k = next_key(seed, 1000);
+		if (i % 3 == 2)
+			m.erase(k);
+		else
+			m.insert(typename Map::value_type(k, i));
+	}
+	long sum = 0;
+	for (int k = 0; k < 1000; k += 7) {
+		typename Map::iterator it = m.find(k);
+		if (it != m.end())
+			sum += it->second;
+	}
+	typename Map::iterator it = m.begin();
+	for (int k = 1000; k < 1200; k++)
+		it = m.insert(it, typename Map::value_type(k, k));
+	m.erase(m.lower_bound(200), m.upper_bound(400));
+	Map copy(m);
+	os << sum << " " << (copy == m) << " " << m.rbegin()->first << "\n";
+	write_pairs(m, os);
+}
+
+void test_balance_policies(std::ofstream& os)
+{
+	typedef std::less<int>									less;
+	typedef std::allocator<NS::pair<const int, int> >		alloc;
+#ifdef STD
+	run_balanced<std::map<int, int, less, alloc> >(os);
+	run_balanced<std::map<int, int, less, alloc> >(os);
+	run_balanced<std::map<int, int, less, alloc> >(os);
+	run_balanced<std::map<int, int, less, alloc> >(os);
+#else
+	run_balanced<ft::map<int, int, less, alloc, ft::rb_balance> >(os);
+	run_balanced<ft::map<int, int, less, alloc, ft::avl_balance> >(os);
+	run_balanced<ft::map<int, int, less, alloc, ft::treap_balance> >(os);
+	run_balanced<ft::map<int, int, less, alloc, ft::splay_balance> >(os);
+#endif
+}
+
+// Sizes around Inline, so maps move between the slots and the tree both
+// ways.
+void test_adaptive_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<int, std::string>				map_type;
+#else
+	typedef ft::adaptive_map<int, std::string>		map_type;
+#endif
+	unsigned seed = 33;
+	map_type m;
+	for (int round = 0; round < 6; round++) {
+		int n = (round % 2 ? 3 : 20);
+		for (int i = 0; i < n; i++)
+			m[next_key(seed, 30)] += static_cast<char>('a' + round);
+		while (m.size() > static_cast<size_t>(round % 2 ? 2 : 12))
+			m.erase(m.begin());
+		map_type::iterator it = m.lower_bound(15);
+		os << (it == m.end() ? -1 : it->first) << " " << m.count(15) << "\n";
+		write_pairs(m, os);
+	}
+	map_type copy(m);
+	copy.insert(m.begin(), m.end());
+	copy[99] = "z";
+	os << (copy == m) << "\n";
+	write_pairs(copy, os);
+}
+
+struct indexed_item {
+	int											key;
+	int											payload;
+#ifndef STD
+	ft::rbtree_hook								hook;
+#endif
+
+	bool operator<(const indexed_item& x) const {
+		return (key < x.key);
+	}
+};
+
+// The std build keeps copies in a std::set; the ft build links the items.
+void test_intrusive_rbtree(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::set<indexed_item>								tree_type;
+#else
+	typedef ft::intrusive_rbtree<indexed_item, &indexed_item::hook>	tree_type;
+#endif
+	unsigned seed = 34;
+	indexed_item items[300];
+	tree_type t;
+	for (int i = 0; i < 300; i++) {
+		items[i].key = next_key(seed, 500);
+		items[i].payload = i;
+		os << t.insert(items[i]).second;
+	}
+	os << "\n";
+	for (int i = 0; i < 300; i += 4) {
+		tree_type::iterator it = t.find(items[i]);
+		if (it != t.end())
+			t.erase(it);
+	}
+	for (int i = 0; i < 300; i += 31) {
+		tree_type::iterator it = t.find(items[i]);
+		os << (it == t.end() ? -1 : it->payload) << " ";
+	}
+	os << "\n";
+	for (tree_type::const_iterator it = t.begin(); it != t.end(); ++it)
+		os << it->key << ":" << it->payload << " ";
+	os << "\n" << t.size() << "\n";
+	t.clear();
+}
+
+typedef NS::map<int, std::string>				node_map;
+
+// Moves k from a to b, marking its value; a key b already holds goes back
+// to a. The std build copies and erases what the ft build relinks.
+int transfer(node_map& a, int k, node_map& b)
+{
+#ifdef STD
+	node_map::iterator it = a.find(k);
+	if (it == a.end())
+		return (-1);
+	std::string v = it->second + "!";
+	a.erase(it);
+	if (b.insert(std::make_pair(k, v)).second)
+		return (1);
+	a.insert(std::make_pair(k, v));
+	return (0);
+#else
+	node_map::node_type nh = a.extract(k);
+	if (nh.empty())
+		return (-1);
+	nh.mapped() += "!";
+	node_map::insert_return_type res = b.insert(nh);
+	if (res.inserted)
+		return (1);
+	a.insert(res.node);
+	return (0);
+#endif
+}
+
+void splice_range(node_map& to, node_map& from, int lo, int hi)
+{
+#ifdef STD
+	node_map::iterator it = from.lower_bound(lo);
+	node_map::iterator last = from.lower_bound(hi);
+	while (it != last) {
+		if (to.insert(*it).second)
+			from.erase(it++);
+		else
+			++it;
+	}
+#else
+	to.splice(from, from.lower_bound(lo), from.lower_bound(hi));
+#endif
+}
+
+void test_node_handles(std::ofstream& os)
+{
+	unsigned seed = 35;
+	node_map a;
+	node_map b;
+	for (int i = 0; i < 200; i++) {
+		a[next_key(seed, 400)] = "a";
+		b[next_key(seed, 400)] = "b";
+	}
+	for (int i = 0; i < 40; i++)
+		os << transfer(a, next_key(seed, 400), b);
+	os << "\n";
+	splice_range(b, a, 100, 200);
+	write_pairs(a, os);
+	splice_range(b, a, 0, 400);
+	write_pairs(a, os);
+	write_pairs(b, os);
+}
+
+void test_insert_or_assign(std::ofstream& os)
+{
+	typedef NS::map<int, std::string>				map_type;
+	unsigned seed = 36;
+	map_type m;
+	map_type::iterator hint = m.end();
+	for (int i = 0; i < 400; i++) {
+		int k = next_key(seed, 200);
+		std::string v(1, static_cast<char>('a' + i % 26));
+		bool inserted;
+		if (i % 3 == 0) {
+#ifdef STD
+			map_type::iterator it = m.find(k);
+			inserted = (it == m.end());
+			if (inserted)
+				m.insert(std::make_pair(k, v));
+			else
+				it->second = v;
+#else
+			inserted = m.insert_or_assign(k, v).second;
+#endif
+		} else if (i % 3 == 1) {
+#ifdef STD
+			inserted = m.insert(std::make_pair(k, std::string(3, v[0]))).second;
+#else
+			inserted = m.try_emplace(k, v + v + v).second;
+#endif
+		} else {
+			size_t before = m.size();
+			hint = m.insert(hint, map_type::value_type(k, v));
+			inserted = (m.size() != before);
+		}
+		os << inserted;
+	}
+	os << "\n";
+	write_pairs(m, os);
+}
+
+struct multiple_of {
+	int											n;
+
+	explicit multiple_of(int _n) : n(_n) {}
+
+	template<typename Pair>
+	bool operator()(const Pair& p) const {
+		return (p.first % n == 0);
+	}
+};
+
+template<typename Map, typename Predicate>
+size_t remove_where(Map& m, Predicate pred, bool keep)
+{
+#ifdef STD
+	size_t n = 0;
+	for (typename Map::iterator it = m.begin(); it != m.end(); ) {
+		if (pred(*it) != keep) {
+			m.erase(it++);
+			n++;
+		} else {
+			++it;
+		}
+	}
+	return (n);
+#else
+	return (keep ? m.retain(pred) : ft::erase_if(m, pred));
+#endif
+}
+
+// Small purges unlink node by node, large ones rebuild the tree.
+void test_erase_if(std::ofstream& os)
+{
+	NS::map<int, int> m;
+	for (int i = 0; i < 2000; i++)
+		m[i * 3 % 2000] = i;
+	os << remove_where(m, multiple_of(97), false) << "\n";
+	os << remove_where(m, multiple_of(2), false) << "\n";
+	os << remove_where(m, multiple_of(3), true) << "\n";
+	os << remove_where(m, multiple_of(1), false) << "\n";
+	write_pairs(m, os);
+	for (int i = 0; i < 300; i++)
+		m[i] = i;
+	os << remove_where(m, multiple_of(5), true) << "\n";
+	write_pairs(m, os);
+}
+
+// Clustered lookups, each hinted with the previous answer, and then the
+// same walk through the finger cache.
+void test_finger_search(std::ofstream& os)
+{
+	typedef NS::map<int, int>						map_type;
+	unsigned seed = 38;
+	map_type m;
+	for (int i = 0; i < 3000; i++)
+		m[next_key(seed, 10000)] = i;
+	for (int pass = 0; pass < 2; pass++) {
+#ifndef STD
+		m.finger_cache(pass == 1);
+#endif
+		map_type::iterator at = m.begin();
+		long sum = 0;
+		for (int k = 0; k < 10000; k += 1 + next_key(seed, 40)) {
+#ifdef STD
+			map_type::iterator lo = m.lower_bound(k);
+			map_type::iterator it = m.find(k);
+#else
+			map_type::iterator lo = (pass == 0 ? m.lower_bound(k, at) : m.lower_bound(k));
+			map_type::iterator it = (pass == 0 ? m.find(k, at) : m.find(k));
+#endif
+			if (lo != m.end()) {
+				sum += lo->first;
+				at = lo;
+			}
+			if (it != m.end())
+				os << it->second << " ";
+		}
+		os << "\n" << sum << "\n";
+	}
+}
+
+// Dense and sparse keys of both signs, so nodes of every width appear and
+// shrink again.
+void test_radix_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<long, int>						map_type;
+#else
+	typedef ft::radix_map<long, int>				map_type;
+#endif
+	unsigned seed = 39;
+	map_type m;
+	for (int i = 0; i < 600; i++) {
+		long k = next_key(seed, 300) - 150;
+		if (i % 5 == 0)
+			k = k * 1000003L;
+		m.insert(map_type::value_type(k, i));
+		if (i % 7 == 6)
+			m.erase(next_key(seed, 300) - 150);
+	}
+	m[-1L << 40] = -1;
+	m[1L << 50] = 1;
+	for (long k = -300; k < 300; k += 23) {
+		map_type::iterator lo = m.lower_bound(k);
+		map_type::iterator hi = m.upper_bound(k);
+		os << (lo == m.end() ? -1 : lo->second) << " " << (hi == m.end() ? -1 : hi->second)
+			<< " " << m.count(k) << "\n";
+	}
+	for (map_type::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		os << it->first << " ";
+	os << "\n";
+	m.erase(m.lower_bound(-50), m.lower_bound(50));
+	write_pairs(m, os);
+}
+
+// Keys that share long prefixes and keys that prefix one another.
+void test_string_radix_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<std::string, int>				map_type;
+#else
+	typedef ft::string_radix_map<int>				map_type;
+#endif
+	static const char* stems[] = { "", "a", "ab", "abc", "car", "cart", "carton", "cat", "dog" };
+	unsigned seed = 40;
+	map_type m;
+	for (int i = 0; i < 400; i++) {
+		std::string k = stems[next_key(seed, 9)];
+		int n = next_key(seed, 4);
+		for (int j = 0; j < n; j++)
+			k += static_cast<char>('a' + next_key(seed, 3));
+		if (i % 6 == 5)
+			m.erase(k);
+		else
+			m[k] += i;
+	}
+	const char* probes[] = { "", "a", "ca", "cart", "cartoon", "d", "z" };
+	for (int i = 0; i < 7; i++) {
+		map_type::iterator lo = m.lower_bound(probes[i]);
+		map_type::iterator hi = m.upper_bound(probes[i]);
+		os << "'" << probes[i] << "' " << m.count(probes[i]) << " "
+			<< (lo == m.end() ? "end" : lo->first) << " " << (hi == m.end() ? "end" : hi->first) << "\n";
+	}
+	std::string prefix("car");
+#ifdef STD
+	map_type::iterator first = m.lower_bound(prefix);
+	map_type::iterator last = first;
+	while (last != m.end() && last->first.compare(0, prefix.size(), prefix) == 0)
+		++last;
+#else
+	map_type::iterator first = m.prefix_range(prefix).first;
+	map_type::iterator last = m.prefix_range(prefix).second;
+#endif
+	for (; first != last; ++first)
+		os << first->first << " ";
+	os << "\n";
+	for (map_type::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		os << it->first << " ";
+	os << "\n";
+	write_pairs(m, os);
+}
+
+// Mostly missing keys, with enough growth and erasure that the filter is
+// rebuilt and its counters go back down.
+void test_filtered_map(std::ofstream& os)
+{
+#ifdef STD
+	typedef std::map<int, int>						map_type;
+#else
+	typedef ft::filtered_map<int, int>				map_type;
+#endif
+	unsigned seed = 41;
+	map_type m;
+	for (int i = 0; i < 5000; i++)
+		m[next_key(seed, 100000)] = i;
+	for (int k = 0; k < 100000; k += 3)
+		m.erase(k);
+	long hits = 0;
+	for (int i = 0; i < 20000; i++) {
+		int k = next_key(seed, 100000);
+		map_type::iterator it = m.find(k);
+		if (it != m.end())
+			hits += it->second;
+		hits += m.count(k + 1);
+	}
+	os << hits << "\n";
+	try {
+		os << m.at(-1) << "\n";
+	} catch (std::out_of_range&) {
+		os << "out_of_range\n";
+	}
+	m.erase(m.begin(), m.lower_bound(90000));
+	write_pairs(m, os);
+}
+
+typedef NS::map<int, long>						parallel_map;
+
+#ifndef STD
+// Four workers even on one processor, so the pool really is shared.
+ft::parallel::work_stealing_pool& harness_pool(void)
+{
+	static ft::parallel::work_stealing_pool pool(4);
+	return (pool);
+}
+#endif
+
+struct add_key {
+	const parallel_map*							other;
+
+	void operator()(parallel_map::value_type& v) const {
+		v.second += v.first;
+		if (other != NULL && v.first % 100 == 0) {
+#ifdef STD
+			for (parallel_map::const_iterator it = other->begin(); it != other->end(); ++it)
+				v.second += it->second;
+#else
+			v.second = ft::parallel::reduce(*other, v.second, std::plus<long>(), harness_pool());
+#endif
+		}
+	}
+};
+
+struct last_digit {
+	std::string operator()(const parallel_map::value_type& v) const {
+		return (std::string(1, static_cast<char>('0' + v.first % 10)));
+	}
+};
+
+long sum_values(const parallel_map& m)
+{
+#ifdef STD
+	long sum = 0;
+	for (parallel_map::const_iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->second;
+	return (sum);
+#else
+	return (ft::parallel::reduce(m, 0L, std::plus<long>(), harness_pool()));
+#endif
+}
+
+struct summing_caller {
+	const parallel_map*							map;
+	long										sum;
+
+	void operator()(void) {
+		sum = 0;
+		for (int i = 0; i < 20; i++)
+			sum += sum_values(*map);
+	}
+};
+
+// A concatenation shows the fold keeps key order. The last part has
+// several threads share one pool, and for_each bodies that call back
+// into it.
+void test_parallel(std::ofstream& os)
+{
+	unsigned seed = 42;
+	parallel_map m;
+	parallel_map small;
+	for (int i = 0; i < 3000; i++)
+		m[next_key(seed, 20000)] = i;
+	for (int i = 0; i < 50; i++)
+		small[i] = i;
+	add_key f;
+	f.other = NULL;
+#ifdef STD
+	for (parallel_map::iterator it = m.begin(); it != m.end(); ++it)
+		f(*it);
+	std::string digits;
+	for (parallel_map::const_iterator it = m.begin(); it != m.end(); ++it)
+		digits += last_digit()(*it);
+#else
+	ft::parallel::for_each(m, f, harness_pool());
+	std::string digits = ft::parallel::transform_reduce(m, std::string(), std::plus<std::string>(),
+		last_digit(), harness_pool());
+#endif
+	os << sum_values(m) << "\n" << digits << "\n";
+	f.other = &small;
+#ifdef STD
+	for (parallel_map::iterator it = m.begin(); it != m.end(); ++it)
+		f(*it);
+#else
+	ft::parallel::for_each(m, f, harness_pool());
+#endif
+	summing_caller callers[3];
+	for (int i = 0; i < 3; i++)
+		callers[i].map = &m;
+#ifdef STD
+	for (int i = 0; i < 3; i++)
+		callers[i]();
+#else
+	{
+		ft::thread threads[3];
+		for (int i = 0; i < 3; i++)
+			threads[i].start(&callers[i]);
+	}
+#endif
+	for (int i = 0; i < 3; i++)
+		os << callers[i].sum << " ";
+	os << "\n";
+	write_pairs(m, os);
+}
+
+// Steps both ways through a map under churn: with THREADED=1 the ft
+// build follows the next and prev links instead of climbing the tree.
+void test_iteration(std::ofstream& os)
+{
+	typedef NS::map<int, int>						map_type;
+	unsigned seed = 43;
+	map_type m;
+	for (int i = 0; i < 2000; i++)
+		m[next_key(seed, 5000)] = i;
+	for (map_type::iterator it = m.begin(); it != m.end(); ) {
+		if (it->second % 3 == 0)
+			m.erase(it++);
+		else
+			++it;
+	}
+	unsigned long forward = 0;
+	unsigned long backward = 0;
+	for (map_type::const_iterator it = m.begin(); it != m.end(); ++it)
+		forward = forward * 31 + it->first;
+	map_type::iterator it = m.end();
+	while (it != m.begin()) {
+		--it;
+		backward = backward * 31 + it->first;
+	}
+	os << forward << " " << backward << "\n";
+	for (map_type::reverse_iterator r = m.rbegin(); r != m.rend() && r->first > 4800; ++r)
+		os << r->first << " ";
+	os << "\n";
+	map_type::iterator mid = m.lower_bound(2500);
+	for (int i = 0; i < 10; i++)
+		m.insert(mid, map_type::value_type(2490 + i, i));
+	for (int i = 0; i < 20 && mid != m.begin(); i++)
+		--mid;
+	for (int i = 0; i < 40 && mid != m.end(); i++, mid++)
+		os << mid->first << " ";
+	os << "\n";
+}
+
+// Keeps using a map after compacting it: nodes in the block are erased
+// and new ones allocated beside them, then it is compacted again.
+void test_compact(std::ofstream& os)
+{
+	typedef NS::map<int, std::string>				map_type;
+	unsigned seed = 44;
+	map_type m;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 500; i++) {
+			int k = next_key(seed, 1000);
+			if (i % 3 == 0)
+				m.erase(k);
+			else
+				m[k] = std::string(1 + i % 5, static_cast<char>('a' + round));
+		}
+#ifndef STD
+		m.compact();
+#endif
+		map_type copy(m);
+		m.erase(m.lower_bound(100 * round), m.lower_bound(100 * round + 50));
+		os << m.size() << " " << copy.size() << " " << (copy == m) << "\n";
+	}
+	write_pairs(m, os);
+}
+
+typedef NS::map<int, std::string>				snapshot_map;
+
+// Whether a snapshot of m survives the trip through bytes, altered by
+// damage; a rejected one must leave the target as it was.
+std::string snapshot_trip(const snapshot_map& m, std::string (*damage)(const std::string&, int), int arg)
+{
+#ifdef STD
+	(void)m;
+	(void)damage;
+	(void)arg;
+	return (arg < 0 ? "same" : "rejected");
+#else
+	std::ostringstream out;
+	ft::save(out, m);
+	std::istringstream in(damage(out.str(), arg));
+	snapshot_map target;
+	target[-1] = "kept";
+	try {
+		ft::load(in, target);
+	} catch (ft::snapshot_error&) {
+		return (target.size() == 1 && target[-1] == "kept" ? "rejected" : "rejected but changed");
+	}
+	return (target == m ? "same" : "accepted but different");
+#endif
+}
+
+std::string flip_byte(const std::string& bytes, int i)
+{
+	std::string out(bytes);
+	if (i >= 0)
+		out[i % out.size()] ^= 0x20;
+	return (out);
+}
+
+std::string truncate_to(const std::string& bytes, int n)
+{
+	return (bytes.substr(0, n < 0 ? bytes.size() : n));
+}
+
+void test_serialize(std::ofstream& os)
+{
+	unsigned seed = 45;
+	snapshot_map m;
+	for (int i = 0; i < 40; i++)
+		m[next_key(seed, 100)] = std::string(next_key(seed, 12), static_cast<char>('a' + i % 26));
+	os << snapshot_trip(m, flip_byte, -1) << " " << snapshot_trip(snapshot_map(), flip_byte, -1) << "\n";
+	for (int i = 0; i < 600; i += 13)
+		os << snapshot_trip(m, flip_byte, i) << " ";
+	os << "\n";
+	for (int n = 0; n < 600; n += 41)
+		os << snapshot_trip(m, truncate_to, n) << " ";
+	os << "\n";
+	NS::vector<double> v;
+	NS::vector<std::string> words;
+	for (int i = 0; i < 100; i++) {
+		v.push_back(i / 8.0);
+		words.push_back(std::string(i % 7, 'w'));
+	}
+	NS::vector<double> v2;
+	NS::vector<std::string> words2;
+#ifdef STD
+	v2 = v;
+	words2 = words;
+#else
+	std::stringstream io;
+	ft::save(io, v);
+	ft::save(io, words);
+	ft::load(io, v2);
+	ft::load(io, words2);
+#endif
+	os << (v2 == v) << " " << (words2 == words) << " " << v2.size() << " " << words2.back() << "\n";
+}
+
+// Enough keys to split leaves and inner pages through a small cache, then
+// the file is closed and opened again.
+#define DISK_MAP_FILE "disk_map.tmp"
+
+#ifdef STD
+typedef std::map<int, long>						disk_type;
+#else
+typedef ft::disk_map<int, long>					disk_type;
+#endif
+
+void fill_disk_map(disk_type& m)
+{
+	unsigned seed = 46;
+	for (int i = 0; i < 30000; i++) {
+		int k = next_key(seed, 60000);
+		if (i % 4 == 3)
+			m.erase(k);
+		else
+			m.insert(disk_type::value_type(k, i));
+	}
+	m[7] = -7;
+	m.erase(m.lower_bound(1000), m.lower_bound(2000));
+}
+
+void write_disk_map(const disk_type& m, std::ofstream& os)
+{
+	long sum = 0;
+	for (disk_type::const_iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->first ^ it->second;
+	os << m.size() << " " << sum << " " << m.count(7) << "\n";
+	for (int k = 0; k < 60000; k += 997) {
+		disk_type::const_iterator lo = m.lower_bound(k);
+		disk_type::const_iterator hi = m.upper_bound(k);
+		os << (lo == m.end() ? -1 : lo->first) << ":" << (hi == m.end() ? -1 : hi->second) << " ";
+	}
+	os << "\n";
+	int n = 0;
+	for (disk_type::const_reverse_iterator it = m.rbegin(); it != m.rend() && n < 20; ++it, ++n)
+		os << it->first << " ";
+	os << "\n";
+}
+
+void test_disk_map(std::ofstream& os)
+{
+	std::remove(DISK_MAP_FILE);
+#ifdef STD
+	disk_type m;
+	fill_disk_map(m);
+	write_disk_map(m, os);
+	write_disk_map(m, os);
+#else
+	{
+		disk_type m(DISK_MAP_FILE, 8);
+		fill_disk_map(m);
+		write_disk_map(m, os);
+	}
+	disk_type m(DISK_MAP_FILE, 8);
+	write_disk_map(m, os);
+#endif
+	m.clear();
+	os << m.size() << " " << (m.begin() == m.end()) << "\n";
+	std::remove(DISK_MAP_FILE);
+}
+
+// Duplicate keys keep the value already in the map or read first; blank
+// lines are skipped and malformed ones counted. Small chunks and batches
+// make records straddle the chunk boundaries.
+#define LOADER_FILE "loader.tmp"
+
+void write_records(unsigned seed, int lines)
+{
+	std::ofstream file(LOADER_FILE);
+	for (int i = 0; i < lines; i++) {
+		int k = next_key(seed, 2000) - 500;
+		if (i % 97 == 0)
+			file << "\n";
+		else if (i % 89 == 0)
+			file << k << "\n";
+		else if (i % 83 == 0)
+			file << k << " " << i << " " << i << "\n";
+		else if (i % 79 == 0)
+			file << "key" << k << " " << i << "\n";
+		else
+			file << (i % 2 ? "\t" : "") << k << (i % 3 ? " " : " \t ") << i << (i % 5 ? "" : "\r") << "\n";
+	}
+}
+
+#ifdef STD
+template <class Map>
+unsigned long load_into(Map& m)
+{
+	std::ifstream file(LOADER_FILE);
+	std::string line;
+	unsigned long rejected = 0;
+	while (std::getline(file, line)) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+		std::istringstream in(line);
+		typename Map::key_type k;
+		typename Map::mapped_type v;
+		std::string rest;
+		if (in >> k >> v && !(in >> rest))
+			m.insert(typename Map::value_type(k, v));
+		else
+			rejected++;
+	}
+	return (rejected);
+}
+#else
+template <class Map>
+unsigned long load_into(Map& m)
+{
+	ft::load_options options;
+	options.chunk_bytes = 61;
+	options.batch_records = 7;
+	options.queue_depth = 2;
+	return (ft::load_records(LOADER_FILE, m, options).rejected);
+}
+#endif
+
+void test_loader(std::ofstream& os)
+{
+	NS::map<int, int> m;
+	for (int k = -500; k < 1500; k += 7)
+		m[k] = -k;
+	write_records(47, 5000);
+	os << "rejected " << load_into(m) << "\n";
+	write_pairs(m, os);
+	write_records(48, 300);
+	os << "rejected " << load_into(m) << "\n";
+	write_pairs(m, os);
+
+	std::ofstream(LOADER_FILE) << "apple 7\nbanana 3\n\napple 9\n cherry\t-2 \npear\n";
+	NS::map<std::string, long> words;
+	os << "rejected " << load_into(words) << "\n";
+	write_pairs(words, os);
+	std::remove(LOADER_FILE);
+
+	NS::map<int, int> none;
+#ifndef STD
+	try {
+		ft::load_records(LOADER_FILE, none);
+	} catch (std::runtime_error&) {
+		none[0] = 0;
+	}
+#else
+	none[0] = 0;
+#endif
+	write_pairs(none, os);
+}
+
+// Writers keep changing the map while two checkpoints run; each file
+// must restore the map as it was when its checkpoint was taken.
+#define CHECKPOINT_FILE "checkpoint.tmp"
+#define CHECKPOINT_FILE2 "checkpoint2.tmp"
+
+#ifdef STD
+typedef std_concurrent_map						checkpoint_type;
+
+void checkpoint_assign(checkpoint_type& m, int k, int v)
+{
+	m[k] = v;
+}
+#else
+typedef ft::checkpoint_map<int, int>			checkpoint_type;
+
+void checkpoint_assign(checkpoint_type& m, int k, int v)
+{
+	m.insert_or_assign(k, v);
+}
+
+struct checkpoint_note {
+	int													calls;
+	bool												ok;
+	unsigned long long									records;
+};
+
+void note_checkpoint(void* context, const ft::checkpoint_stats& st)
+{
+	checkpoint_note* note = static_cast<checkpoint_note*>(context);
+	note->calls++;
+	note->ok = st.ok;
+	note->records = st.records;
+}
+#endif
+
+void churn_checkpoint(checkpoint_type& m, unsigned& seed, int steps)
+{
+	for (int i = 0; i < steps; i++) {
+		int k = next_key(seed, 4000);
+		if (i % 3 == 0)
+			m.erase(k);
+		else if (i % 3 == 1)
+			m.insert(checkpoint_type::value_type(k, i));
+		else
+			checkpoint_assign(m, k, -i);
+	}
+}
+
+void write_checkpoint(const checkpoint_type& m, std::ofstream& os)
+{
+	long sum = 0;
+	int v;
+	for (int k = 0; k < 4000; k++)
+		if (m.find(k, v))
+			sum += k ^ v;
+	os << m.size() << " " << sum << " " << m.count(3) << "\n";
+}
+
+void test_checkpoint_map(std::ofstream& os)
+{
+	unsigned seed = 48;
+	checkpoint_type m;
+	churn_checkpoint(m, seed, 6000);
+	write_checkpoint(m, os);
+#ifdef STD
+	checkpoint_type first(m);
+	churn_checkpoint(m, seed, 3000);
+	checkpoint_type second(m);
+	m.clear();
+	churn_checkpoint(m, seed, 3000);
+	os << "true 1 " << first.size() << " true 1 " << second.size() << "\n";
+#else
+	checkpoint_note notes[2] = {{0, false, 0}, {0, false, 0}};
+	ft::checkpoint_future f1 = m.checkpoint(CHECKPOINT_FILE, note_checkpoint, &notes[0]);
+	churn_checkpoint(m, seed, 3000);
+	ft::checkpoint_future f2 = m.checkpoint(CHECKPOINT_FILE2, note_checkpoint, &notes[1]);
+	m.clear();
+	churn_checkpoint(m, seed, 3000);
+	const ft::checkpoint_stats& st1 = f1.get();
+	const ft::checkpoint_stats& st2 = f2.get();
+	os << st1.ok << " " << notes[0].calls << " " << notes[0].records << " "
+		<< st2.ok << " " << notes[1].calls << " " << notes[1].records << "\n";
+	checkpoint_type first;
+	checkpoint_type second;
+	first.restore(CHECKPOINT_FILE);
+	second.insert(checkpoint_type::value_type(-1, -1));
+	second.restore(CHECKPOINT_FILE2);
+#endif
+	write_checkpoint(m, os);
+	write_checkpoint(first, os);
+	write_checkpoint(second, os);
+
+	bool kept = true;
+#ifndef STD
+	std::remove(CHECKPOINT_FILE);
+	try {
+		second.restore(CHECKPOINT_FILE);
+		kept = false;
+	} catch (ft::snapshot_error&) {
+	}
+	std::remove(CHECKPOINT_FILE2);
+#endif
+	os << kept << " ";
+	write_checkpoint(second, os);
+}
+
+// Sizes either side of the insertion sort cutoff, the merge run and the
+// radix threshold, and one large enough for the parallel merge sort.
+template <class It>
+unsigned long order_hash(It first, It last)
+{
+	unsigned long h = 0;
+	for (; first != last; ++first)
+		h = h * 31 + static_cast<unsigned long>(static_cast<long>(*first));
+	return (h);
+}
+
+template <class Vec>
+void write_order(const Vec& v, std::ofstream& os)
+{
+	os << v.size() << " " << order_hash(v.begin(), v.end());
+	for (std::size_t i = 0; i < v.size() && i < 8; i++)
+		os << " " << +v[i];
+	os << "\n";
+}
+
+// Compares the key only, so that equal keys show whether the order of
+// their values was kept.
+struct by_first {
+	bool operator()(const NS::pair<int, int>& a, const NS::pair<int, int>& b) const {
+		return (a.first < b.first);
+	}
+};
+
+struct by_length {
+	bool operator()(const std::string& a, const std::string& b) const {
+		return (a.size() < b.size());
+	}
+};
+
+void test_sort(std::ofstream& os)
+{
+	static const int sizes[] = {0, 1, 2, 15, 16, 17, 33, 255, 256, 1000, 40000};
+	unsigned seed = 49;
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		int n = sizes[i];
+		NS::vector<long> longs;
+		NS::vector<unsigned char> bytes;
+		NS::vector<double> doubles;
+		NS::vector<NS::pair<int, int> > pairs;
+		for (int j = 0; j < n; j++) {
+			longs.push_back(static_cast<long>(next_key(seed, 1 << 30)) * (j % 2 ? -4097 : 4099));
+			bytes.push_back(static_cast<unsigned char>(next_key(seed, 256)));
+			doubles.push_back(next_key(seed, 100000) / 7.0 - 5000);
+			pairs.push_back(NS::make_pair(next_key(seed, 50), j));
+		}
+		NS::vector<long> stable(longs);
+		NS::vector<long> partial(longs);
+		NS::vector<long> nth(longs);
+		NS::sort(longs.begin(), longs.end());
+		NS::stable_sort(stable.begin(), stable.end());
+		NS::sort(bytes.begin(), bytes.end());
+		NS::sort(doubles.begin(), doubles.end(), std::greater<double>());
+		NS::stable_sort(pairs.begin(), pairs.end(), by_first());
+		write_order(longs, os);
+		os << (stable == longs) << " ";
+		write_order(bytes, os);
+		write_order(doubles, os);
+		unsigned long h = 0;
+		for (std::size_t j = 0; j < pairs.size(); j++)
+			h = h * 31 + static_cast<unsigned long>(pairs[j].first * 65536 + pairs[j].second);
+		os << h << "\n";
+		std::size_t middle = n / 3;
+		NS::partial_sort(partial.begin(), partial.begin() + middle, partial.end());
+		os << NS::equal(partial.begin(), partial.begin() + middle, longs.begin()) << " ";
+		if (n > 0) {
+			NS::nth_element(nth.begin(), nth.begin() + middle, nth.end());
+			bool split = true;
+			for (std::size_t j = 0; j < nth.size(); j++)
+				if ((j < middle && nth[middle] < nth[j]) || (j > middle && nth[j] < nth[middle]))
+					split = false;
+			os << nth[middle] << " " << split;
+		}
+		os << "\n";
+	}
+
+	NS::vector<long> big;
+	NS::vector<long> big_stable;
+	for (int j = 0; j < 200000; j++)
+		big.push_back(next_key(seed, 1 << 30) - (1 << 29));
+	NS::vector<long> expect(big);
+	NS::sort(expect.begin(), expect.end());
+	big_stable = big;
+#ifdef STD
+	std::sort(big.begin(), big.end(), std::greater<long>());
+	std::stable_sort(big_stable.begin(), big_stable.end());
+#else
+	ft::parallel::sort(big.begin(), big.end(), std::greater<long>(), harness_pool());
+	ft::parallel::stable_sort(big_stable.begin(), big_stable.end(), harness_pool());
+#endif
+	os << NS::equal(big.rbegin(), big.rend(), expect.begin()) << " "
+		<< (big_stable == expect) << " " << order_hash(big.begin(), big.end()) << "\n";
+
+	NS::vector<std::string> words;
+	for (int j = 0; j < 300; j++)
+		words.push_back(std::string(next_key(seed, 9), static_cast<char>('a' + j % 26)));
+	NS::vector<std::string> sorted(words);
+	NS::sort(sorted.begin(), sorted.end());
+	NS::stable_sort(words.begin(), words.end(), by_length());
+	for (std::size_t j = 0; j < words.size(); j += 17)
+		os << sorted[j] << ":" << words[j] << " ";
+	os << "\n";
+}
+
+// Runs of equal keys, searches below, inside and past the range, and
+// element types of every width the line search counts over.
+template <class Vec>
+void write_bounds(const Vec& v, typename Vec::value_type value, std::ofstream& os)
+{
+	typedef typename Vec::const_iterator				const_iterator;
+	const_iterator lo = NS::lower_bound(v.begin(), v.end(), value);
+	const_iterator hi = NS::upper_bound(v.begin(), v.end(), value);
+	NS::pair<const_iterator, const_iterator> range = NS::equal_range(v.begin(), v.end(), value);
+	os << (lo - v.begin()) << "," << (hi - v.begin()) << ","
+		<< (range.first == lo && range.second == hi) << ","
+		<< NS::binary_search(v.begin(), v.end(), value) << " ";
+}
+
+template <class T>
+void run_searches(unsigned seed, int n, std::ofstream& os)
+{
+	NS::vector<T> v;
+	for (int i = 0; i < n; i++)
+		v.push_back(static_cast<T>(next_key(seed, 3 * n + 1) / 3));
+	NS::sort(v.begin(), v.end());
+	for (int q = -2; q <= n + 2; q += 1 + n / 40)
+		write_bounds(v, static_cast<T>(q), os);
+	os << "\n";
+}
+
+void test_search(std::ofstream& os)
+{
+	static const int sizes[] = {0, 1, 2, 7, 64, 65, 1000, 5000};
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		run_searches<char>(50, sizes[i] % 120, os);
+		run_searches<short>(51, sizes[i], os);
+		run_searches<int>(52, sizes[i], os);
+		run_searches<long>(53, sizes[i], os);
+		run_searches<double>(54, sizes[i], os);
+	}
+
+	unsigned seed = 55;
+	NS::vector<int> down;
+	for (int i = 0; i < 3000; i++)
+		down.push_back(next_key(seed, 2000));
+	NS::sort(down.begin(), down.end(), std::greater<int>());
+	for (int q = -1; q < 2001; q += 37)
+		os << (NS::lower_bound(down.begin(), down.end(), q, std::greater<int>()) - down.begin()) << ":"
+			<< (NS::upper_bound(down.begin(), down.end(), q, std::greater<int>()) - down.begin()) << ":"
+			<< NS::binary_search(down.begin(), down.end(), q, std::greater<int>()) << " ";
+	os << "\n";
+
+	NS::vector<std::string> words;
+	for (int i = 0; i < 200; i++)
+		words.push_back(std::string(1 + i % 5, static_cast<char>('a' + next_key(seed, 26))));
+	NS::sort(words.begin(), words.end());
+	const char* probes[] = {"", "a", "bb", "m", "mmmmm", "zz", "zzzzzz"};
+	for (std::size_t i = 0; i < sizeof(probes) / sizeof(*probes); i++)
+		write_bounds(words, probes[i], os);
+	os << "\n";
+
+	NS::vector<int> sorted(down.rbegin(), down.rend());
+	NS::vector<int> queries;
+	for (int q = -5; q < 2100; q += 1 + next_key(seed, 60))
+		queries.push_back(q);
+	queries.push_back(2100);
+	queries.push_back(2100);
+	NS::vector<NS::vector<int>::const_iterator> found(queries.size());
+	const NS::vector<int>& view = sorted;
+#ifdef STD
+	for (std::size_t i = 0; i < queries.size(); i++)
+		found[i] = std::lower_bound(view.begin(), view.end(), queries[i]);
+#else
+	ft::lower_bound_many(view.begin(), view.end(), queries.begin(), queries.end(), found.begin());
+#endif
+	for (std::size_t i = 0; i < found.size(); i++)
+		os << (found[i] - view.begin()) << " ";
+	os << "\n";
+}
+
+void test_extensions()
+{
+	size_t start = time_now();
+	std::ofstream os;
+	os.open(FILEMAP, std::ios::app);
+	os << std::boolalpha;
+	test_flat_map(os);
+	test_frozen_map(os);
+	test_find_batch(os);
+	test_persistent_map(os);
+	test_concurrent_map(os);
+	test_sharded_map(os);
+	test_balance_policies(os);
+	test_adaptive_map(os);
+	test_intrusive_rbtree(os);
+	test_node_handles(os);
+	test_insert_or_assign(os);
+	test_erase_if(os);
+	test_finger_search(os);
+	test_radix_map(os);
+	test_string_radix_map(os);
+	test_filtered_map(os);
+	test_parallel(os);
+	test_iteration(os);
+	test_compact(os);
+	test_serialize(os);
+	test_disk_map(os);
+	test_loader(os);
+	test_checkpoint_map(os);
+	test_sort(os);
+	test_search(os);
+	std::cout << PRINTNS << "::extensions time: " << (time_now() - start) << std::endl;
+}
+
 int main(void)
 {
 	NS::test_vector();
 	NS::test_map();
+	test_extensions();
 
 	return 0;
 }
\ No newline at end of file
@@ -4,20 +4,33 @@
 #include <functional>
 #include <memory>
 
+#include "./node_handle.hpp"
 #include "./rb_tree.hpp"
 #include "./utility.hpp"
 
 namespace ft {
 #define CONTAINER Container<ft::pair<const Key, T>, Alloc>
-template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> >,
+		class Balance = rb_balance>
 class map : public CONTAINER {
 	template <typename P>
 	struct FirstOfPair {
-		Key operator()(const P& x) const {
+		const Key& operator()(const P& x) const {
 			return (x.first);
 		}
 	};
 
+	template <typename Predicate>
+	struct _negate {
+		Predicate pred;
+
+		explicit _negate(Predicate p) : pred(p) {}
+
+		bool operator()(const ft::pair<const Key, T>& x) {
+			return (!pred(x));
+		}
+	};
+
  public:
 	IMPORT_TYPE(value_type);
 	IMPORT_TYPE(reference);
@@ -32,7 +45,7 @@ class map : public CONTAINER {
  * 							MEMBER CLASS			 						   *
  \*****************************************************************************/
 	class value_compare : public std::binary_function<value_type, value_type, bool> {
-		friend class map<Key, T, Compare, Alloc>;
+		friend class map<Key, T, Compare, Alloc, Balance>;
 
 	 protected:
 		Compare comp;
@@ -46,8 +59,9 @@ class map : public CONTAINER {
 	};
 
  private:
-	typedef Rb_tree<key_type, value_type, FirstOfPair<value_type>, key_compare, Alloc>
+	typedef Rb_tree<key_type, value_type, FirstOfPair<value_type>, key_compare, Alloc, Balance>
 															Tree_struct;
+	typedef typename Tree_struct::Node_ptr					Node_ptr;
 	Tree_struct												_rbtree;
 
  public:
@@ -58,6 +72,13 @@ class map : public CONTAINER {
 	typedef typename Tree_struct::const_reverse_iterator	const_reverse_iterator;
 	typedef typename Tree_struct::size_type					size_type;
 	typedef typename Tree_struct::difference_type			difference_type;
+	typedef ft::node_handle<Key, T, allocator_type>			node_type;
+
+	struct insert_return_type {
+		iterator											position;
+		bool												inserted;
+		node_type											node;
+	};
 
  /*****************************************************************************\
  * 					CONSTRUCTORS / DESTRUCTOR								   *
@@ -101,8 +122,7 @@ class map : public CONTAINER {
 	};
 
 	mapped_type& operator[](const key_type& k) {
-		iterator x = insert(begin(), ft::make_pair(k, mapped_type()));
-		return (x->second);
+		return (try_emplace(k).first->second);
 	};
 
  /*****************************************************************************\
@@ -162,24 +182,47 @@ class map : public CONTAINER {
  \*****************************************************************************/
 
 	ft::pair<iterator, bool> insert(const value_type& val) {
-		iterator x = find(val.first);
-		if (x != end()) {
-			return (ft::make_pair(x, false));
-		} else {
-			iterator y = _rbtree.insert_unique(val);
-			return (ft::make_pair(y, true));
-		}
+		return (_rbtree.try_insert(val));
 	};
 
+	// Searches outward from position: O(log d) for d keys between it and
+	// val, so inserting next to the previous insert is cheap.
 	iterator insert(iterator position, const value_type& val) {
-		iterator x = find(val.first);
-		if (x != end()) {
-			return (x);
-		} else {
-			_rbtree.insert(val, position.base());
-			iterator y = find(val.first);
-			return (y);
+		return (_rbtree.try_insert(val, position.base()).first);
+	};
+
+	// One descent either way: an existing mapped value is assigned in
+	// place, and only a new key allocates a node.
+	template <class M>
+	ft::pair<iterator, bool> insert_or_assign(const key_type& k, const M& obj) {
+		Node_ptr parent;
+		bool left;
+		Node_ptr x = _rbtree.find_or_parent(k, parent, left);
+		if (x != end().base()) {
+			x->data.second = obj;
+			return (ft::make_pair(iterator(x), false));
 		}
+		return (ft::make_pair(_rbtree.insert_at(parent, left, value_type(k, obj)), true));
+	};
+
+	// The mapped value is only built when k is new.
+	ft::pair<iterator, bool> try_emplace(const key_type& k) {
+		Node_ptr parent;
+		bool left;
+		Node_ptr x = _rbtree.find_or_parent(k, parent, left);
+		if (x != end().base())
+			return (ft::make_pair(iterator(x), false));
+		return (ft::make_pair(_rbtree.insert_at(parent, left, value_type(k, mapped_type())), true));
+	};
+
+	template <class Arg>
+	ft::pair<iterator, bool> try_emplace(const key_type& k, const Arg& arg) {
+		Node_ptr parent;
+		bool left;
+		Node_ptr x = _rbtree.find_or_parent(k, parent, left);
+		if (x != end().base())
+			return (ft::make_pair(iterator(x), false));
+		return (ft::make_pair(_rbtree.insert_at(parent, left, value_type(k, mapped_type(arg))), true));
 	};
 
 	template <class InputIterator>
@@ -190,6 +233,24 @@ class map : public CONTAINER {
 		}
 	};
 
+	// Links an extracted node. On a duplicate key the node comes back in
+	// the result, together with the element that blocked it.
+	insert_return_type insert(node_type nh) {
+		insert_return_type res;
+		res.inserted = false;
+		if (nh.empty()) {
+			res.position = end();
+			return (res);
+		}
+		typename node_type::Node_ptr z = nh.release();
+		ft::pair<iterator, bool> x = _rbtree.insert_node(z);
+		res.position = x.first;
+		res.inserted = x.second;
+		if (!x.second)
+			res.node = node_type(z, get_allocator());
+		return (res);
+	};
+
 	void erase(iterator position) {
 		_rbtree.erase(position->first);
 	};
@@ -211,6 +272,51 @@ class map : public CONTAINER {
 		}
 	};
 
+	// Keeps exactly the elements for which pred holds.
+	template <class Predicate>
+	size_type retain(Predicate pred) {
+		return (_rbtree.erase_if(_negate<Predicate>(pred)));
+	};
+
+	// Replaces the contents; sorted, duplicate-free input is built in O(n)
+	// instead of n inserts.
+	template <class InputIterator>
+	void assign_sorted(InputIterator first, InputIterator last) {
+		_rbtree.assign_sorted(first, last);
+	};
+
+	// Relocates the nodes into one block in key order, for faster scans
+	// after heavy churn; invalidates every iterator but end().
+	void compact(void) {
+		_rbtree.compact();
+	};
+
+	node_type extract(iterator position) {
+		return (node_type(_rbtree.extract(position.base()), get_allocator()));
+	};
+
+	node_type extract(const key_type& k) {
+		iterator x = find(k);
+		if (x == end())
+			return (node_type());
+		return (extract(x));
+	};
+
+	// Moves [first, last) of source into this map without copying; entries
+	// whose key is already here stay in source.
+	void splice(map& source, iterator first, iterator last) {
+		_rbtree.splice(source._rbtree, first.base(), last.base());
+	};
+
+	void splice(map& source, iterator position) {
+		iterator next = position;
+		splice(source, position, ++next);
+	};
+
+	void merge(map& source) {
+		splice(source, source.begin(), source.end());
+	};
+
 	void swap(map& x) {
 		_rbtree.swap(x._rbtree);
 	};
@@ -251,6 +357,52 @@ class map : public CONTAINER {
 		return (_rbtree.upper_bound(k));
 	};
 
+	// Searches outward from hint, an iterator into this map: O(log d) when
+	// k lies d elements away from it.
+	iterator find(const key_type& k, const_iterator hint) {
+		return (iterator(_rbtree.find(k, hint.base())));
+	};
+
+	const_iterator find(const key_type& k, const_iterator hint) const {
+		return (const_iterator(_rbtree.find(k, hint.base())));
+	};
+
+	iterator lower_bound(const key_type& k, const_iterator hint) {
+		return (iterator(_rbtree.lower_bound(k, hint.base())));
+	};
+
+	const_iterator lower_bound(const key_type& k, const_iterator hint) const {
+		return (const_iterator(_rbtree.lower_bound(k, hint.base())));
+	};
+
+	// Off by default: find() and lower_bound() then remember where they
+	// landed and start the next search there.
+	void finger_cache(bool on) {
+		_rbtree.finger_cache(on);
+	};
+
+	bool finger_cache(void) const {
+		return (_rbtree.finger_cache());
+	};
+
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+		return (_rbtree.find_batch(first, last, out));
+	};
+
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+		return (_rbtree.find_batch(first, last, out));
+	};
+
+	// Copies the elements with keys in [lo, hi) to out, in order.
+	template <class OutputIterator>
+	OutputIterator range_scan(const key_type& lo, const key_type& hi, OutputIterator out) const {
+		if (!key_comp()(lo, hi))
+			return (out);
+		return (_rbtree.scan(lower_bound(lo).base(), lower_bound(hi).base(), out));
+	};
+
 	ft::pair<iterator, iterator> equal_range(const key_type& k) {
 		return (ft::make_pair(lower_bound(k), upper_bound(k)));
 	};
@@ -275,54 +427,71 @@ class map : public CONTAINER {
 		return (value_compare(_rbtree.key_comp()));
 	};
 
-	template <typename K1, typename T1, typename C1, typename A1>
+	// The root node, end().base() when empty: for walks that split the
+	// tree into subtrees instead of following iterators.
+	Node_ptr root(void) const {
+		return (_rbtree.getroot());
+	};
+
+	template <typename K1, typename T1, typename C1, typename A1, typename B1, typename P1>
+	friend typename map<K1, T1, C1, A1, B1>::size_type
+	erase_if(map<K1, T1, C1, A1, B1>&, P1);
+
+	template <typename K1, typename T1, typename C1, typename A1, typename B1>
 	friend bool
-	operator==(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+	operator==(const map<K1, T1, C1, A1, B1>&, const map<K1, T1, C1, A1, B1>&);
 
-	template <typename K1, typename T1, typename C1, typename A1>
+	template <typename K1, typename T1, typename C1, typename A1, typename B1>
 	friend bool
-	operator<(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+	operator<(const map<K1, T1, C1, A1, B1>&, const map<K1, T1, C1, A1, B1>&);
 };
 #undef CONTAINER
 
-template <class Key, class T, class Compare, class Alloc>
-void swap(map<Key, T, Compare, Alloc>& lhs, map<Key, T, Compare, Alloc>& rhs) {
+// Removes every element for which pred holds, in one pass over the tree.
+template <class Key, class T, class Compare, class Alloc, class Balance, class Predicate>
+typename map<Key, T, Compare, Alloc, Balance>::size_type
+erase_if(map<Key, T, Compare, Alloc, Balance>& m, Predicate pred) {
+	return (m._rbtree.erase_if(pred));
+}
+
+template <class Key, class T, class Compare, class Alloc, class Balance>
+void swap(map<Key, T, Compare, Alloc, Balance>& lhs, map<Key, T, Compare, Alloc, Balance>& rhs) {
 	lhs.swap(rhs);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator==(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator==(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (lhs._rbtree == rhs._rbtree);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator!=(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator!=(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (!(lhs == rhs));
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator<(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator<(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (lhs._rbtree < rhs._rbtree);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator<=(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator<=(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (!(rhs < lhs));
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator>(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator>(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (rhs < lhs);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator>=(const map<Key, T, Compare, Alloc>& lhs,
-				const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class Balance>
+bool operator>=(const map<Key, T, Compare, Alloc, Balance>& lhs,
+				const map<Key, T, Compare, Alloc, Balance>& rhs) {
 	return (!(lhs < rhs));
 }
 
@@ -0,0 +1,124 @@
+#ifndef MERGE_ITERATOR_H
+#define MERGE_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+#include "./iterator_traits.hpp"
+
+namespace ft {
+
+/*
+		K-way merge of up to N sorted ranges. The ranges are kept in a
+		binary min-heap keyed on their current element, so each step costs
+		O(log N) comparisons. Ranges are assumed to hold disjoint keys.
+*/
+template <typename Iter, typename Compare, std::size_t N>
+class merge_iterator : public iterator<std::forward_iterator_tag,
+										typename iterator_traits<Iter>::value_type> {
+ public:
+	typedef std::forward_iterator_tag						iterator_category;
+	typedef typename iterator_traits<Iter>::value_type		value_type;
+	typedef typename iterator_traits<Iter>::difference_type	difference_type;
+	typedef typename iterator_traits<Iter>::pointer			pointer;
+	typedef typename iterator_traits<Iter>::reference		reference;
+
+ protected:
+	Iter													cur[N];
+	Iter													last[N];
+	std::size_t												heap[N];
+	std::size_t												count;
+	Compare													comp;
+
+ public:
+	merge_iterator(void) : count(0), comp() {}
+
+	merge_iterator(const Iter* first, const Iter* _last, const Compare& _comp = Compare())
+		: count(0), comp(_comp) {
+		for (std::size_t i = 0; i < N; i++) {
+			cur[i] = first[i];
+			last[i] = _last[i];
+			if (cur[i] != last[i])
+				heap[count++] = i;
+		}
+		for (std::size_t i = count / 2; i-- > 0; )
+			sift_down(i);
+	}
+
+	~merge_iterator(void) {}
+
+	// The range that currently supplies the front element.
+	std::size_t source(void) const {
+		return (heap[0]);
+	}
+
+	Iter base(void) const {
+		return (cur[heap[0]]);
+	}
+
+	bool at_end(void) const {
+		return (count == 0);
+	}
+
+	reference operator*(void) const {
+		return (*cur[heap[0]]);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	merge_iterator& operator++(void) {
+		std::size_t top = heap[0];
+		if (++cur[top] == last[top])
+			heap[0] = heap[--count];
+		sift_down(0);
+		return (*this);
+	}
+
+	merge_iterator operator++(int) {
+		merge_iterator tmp(*this);
+		++(*this);
+		return (tmp);
+	}
+
+ private:
+	bool less(std::size_t a, std::size_t b) const {
+		return (comp(*cur[a], *cur[b]));
+	}
+
+	void sift_down(std::size_t i) {
+		while (true) {
+			std::size_t min = i;
+			std::size_t l = 2 * i + 1;
+			if (l < count && less(heap[l], heap[min]))
+				min = l;
+			if (l + 1 < count && less(heap[l + 1], heap[min]))
+				min = l + 1;
+			if (min == i)
+				return;
+			std::size_t tmp = heap[i];
+			heap[i] = heap[min];
+			heap[min] = tmp;
+			i = min;
+		}
+	}
+};
+
+template <typename Iter, typename Compare, std::size_t N>
+inline bool operator==(const merge_iterator<Iter, Compare, N>& lhs,
+						const merge_iterator<Iter, Compare, N>& rhs) {
+	if (lhs.at_end() || rhs.at_end())
+		return (lhs.at_end() == rhs.at_end());
+	return (lhs.base() == rhs.base());
+}
+
+template <typename Iter, typename Compare, std::size_t N>
+inline bool operator!=(const merge_iterator<Iter, Compare, N>& lhs,
+						const merge_iterator<Iter, Compare, N>& rhs) {
+	return (!(lhs == rhs));
+}
+
+}
+
+#endif
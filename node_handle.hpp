@@ -0,0 +1,101 @@
+#ifndef NODE_HANDLE_H
+#define NODE_HANDLE_H
+
+#include <cstddef>
+
+#include "./RBT_Node.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*
+		Owns a map node that has been unlinked from its tree. Without move
+		semantics, copying a handle transfers the node, as std::auto_ptr
+		does: the source is left empty.
+*/
+template <typename Key, typename T, typename NodeAlloc>
+class node_handle {
+ public:
+	typedef Key									key_type;
+	typedef T									mapped_type;
+	typedef ft::pair<const Key, T>				value_type;
+	typedef NodeAlloc							allocator_type;
+	typedef RBT_Node<value_type>*				Node_ptr;
+
+ private:
+	mutable Node_ptr							_node;
+	allocator_type								_alloc;
+
+ public:
+	node_handle(void) : _node(NULL), _alloc() {}
+
+	node_handle(Node_ptr node, const allocator_type& alloc) : _node(node), _alloc(alloc) {}
+
+	node_handle(const node_handle& x) : _node(x._node), _alloc(x._alloc) {
+		x._node = NULL;
+	}
+
+	~node_handle(void) {
+		_destroy();
+	}
+
+	node_handle& operator=(const node_handle& x) {
+		if (this != &x) {
+			_destroy();
+			_node = x._node;
+			_alloc = x._alloc;
+			x._node = NULL;
+		}
+		return (*this);
+	}
+
+	bool empty(void) const {
+		return (_node == NULL);
+	}
+
+	const key_type& key(void) const {
+		return (_node->data.first);
+	}
+
+	mapped_type& mapped(void) const {
+		return (_node->data.second);
+	}
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	}
+
+	// Gives the node back to a tree; the handle is left empty.
+	Node_ptr release(void) {
+		Node_ptr node = _node;
+		_node = NULL;
+		return (node);
+	}
+
+	void swap(node_handle& x) {
+		Node_ptr node = _node;
+		_node = x._node;
+		x._node = node;
+		allocator_type alloc = _alloc;
+		_alloc = x._alloc;
+		x._alloc = alloc;
+	}
+
+ private:
+	void _destroy(void) {
+		if (_node != NULL) {
+			_alloc.destroy(_node);
+			_alloc.deallocate(_node, 1);
+			_node = NULL;
+		}
+	}
+};
+
+template <typename Key, typename T, typename NodeAlloc>
+void swap(node_handle<Key, T, NodeAlloc>& lhs, node_handle<Key, T, NodeAlloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
@@ -0,0 +1,557 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "./RBT_Node.hpp"
+#include "./algorithm.hpp"
+#include "./iterator_traits.hpp"
+#include "./thread.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+namespace parallel {
+
+/*
+		A fixed set of workers that run the tasks of one job at a time. The
+		tasks are numbered 0 .. n - 1 and dealt out in contiguous runs, one
+		run per participant (the workers and the caller). Each takes tasks
+		from the front of its own run; once that is empty it steals from
+		the back of someone else's, so a slow run is finished by whoever is
+		idle. Tasks must not throw. Calls from different threads take turns;
+		a task that calls back into the pool runs the inner call itself.
+*/
+class work_stealing_pool {
+ public:
+	typedef std::size_t									size_type;
+
+ private:
+	enum { CACHE_LINE = 64 };
+
+	struct job {
+		virtual ~job(void) {}
+		virtual void operator()(size_type task) = 0;
+	};
+
+	template <typename Body>
+	struct job_of : job {
+		Body&											body;
+
+		explicit job_of(Body& _body) : body(_body) {}
+
+		void operator()(size_type task) {
+			body(task);
+		}
+	};
+
+	// The tasks [first, last) not yet taken.
+	struct run {
+		spin_lock										lock;
+		size_type										first;
+		size_type										last;
+		char											pad[CACHE_LINE];
+
+		run(void) : lock(), first(0), last(0) {}
+	};
+
+	struct worker {
+		work_stealing_pool*								pool;
+		unsigned										index;
+
+		void operator()(void) {
+			pool->_serve(index);
+		}
+	};
+
+	unsigned											_size;
+	run*												_runs;
+	worker*												_workers;
+	thread*												_threads;
+	job*												_job;
+	unsigned											_generation;
+	unsigned											_pending;
+	bool												_stop;
+	mutex												_call;
+	thread_specific										_inside;
+	mutex												_mutex;
+	condition											_start;
+	condition											_done;
+
+	work_stealing_pool(const work_stealing_pool&);
+	work_stealing_pool& operator=(const work_stealing_pool&);
+
+ public:
+	// threads counts the caller, which works during run(); 0 means one per
+	// processor.
+	explicit work_stealing_pool(unsigned threads = 0)
+		: _size(threads ? threads : thread::hardware_concurrency()), _runs(NULL), _workers(NULL),
+		_threads(NULL), _job(NULL), _generation(0), _pending(0), _stop(false) {
+		_runs = new run[_size];
+		_workers = new worker[_size];
+		_threads = new thread[_size];
+		for (unsigned i = 1; i < _size; i++) {
+			_workers[i].pool = this;
+			_workers[i].index = i;
+			_threads[i].start(&_workers[i]);
+		}
+	}
+
+	~work_stealing_pool(void) {
+		_mutex.lock();
+		_stop = true;
+		_start.notify_all();
+		_mutex.unlock();
+		delete[] _threads;
+		delete[] _workers;
+		delete[] _runs;
+	}
+
+	unsigned size(void) const {
+		return (_size);
+	}
+
+	// Calls body(i) once for every i in [0, tasks) and returns when all
+	// calls have.
+	template <typename Body>
+	void operator()(Body& body, size_type tasks) {
+		job_of<Body> j(body);
+		if (_size == 1 || tasks < 2 || _inside.get() != NULL) {
+			for (size_type i = 0; i < tasks; i++)
+				j(i);
+			return;
+		}
+		scoped_lock<mutex> call(_call);
+		_mutex.lock();
+		for (unsigned i = 0; i < _size; i++) {
+			_runs[i].first = tasks * i / _size;
+			_runs[i].last = tasks * (i + 1) / _size;
+		}
+		_job = &j;
+		_pending = _size - 1;
+		_generation++;
+		_start.notify_all();
+		_mutex.unlock();
+		_inside.set(this);
+		_work(0);
+		_inside.set(NULL);
+		_mutex.lock();
+		while (_pending != 0)
+			_done.wait(_mutex);
+		_job = NULL;
+		_mutex.unlock();
+	}
+
+ private:
+	void _serve(unsigned index) {
+		unsigned seen = 0;
+		_inside.set(this);
+		for (;;) {
+			_mutex.lock();
+			while (_generation == seen && !_stop)
+				_start.wait(_mutex);
+			if (_stop) {
+				_mutex.unlock();
+				return;
+			}
+			seen = _generation;
+			_mutex.unlock();
+			_work(index);
+			_mutex.lock();
+			if (--_pending == 0)
+				_done.notify_one();
+			_mutex.unlock();
+		}
+	}
+
+	void _work(unsigned index) {
+		size_type task;
+		for (;;) {
+			if (_take_front(_runs[index], task)) {
+				(*_job)(task);
+				continue;
+			}
+			bool stolen = false;
+			for (unsigned k = 1; k < _size && !stolen; k++)
+				stolen = _take_back(_runs[(index + k) % _size], task);
+			if (!stolen)
+				return;
+			(*_job)(task);
+		}
+	}
+
+	static bool _take_front(run& r, size_type& task) {
+		scoped_lock<spin_lock> guard(r.lock);
+		if (r.first == r.last)
+			return (false);
+		task = r.first++;
+		return (true);
+	}
+
+	static bool _take_back(run& r, size_type& task) {
+		scoped_lock<spin_lock> guard(r.lock);
+		if (r.first == r.last)
+			return (false);
+		task = --r.last;
+		return (true);
+	}
+};
+
+// One worker per processor, started on first use.
+inline work_stealing_pool& default_pool(void) {
+	static work_stealing_pool pool;
+	return (pool);
+}
+
+template <typename V>
+RBT_Node<V>* tree_minimum(RBT_Node<V>* x) {
+	return (RBT_Node<V>::minimum(x));
+}
+
+template <typename V>
+RBT_Node<V>* tree_maximum(RBT_Node<V>* x) {
+	return (RBT_Node<V>::maximum(x));
+}
+
+template <typename V>
+RBT_Node<V>* tree_successor(RBT_Node<V>* x) {
+	return (RBT_Node<V>::successor(x));
+}
+
+// An in-order run of tree nodes, both ends included.
+template <typename Node_ptr>
+struct tree_range {
+	Node_ptr											first;
+	Node_ptr											last;
+};
+
+// Cuts the subtree at x into in-order ranges: whole subtrees depth levels
+// down, each node above them joined to the range on its left.
+template <typename Node_ptr>
+void split_tree(Node_ptr x, unsigned depth, ft::vector<tree_range<Node_ptr> >& out) {
+	if (x == x->leaf)
+		return;
+	if (depth == 0) {
+		tree_range<Node_ptr> r;
+		r.first = tree_minimum(x);
+		r.last = tree_maximum(x);
+		out.push_back(r);
+		return;
+	}
+	split_tree(x->left, depth - 1, out);
+	if (out.empty()) {
+		tree_range<Node_ptr> r;
+		r.first = x;
+		r.last = x;
+		out.push_back(r);
+	} else {
+		out.back().last = x;
+	}
+	split_tree(x->right, depth - 1, out);
+}
+
+// Ranges of about a map's tree, in key order: several per worker so that
+// stealing can even out subtrees of unequal size.
+template <typename Map>
+ft::vector<tree_range<typename Map::const_iterator::Node_ptr> >
+split_map(const Map& m, work_stealing_pool& pool) {
+	typedef typename Map::const_iterator::Node_ptr		Node_ptr;
+	ft::vector<tree_range<Node_ptr> > out;
+	unsigned depth = 0;
+	while ((1u << depth) < pool.size() * 8)
+		depth++;
+	if (m.size() != 0)
+		split_tree(m.root(), depth, out);
+	return (out);
+}
+
+template <typename Node_ptr, typename Function>
+struct for_each_body {
+	const ft::vector<tree_range<Node_ptr> >&			ranges;
+	Function&											f;
+
+	for_each_body(const ft::vector<tree_range<Node_ptr> >& _ranges, Function& _f)
+		: ranges(_ranges), f(_f) {}
+
+	void operator()(std::size_t i) {
+		for (Node_ptr x = ranges[i].first; ; x = tree_successor(x)) {
+			f(x->data);
+			if (x == ranges[i].last)
+				break;
+		}
+	}
+};
+
+template <typename Node_ptr, typename T, typename BinaryOp, typename UnaryOp>
+struct reduce_body {
+	const ft::vector<tree_range<Node_ptr> >&			ranges;
+	ft::vector<T>&										partial;
+	BinaryOp&											op;
+	UnaryOp&											transform;
+
+	reduce_body(const ft::vector<tree_range<Node_ptr> >& _ranges, ft::vector<T>& _partial,
+				BinaryOp& _op, UnaryOp& _transform)
+		: ranges(_ranges), partial(_partial), op(_op), transform(_transform) {}
+
+	void operator()(std::size_t i) {
+		Node_ptr x = ranges[i].first;
+		T acc = transform(x->data);
+		while (x != ranges[i].last) {
+			x = tree_successor(x);
+			acc = op(acc, transform(x->data));
+		}
+		partial[i] = acc;
+	}
+};
+
+template <typename Value>
+struct mapped_value {
+	typename Value::second_type operator()(const Value& v) const {
+		return (v.second);
+	}
+};
+
+/*****************************************************************************\
+* 							ALGORITHMS			 							   *
+\*****************************************************************************/
+
+// Calls f on every element of m, concurrently and in no set order; f may
+// change mapped values but nothing in m's structure.
+template <typename Map, typename Function>
+void for_each(Map& m, Function f, work_stealing_pool& pool = default_pool()) {
+	typedef typename Map::const_iterator::Node_ptr		Node_ptr;
+	ft::vector<tree_range<Node_ptr> > ranges = split_map(m, pool);
+	for_each_body<Node_ptr, Function> body(ranges, f);
+	pool(body, ranges.size());
+}
+
+// init op t(e0) op t(e1) ... in key order, for an associative op: each
+// range is folded on its own and the partial results are combined in
+// order, so op need not be commutative.
+template <typename Map, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(const Map& m, T init, BinaryOp op, UnaryOp transform,
+			work_stealing_pool& pool = default_pool()) {
+	typedef typename Map::const_iterator::Node_ptr		Node_ptr;
+	ft::vector<tree_range<Node_ptr> > ranges = split_map(m, pool);
+	if (ranges.empty())
+		return (init);
+	ft::vector<T> partial(ranges.size(), init);
+	reduce_body<Node_ptr, T, BinaryOp, UnaryOp> body(ranges, partial, op, transform);
+	pool(body, ranges.size());
+	for (std::size_t i = 0; i < partial.size(); i++)
+		init = op(init, partial[i]);
+	return (init);
+}
+
+// Folds op over the mapped values of m, in key order.
+template <typename Map, typename T, typename BinaryOp>
+T reduce(const Map& m, T init, BinaryOp op, work_stealing_pool& pool = default_pool()) {
+	return (transform_reduce(m, init, op, mapped_value<typename Map::value_type>(), pool));
+}
+
+/*****************************************************************************\
+* 							SORTING				 							   *
+\*****************************************************************************/
+
+/*
+		Parallel merge sort: the range is cut into a few pieces per worker,
+		each sorted on its own with ft::sort or ft::stable_sort, and pairs
+		of sorted runs are then merged through a buffer until one is left.
+		Every merge is cut at the points where its output crosses a
+		multiple of the grain, found by a binary search on both runs, so
+		the last merges are as parallel as the first. Ties go to the left
+		run, so the stable variant stays stable. comp must not throw.
+*/
+
+struct merge_sort_tuning {
+	enum {
+		MIN_SIZE = 1 << 15,
+		GRAIN = 1 << 13
+	};
+};
+
+struct merge_task {
+	std::size_t											a;
+	std::size_t											a_end;
+	std::size_t											b;
+	std::size_t											b_end;
+	std::size_t											out;
+};
+
+template <typename It, typename PieceSort>
+struct sort_pieces_body {
+	It													first;
+	const ft::vector<std::size_t>&						bounds;
+	PieceSort&											piece;
+
+	sort_pieces_body(It _first, const ft::vector<std::size_t>& _bounds, PieceSort& _piece)
+		: first(_first), bounds(_bounds), piece(_piece) {}
+
+	void operator()(std::size_t i) {
+		piece(first + bounds[i], first + bounds[i + 1]);
+	}
+};
+
+template <typename Src, typename Dst, typename Compare>
+struct merge_body {
+	Src													src;
+	Dst													dst;
+	const ft::vector<merge_task>&						tasks;
+	Compare&											comp;
+
+	merge_body(Src _src, Dst _dst, const ft::vector<merge_task>& _tasks, Compare& _comp)
+		: src(_src), dst(_dst), tasks(_tasks), comp(_comp) {}
+
+	void operator()(std::size_t i) {
+		const merge_task& t = tasks[i];
+		sort_merge(src + t.a, src + t.a_end, src + t.b, src + t.b_end, dst + t.out, comp);
+	}
+};
+
+// How many of the first d elements of the stable merge of a[0, na) and
+// b[0, nb) come from a.
+template <typename Src, typename Compare>
+std::size_t merge_split(Src a, std::size_t na, Src b, std::size_t nb, std::size_t d, Compare& comp) {
+	std::size_t lo = (d > nb ? d - nb : 0);
+	std::size_t hi = std::min(d, na);
+	while (lo < hi) {
+		std::size_t mid = lo + (hi - lo) / 2;
+		if (comp(*(b + (d - mid - 1)), *(a + mid)))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return (lo);
+}
+
+// Merges the runs between bounds two by two from src into dst.
+template <typename Src, typename Dst, typename Compare>
+void merge_runs(Src src, Dst dst, ft::vector<std::size_t>& bounds, std::size_t grain,
+				Compare& comp, work_stealing_pool& pool) {
+	ft::vector<merge_task> tasks;
+	ft::vector<std::size_t> next;
+	for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+		std::size_t lo = bounds[r];
+		std::size_t mid = bounds[r + 1];
+		std::size_t hi = (r + 2 < bounds.size() ? bounds[r + 2] : mid);
+		std::size_t parts = std::max<std::size_t>((hi - lo) / grain, 1);
+		std::size_t prev_i = 0;
+		std::size_t prev_d = 0;
+		next.push_back(lo);
+		for (std::size_t p = 1; p <= parts; p++) {
+			std::size_t d = (hi - lo) * p / parts;
+			std::size_t i = (p == parts ? mid - lo : merge_split(src + lo, mid - lo, src + mid, hi - mid, d, comp));
+			merge_task t = { lo + prev_i, lo + i, mid + (prev_d - prev_i), mid + (d - i), lo + prev_d };
+			tasks.push_back(t);
+			prev_i = i;
+			prev_d = d;
+		}
+	}
+	next.push_back(bounds.back());
+	bounds.swap(next);
+	merge_body<Src, Dst, Compare> body(src, dst, tasks, comp);
+	pool(body, tasks.size());
+}
+
+template <typename It, typename Compare, typename PieceSort>
+void merge_sort(It first, It last, Compare comp, PieceSort piece, work_stealing_pool& pool) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	std::size_t n = last - first;
+	if (pool.size() == 1 || n < merge_sort_tuning::MIN_SIZE) {
+		piece(first, last);
+		return;
+	}
+	std::size_t pieces = pool.size() * 4;
+	ft::vector<std::size_t> bounds;
+	for (std::size_t i = 0; i <= pieces; i++)
+		bounds.push_back(n * i / pieces);
+	sort_pieces_body<It, PieceSort> sorter(first, bounds, piece);
+	pool(sorter, pieces);
+	sort_buffer<value_type> buffer(first, n);
+	value_type* tmp = buffer.data();
+	std::size_t grain = std::max<std::size_t>(n / pieces, merge_sort_tuning::GRAIN);
+	bool in_buffer = false;
+	while (bounds.size() > 2) {
+		if (in_buffer)
+			merge_runs(tmp, first, bounds, grain, comp, pool);
+		else
+			merge_runs(first, tmp, bounds, grain, comp, pool);
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer) {
+		// Merging the one run with nothing is a parallel copy back.
+		bounds.clear();
+		bounds.push_back(0);
+		bounds.push_back(n);
+		merge_runs(tmp, first, bounds, grain, comp, pool);
+	}
+}
+
+template <typename Compare>
+struct piece_sort {
+	Compare												comp;
+
+	explicit piece_sort(const Compare& _comp) : comp(_comp) {}
+
+	template <typename It>
+	void operator()(It first, It last) {
+		ft::sort(first, last, comp);
+	}
+};
+
+template <typename Compare>
+struct piece_stable_sort {
+	Compare												comp;
+
+	explicit piece_stable_sort(const Compare& _comp) : comp(_comp) {}
+
+	template <typename It>
+	void operator()(It first, It last) {
+		ft::stable_sort(first, last, comp);
+	}
+};
+
+// Without a comparator the pieces go through ft::sort, which radix
+// sorts integral elements.
+struct piece_default_sort {
+	template <typename It>
+	void operator()(It first, It last) {
+		ft::sort(first, last);
+	}
+};
+
+struct piece_default_stable_sort {
+	template <typename It>
+	void operator()(It first, It last) {
+		ft::stable_sort(first, last);
+	}
+};
+
+template <typename It>
+void sort(It first, It last, work_stealing_pool& pool = default_pool()) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	merge_sort(first, last, sort_less<value_type>(), piece_default_sort(), pool);
+}
+
+template <typename It, typename Compare>
+void sort(It first, It last, Compare comp, work_stealing_pool& pool = default_pool()) {
+	merge_sort(first, last, comp, piece_sort<Compare>(comp), pool);
+}
+
+template <typename It>
+void stable_sort(It first, It last, work_stealing_pool& pool = default_pool()) {
+	typedef typename iterator_traits<It>::value_type	value_type;
+	merge_sort(first, last, sort_less<value_type>(), piece_default_stable_sort(), pool);
+}
+
+template <typename It, typename Compare>
+void stable_sort(It first, It last, Compare comp, work_stealing_pool& pool = default_pool()) {
+	merge_sort(first, last, comp, piece_stable_sort<Compare>(comp), pool);
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,609 @@
+#ifndef PERSISTENT_MAP_H
+#define PERSISTENT_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./algorithm.hpp"
+#include "./iterator_traits.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./RBT_Node.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+/*
+		Immutable node: only the reference count changes after construction,
+		so one node can be shared by every version that reaches it.
+*/
+template <typename T>
+struct persistent_node {
+	typedef persistent_node<T>*	Node_ptr;
+	T							data;
+	Node_ptr					left;
+	Node_ptr					right;
+	Color						color;
+	long						refs;
+
+	persistent_node(const T& _data, Node_ptr _left, Node_ptr _right, Color _color)
+	: data(_data), left(_left), right(_right), color(_color), refs(1)
+		{}
+};
+
+template <typename T>
+class persistent_iterator : public iterator<std::bidirectional_iterator_tag, T> {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef T									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef const T*							pointer;
+	typedef const T&							reference;
+	typedef const persistent_node<T>*			Const_node_ptr;
+
+	// Red-black height is at most 2 * log2(n + 1).
+	enum { MAX_DEPTH = 2 * 8 * sizeof(void*) };
+
+ protected:
+	Const_node_ptr								root;
+	Const_node_ptr								path[MAX_DEPTH];
+	int											depth;
+
+ public:
+	persistent_iterator(void) : root(NULL), depth(0) {}
+
+	explicit persistent_iterator(Const_node_ptr _root) : root(_root), depth(0) {}
+
+	persistent_iterator(const persistent_iterator& x) : root(x.root), depth(x.depth) {
+		for (int i = 0; i < depth; i++)
+			path[i] = x.path[i];
+	}
+
+	~persistent_iterator(void) {}
+
+	persistent_iterator& operator=(const persistent_iterator& x) {
+		root = x.root;
+		depth = x.depth;
+		for (int i = 0; i < depth; i++)
+			path[i] = x.path[i];
+		return (*this);
+	}
+
+	Const_node_ptr base(void) const {
+		return (depth == 0 ? NULL : path[depth - 1]);
+	}
+
+	void push(Const_node_ptr x) {
+		path[depth++] = x;
+	}
+
+	void truncate(int n) {
+		depth = n;
+	}
+
+	int size(void) const {
+		return (depth);
+	}
+
+	reference operator*(void) const {
+		return (path[depth - 1]->data);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	persistent_iterator& operator++(void) {
+		Const_node_ptr x = path[depth - 1];
+		if (x->right != NULL) {
+			for (x = x->right; x != NULL; x = x->left)
+				push(x);
+			return (*this);
+		}
+		while (--depth > 0 && path[depth - 1]->right == x)
+			x = path[depth - 1];
+		return (*this);
+	}
+
+	persistent_iterator operator++(int) {
+		persistent_iterator tmp(*this);
+		++(*this);
+		return (tmp);
+	}
+
+	persistent_iterator& operator--(void) {
+		if (depth == 0) {
+			for (Const_node_ptr x = root; x != NULL; x = x->right)
+				push(x);
+			return (*this);
+		}
+		Const_node_ptr x = path[depth - 1];
+		if (x->left != NULL) {
+			for (x = x->left; x != NULL; x = x->right)
+				push(x);
+			return (*this);
+		}
+		while (--depth > 0 && path[depth - 1]->left == x)
+			x = path[depth - 1];
+		return (*this);
+	}
+
+	persistent_iterator operator--(int) {
+		persistent_iterator tmp(*this);
+		--(*this);
+		return (tmp);
+	}
+};
+
+template <typename T>
+inline bool operator==(const persistent_iterator<T>& lhs, const persistent_iterator<T>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename T>
+inline bool operator!=(const persistent_iterator<T>& lhs, const persistent_iterator<T>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+/*
+		Path-copying red-black map. Every update copies the O(log n) nodes on
+		the search path and shares the rest with the previous version, so a
+		copy (a snapshot) is O(1) and a version is reclaimed once the last
+		map that reaches it goes away. Reference counts are atomic: a snapshot
+		can be handed to another thread and read there while this map keeps
+		changing. A single persistent_map object is still not safe to mutate
+		and copy concurrently.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class persistent_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Alloc										allocator_type;
+	typedef ft::persistent_iterator<value_type>			iterator;
+	typedef ft::persistent_iterator<value_type>			const_iterator;
+	typedef ft::reverse_iterator<const_iterator>		reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+ private:
+	typedef persistent_node<value_type>					Tree_Node;
+	typedef Tree_Node*									Node_ptr;
+	typedef const Tree_Node*							Const_node_ptr;
+	typedef typename Alloc::template rebind<Tree_Node>::other
+														Node_allocator;
+
+	Node_ptr											_root;
+	size_type											_size;
+	Node_allocator										_alloc;
+	key_compare											_comp;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit persistent_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _comp(comp)
+		{};
+
+	template <class InputIterator>
+	persistent_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _comp(comp) {
+		insert(first, last);
+	};
+
+	persistent_map(const persistent_map& x)
+		: _root(_retain(x._root)), _size(x._size), _alloc(x._alloc), _comp(x._comp)
+		{};
+
+	~persistent_map(void) {
+		_release(_root);
+	};
+
+	persistent_map& operator=(const persistent_map& x) {
+		Node_ptr old = _root;
+		_root = _retain(x._root);
+		_size = x._size;
+		_alloc = x._alloc;
+		_comp = x._comp;
+		_release(old);
+		return (*this);
+	};
+
+	persistent_map snapshot(void) const {
+		return (persistent_map(*this));
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	const mapped_type& at(const Key& key) const {
+		Const_node_ptr x = _find(key);
+		if (x == NULL) { throw std::out_of_range("cavalinho"); }
+		return (x->data.second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	const_iterator begin(void) const {
+		const_iterator it(_root);
+		for (Const_node_ptr x = _root; x != NULL; x = x->left)
+			it.push(x);
+		return (it);
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(_root));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type max_size(void) const {
+		return (_alloc.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<const_iterator, bool> insert(const value_type& val) {
+		if (_find(val.first) != NULL)
+			return (ft::make_pair(find(val.first), false));
+		_replace_root(_blacken(_ins(_root, val)));
+		_size++;
+		return (ft::make_pair(find(val.first), true));
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		while (first != last) {
+			insert(*first);
+			++first;
+		}
+	};
+
+	ft::pair<const_iterator, bool> insert_or_assign(const key_type& k, const mapped_type& obj) {
+		bool inserted = (_find(k) == NULL);
+		_replace_root(_blacken(_ins(_root, value_type(k, obj))));
+		if (inserted)
+			_size++;
+		return (ft::make_pair(find(k), inserted));
+	};
+
+	size_type erase(const key_type& k) {
+		if (_find(k) == NULL)
+			return (0);
+		_replace_root(_blacken(_del(_root, k)));
+		_size--;
+		return (1);
+	};
+
+	void swap(persistent_map& x) {
+		std::swap(_root, x._root);
+		std::swap(_size, x._size);
+		std::swap(_alloc, x._alloc);
+		std::swap(_comp, x._comp);
+	};
+
+	void clear(void) {
+		_replace_root(NULL);
+		_size = 0;
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	const_iterator find(const key_type& k) const {
+		const_iterator it = lower_bound(k);
+		if (it != end() && _comp(k, it->first))
+			return (end());
+		return (it);
+	};
+
+	size_type count(const key_type& k) const {
+		return (_find(k) != NULL);
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		const_iterator it(_root);
+		int keep = 0;
+		for (Const_node_ptr x = _root; x != NULL;) {
+			it.push(x);
+			if (!_comp(x->data.first, k)) {
+				keep = it.size();
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		it.truncate(keep);
+		return (it);
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		const_iterator it(_root);
+		int keep = 0;
+		for (Const_node_ptr x = _root; x != NULL;) {
+			it.push(x);
+			if (_comp(k, x->data.first)) {
+				keep = it.size();
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		it.truncate(keep);
+		return (it);
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (allocator_type(_alloc));
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+ private:
+
+	static bool isRed(Const_node_ptr x) {
+		return (x != NULL && x->color == RED);
+	};
+
+	static bool isBlack(Const_node_ptr x) {
+		return (x != NULL && x->color == BLACK);
+	};
+
+	static Node_ptr _retain(Node_ptr x) {
+		if (x != NULL)
+			__sync_fetch_and_add(&x->refs, 1);
+		return (x);
+	};
+
+	void _release(Node_ptr x) {
+		while (x != NULL && __sync_sub_and_fetch(&x->refs, 1) == 0) {
+			Node_ptr left = x->left;
+			Node_ptr right = x->right;
+			_alloc.destroy(x);
+			_alloc.deallocate(x, 1);
+			_release(left);
+			x = right;
+		}
+	};
+
+	void _replace_root(Node_ptr x) {
+		Node_ptr old = _root;
+		_root = x;
+		_release(old);
+	};
+
+	Const_node_ptr _find(const key_type& k) const {
+		Const_node_ptr x = _root;
+		while (x != NULL) {
+			if (_comp(k, x->data.first))
+				x = x->left;
+			else if (_comp(x->data.first, k))
+				x = x->right;
+			else
+				return (x);
+		}
+		return (NULL);
+	};
+
+	/*
+			Ownership convention for the helpers below: tree arguments named
+			t, a or b are borrowed, the others are owned and consumed, and the
+			returned tree is owned by the caller.
+	*/
+
+	Node_ptr _make(Color c, Node_ptr left, const value_type& v, Node_ptr right) {
+		Node_ptr x = _alloc.allocate(1);
+		_alloc.construct(x, Tree_Node(v, left, right, c));
+		return (x);
+	};
+
+	// A node referenced only by the caller is not shared with any version
+	// and may be recoloured in place.
+	Node_ptr _recolor(Node_ptr x, Color c) {
+		if (x == NULL || x->color == c)
+			return (x);
+		if (x->refs == 1) {
+			x->color = c;
+			return (x);
+		}
+		Node_ptr y = _make(c, _retain(x->left), x->data, _retain(x->right));
+		_release(x);
+		return (y);
+	};
+
+	Node_ptr _blacken(Node_ptr x) {
+		return (_recolor(x, BLACK));
+	};
+
+	Node_ptr _balance(Node_ptr l, const value_type& v, Node_ptr r) {
+		Node_ptr res;
+
+		if (isRed(l) && isRed(r)) {
+			return (_make(RED, _recolor(l, BLACK), v, _recolor(r, BLACK)));
+		}
+		if (isRed(l) && isRed(l->left)) {
+			res = _make(RED, _recolor(_retain(l->left), BLACK), l->data,
+					_make(BLACK, _retain(l->right), v, r));
+			_release(l);
+			return (res);
+		}
+		if (isRed(l) && isRed(l->right)) {
+			Node_ptr lr = l->right;
+			res = _make(RED, _make(BLACK, _retain(l->left), l->data, _retain(lr->left)), lr->data,
+					_make(BLACK, _retain(lr->right), v, r));
+			_release(l);
+			return (res);
+		}
+		if (isRed(r) && isRed(r->right)) {
+			res = _make(RED, _make(BLACK, l, v, _retain(r->left)), r->data,
+					_recolor(_retain(r->right), BLACK));
+			_release(r);
+			return (res);
+		}
+		if (isRed(r) && isRed(r->left)) {
+			Node_ptr rl = r->left;
+			res = _make(RED, _make(BLACK, l, v, _retain(rl->left)), rl->data,
+					_make(BLACK, _retain(rl->right), r->data, _retain(r->right)));
+			_release(r);
+			return (res);
+		}
+		return (_make(BLACK, l, v, r));
+	};
+
+	Node_ptr _ins(Node_ptr t, const value_type& v) {
+		if (t == NULL)
+			return (_make(RED, NULL, v, NULL));
+		if (_comp(v.first, t->data.first)) {
+			if (t->color == BLACK)
+				return (_balance(_ins(t->left, v), t->data, _retain(t->right)));
+			return (_make(RED, _ins(t->left, v), t->data, _retain(t->right)));
+		}
+		if (_comp(t->data.first, v.first)) {
+			if (t->color == BLACK)
+				return (_balance(_retain(t->left), t->data, _ins(t->right, v)));
+			return (_make(RED, _retain(t->left), t->data, _ins(t->right, v)));
+		}
+		return (_make(t->color, _retain(t->left), v, _retain(t->right)));
+	};
+
+	Node_ptr _balleft(Node_ptr l, const value_type& v, Node_ptr r) {
+		if (isRed(l))
+			return (_make(RED, _recolor(l, BLACK), v, r));
+		if (isBlack(r))
+			return (_balance(l, v, _recolor(r, RED)));
+		Node_ptr rl = r->left;
+		Node_ptr res = _make(RED, _make(BLACK, l, v, _retain(rl->left)), rl->data,
+				_balance(_retain(rl->right), r->data, _recolor(_retain(r->right), RED)));
+		_release(r);
+		return (res);
+	};
+
+	Node_ptr _balright(Node_ptr l, const value_type& v, Node_ptr r) {
+		if (isRed(r))
+			return (_make(RED, l, v, _recolor(r, BLACK)));
+		if (isBlack(l))
+			return (_balance(_recolor(l, RED), v, r));
+		Node_ptr lr = l->right;
+		Node_ptr res = _make(RED, _balance(_recolor(_retain(l->left), RED), l->data, _retain(lr->left)),
+				lr->data, _make(BLACK, _retain(lr->right), v, r));
+		_release(l);
+		return (res);
+	};
+
+	// Joins two sibling subtrees whose parent is being removed.
+	Node_ptr _app(Node_ptr a, Node_ptr b) {
+		if (a == NULL)
+			return (_retain(b));
+		if (b == NULL)
+			return (_retain(a));
+		if (isRed(a) && isRed(b)) {
+			Node_ptr bc = _app(a->right, b->left);
+			if (isRed(bc)) {
+				Node_ptr res = _make(RED, _make(RED, _retain(a->left), a->data, _retain(bc->left)), bc->data,
+						_make(RED, _retain(bc->right), b->data, _retain(b->right)));
+				_release(bc);
+				return (res);
+			}
+			return (_make(RED, _retain(a->left), a->data, _make(RED, bc, b->data, _retain(b->right))));
+		}
+		if (isBlack(a) && isBlack(b)) {
+			Node_ptr bc = _app(a->right, b->left);
+			if (isRed(bc)) {
+				Node_ptr res = _make(RED, _make(BLACK, _retain(a->left), a->data, _retain(bc->left)), bc->data,
+						_make(BLACK, _retain(bc->right), b->data, _retain(b->right)));
+				_release(bc);
+				return (res);
+			}
+			return (_balleft(_retain(a->left), a->data, _make(BLACK, bc, b->data, _retain(b->right))));
+		}
+		if (isRed(b))
+			return (_make(RED, _app(a, b->left), b->data, _retain(b->right)));
+		return (_make(RED, _retain(a->left), a->data, _app(a->right, b)));
+	};
+
+	Node_ptr _del(Node_ptr t, const key_type& k) {
+		if (t == NULL)
+			return (NULL);
+		if (_comp(k, t->data.first)) {
+			if (isBlack(t->left))
+				return (_balleft(_del(t->left, k), t->data, _retain(t->right)));
+			return (_make(RED, _del(t->left, k), t->data, _retain(t->right)));
+		}
+		if (_comp(t->data.first, k)) {
+			if (isBlack(t->right))
+				return (_balright(_retain(t->left), t->data, _del(t->right, k)));
+			return (_make(RED, _retain(t->left), t->data, _del(t->right, k)));
+		}
+		return (_app(t->left, t->right));
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Compare, class Alloc>
+void swap(persistent_map<Key, T, Compare, Alloc>& lhs, persistent_map<Key, T, Compare, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const persistent_map<Key, T, Compare, Alloc>& lhs,
+				const persistent_map<Key, T, Compare, Alloc>& rhs) {
+	return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const persistent_map<Key, T, Compare, Alloc>& lhs,
+				const persistent_map<Key, T, Compare, Alloc>& rhs) {
+	return (!(lhs == rhs));
+}
+
+};
+#endif
@@ -0,0 +1,954 @@
+#ifndef RADIX_MAP_H
+#define RADIX_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "./Container.hpp"
+#include "./algorithm.hpp"
+#include "./iterator_traits.hpp"
+#include "./reverse_iterator_vec.hpp"
+#include "./type_traits.hpp"
+#include "./utility.hpp"
+
+namespace ft {
+
+enum radix_kind {
+	RADIX_LEAF,
+	RADIX_NODE4,
+	RADIX_NODE16,
+	RADIX_NODE48,
+	RADIX_NODE256
+};
+
+struct radix_node {
+	unsigned char						kind;
+};
+
+// Dispatches on byte depth of the key, 0 being the most significant. The
+// bytes before it are shared by the whole subtree; prefix is one key from
+// it and stands in for the compressed path.
+struct radix_inner : radix_node {
+	unsigned char						depth;
+	unsigned short						count;
+	unsigned long long					prefix;
+};
+
+struct radix_node4 : radix_inner {
+	unsigned char						keys[4];
+	radix_node*							child[4];
+};
+
+struct radix_node16 : radix_inner {
+	unsigned char						keys[16];
+	radix_node*							child[16];
+};
+
+// index[b] is one past the slot holding the child for byte b, or 0.
+struct radix_node48 : radix_inner {
+	unsigned char						index[256];
+	radix_node*							child[48];
+};
+
+struct radix_node256 : radix_inner {
+	radix_node*							child[256];
+};
+
+// Leaves are also threaded in key order, so iterating never touches an
+// inner node.
+struct radix_link {
+	radix_link*							prev;
+	radix_link*							next;
+};
+
+template <typename V>
+struct radix_leaf : radix_node, radix_link {
+	unsigned long long					ukey;
+	V									data;
+
+	radix_leaf(const V& _data, unsigned long long _ukey) : ukey(_ukey), data(_data) {
+		kind = RADIX_LEAF;
+		prev = NULL;
+		next = NULL;
+	}
+};
+
+template <typename T, typename Leaf>
+class radix_iterator : public iterator<std::bidirectional_iterator_tag, T> {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef T									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef T*									pointer;
+	typedef T&									reference;
+
+ protected:
+	radix_link*									link;
+
+ public:
+	radix_iterator(void) : link(NULL) {}
+
+	explicit radix_iterator(radix_link* _link) : link(_link) {}
+
+	template <typename U>
+	radix_iterator(const radix_iterator<U, Leaf>& i) : link(i.base()) {}
+
+	~radix_iterator(void) {}
+
+	radix_link* base(void) const {
+		return (link);
+	}
+
+	reference operator*(void) const {
+		return (static_cast<Leaf*>(link)->data);
+	}
+
+	pointer operator->(void) const {
+		return (&(operator*()));
+	}
+
+	radix_iterator& operator++(void) {
+		link = link->next;
+		return (*this);
+	}
+
+	radix_iterator operator++(int) {
+		radix_iterator tmp(*this);
+		link = link->next;
+		return (tmp);
+	}
+
+	radix_iterator& operator--(void) {
+		link = link->prev;
+		return (*this);
+	}
+
+	radix_iterator operator--(int) {
+		radix_iterator tmp(*this);
+		link = link->prev;
+		return (tmp);
+	}
+};
+
+template <typename TL, typename TR, typename Leaf>
+inline bool operator==(const radix_iterator<TL, Leaf>& lhs, const radix_iterator<TR, Leaf>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename TL, typename TR, typename Leaf>
+inline bool operator!=(const radix_iterator<TL, Leaf>& lhs, const radix_iterator<TR, Leaf>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+/*
+		An ordered map for integral keys: an adaptive radix tree with one
+		key byte per level, inner nodes of 4, 16, 48 or 256 children and
+		compressed paths. A lookup reads at most sizeof(Key) inner nodes
+		and never compares whole keys until the leaf. Signed keys get their
+		sign bit flipped so that byte order is numeric order.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class radix_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef typename ft::enable_if<Key, ft::is_integral<Key>::value>::type
+														key_type;
+	typedef T											mapped_type;
+	typedef std::less<Key>								key_compare;
+	typedef Alloc										allocator_type;
+
+ private:
+	typedef radix_leaf<value_type>						Leaf;
+	typedef typename Alloc::template rebind<Leaf>::other	Leaf_allocator;
+	typedef unsigned long long							ukey_type;
+
+	enum { WIDTH = sizeof(Key) };
+
+ public:
+	typedef ft::radix_iterator<value_type, Leaf>		iterator;
+	typedef ft::radix_iterator<const value_type, Leaf>	const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+ /*****************************************************************************\
+ * 							MEMBER CLASS			 						   *
+ \*****************************************************************************/
+	class value_compare : public std::binary_function<value_type, value_type, bool> {
+	 protected:
+		key_compare comp;
+
+	 public:
+		explicit value_compare(key_compare c = key_compare()) : comp(c) {}
+
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(x.first, y.first));
+		}
+	};
+
+ private:
+	radix_node*											_root;
+	radix_link											_head;
+	size_type											_size;
+	allocator_type										_alloc;
+	Leaf_allocator										_leaf_alloc;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit radix_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _leaf_alloc(alloc) {
+		(void)comp;
+		_head.prev = &_head;
+		_head.next = &_head;
+	};
+
+	template <class InputIterator>
+	radix_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _leaf_alloc(alloc) {
+		(void)comp;
+		_head.prev = &_head;
+		_head.next = &_head;
+		insert(first, last);
+	};
+
+	radix_map(const radix_map& x) : _root(NULL), _size(0), _alloc(x._alloc), _leaf_alloc(x._leaf_alloc) {
+		_head.prev = &_head;
+		_head.next = &_head;
+		insert(x.begin(), x.end());
+	};
+
+	~radix_map(void) {
+		clear();
+	};
+
+	radix_map& operator=(const radix_map& x) {
+		if (this != &x) {
+			clear();
+			_alloc = x._alloc;
+			_leaf_alloc = x._leaf_alloc;
+			insert(x.begin(), x.end());
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type& at(const Key& key) {
+		iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	const mapped_type& at(const Key& key) const {
+		const_iterator it = find(key);
+		if (it == end()) { throw std::out_of_range("cavalinho"); }
+		return (it->second);
+	};
+
+	mapped_type& operator[](const key_type& k) {
+		Leaf* l = _find(_encode(k));
+		if (l != NULL)
+			return (l->data.second);
+		return (insert(ft::make_pair(k, mapped_type())).first->second);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (iterator(_head.next));
+	};
+
+	const_iterator begin(void) const {
+		return (const_iterator(_head.next));
+	};
+
+	iterator end(void) {
+		return (iterator(&_head));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(const_cast<radix_link*>(&_head)));
+	};
+
+	reverse_iterator rbegin(void) {
+		return (reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	reverse_iterator rend(void) {
+		return (reverse_iterator(begin()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type max_size(void) const {
+		return (_leaf_alloc.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		return (_insert(val));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		(void)position;
+		return (_insert(val).first);
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			_insert(*first);
+	};
+
+	void erase(iterator position) {
+		erase(position->first);
+	};
+
+	size_type erase(const key_type& k) {
+		ukey_type u = _encode(k);
+		radix_node** ref = &_root;
+		radix_node** parent_ref = NULL;
+		radix_inner* parent = NULL;
+		radix_node* x = _root;
+		while (x != NULL && x->kind != RADIX_LEAF) {
+			parent = static_cast<radix_inner*>(x);
+			parent_ref = ref;
+			ref = _slot(parent, _byte(u, parent->depth));
+			x = (ref != NULL ? *ref : NULL);
+		}
+		if (x == NULL || static_cast<Leaf*>(x)->ukey != u)
+			return (0);
+		if (parent == NULL)
+			_root = NULL;
+		else
+			_remove_child(parent_ref, parent, _byte(u, parent->depth));
+		_delete_leaf(static_cast<Leaf*>(x));
+		return (1);
+	};
+
+	void erase(iterator first, iterator last) {
+		while (first != last)
+			erase(first++);
+	};
+
+	void swap(radix_map& x) {
+		std::swap(_root, x._root);
+		std::swap(_size, x._size);
+		std::swap(_alloc, x._alloc);
+		std::swap(_leaf_alloc, x._leaf_alloc);
+		radix_link tmp;
+		_move_list(_head, tmp);
+		_move_list(x._head, _head);
+		_move_list(tmp, x._head);
+	};
+
+	void clear(void) {
+		if (_root != NULL)
+			_destroy(_root);
+		_root = NULL;
+		_head.prev = &_head;
+		_head.next = &_head;
+		_size = 0;
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) {
+		Leaf* l = _find(_encode(k));
+		return (l != NULL ? iterator(l) : end());
+	};
+
+	const_iterator find(const key_type& k) const {
+		Leaf* l = _find(_encode(k));
+		return (l != NULL ? const_iterator(l) : end());
+	};
+
+	size_type count(const key_type& k) const {
+		return (_find(_encode(k)) != NULL);
+	};
+
+	iterator lower_bound(const key_type& k) {
+		return (iterator(_bound(_encode(k))));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (const_iterator(_bound(_encode(k))));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		ukey_type u = _encode(k);
+		return (u == _max_ukey() ? end() : iterator(_bound(u + 1)));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		ukey_type u = _encode(k);
+		return (u == _max_ukey() ? end() : const_iterator(_bound(u + 1)));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	// Copies every element with a key in [lo, hi) to out, in key order.
+	template <class OutputIterator>
+	OutputIterator range_scan(const key_type& lo, const key_type& hi, OutputIterator out) const {
+		if (!(lo < hi))
+			return (out);
+		const_iterator last = lower_bound(hi);
+		for (const_iterator it = lower_bound(lo); it != last; ++it)
+			*out++ = *it;
+		return (out);
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	key_compare key_comp(void) const {
+		return (key_compare());
+	};
+
+	value_compare value_comp(void) const {
+		return (value_compare());
+	};
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+ private:
+
+ /*****************************************************************************\
+ * 							KEYS				 							   *
+ \*****************************************************************************/
+
+	static ukey_type _max_ukey(void) {
+		return (~0ULL >> (64 - 8 * WIDTH));
+	};
+
+	static ukey_type _encode(const key_type& k) {
+		ukey_type u = static_cast<ukey_type>(k) & _max_ukey();
+		if (std::numeric_limits<Key>::is_signed)
+			u ^= 1ULL << (8 * WIDTH - 1);
+		return (u);
+	};
+
+	static unsigned _byte(ukey_type u, unsigned depth) {
+		return ((u >> (8 * (WIDTH - 1 - depth))) & 0xff);
+	};
+
+	// The first byte where a and b differ, or WIDTH if they are equal.
+	static unsigned _mismatch(ukey_type a, ukey_type b) {
+		ukey_type x = a ^ b;
+		if (x == 0)
+			return (WIDTH);
+		return ((__builtin_clzll(x) >> 3) - (8 - WIDTH));
+	};
+
+ /*****************************************************************************\
+ * 							NODES				 							   *
+ \*****************************************************************************/
+
+	// The number of keys below b; no branch, so 16 keys compare at once.
+	static unsigned _rank(const unsigned char* keys, unsigned count, unsigned b) {
+		unsigned r = 0;
+		for (unsigned i = 0; i < count; i++)
+			r += (keys[i] < b);
+		return (r);
+	};
+
+	template <typename N>
+	static radix_node** _sorted_slot(N* n, unsigned b) {
+		unsigned i = _rank(n->keys, n->count, b);
+		return (i < n->count && n->keys[i] == b ? &n->child[i] : NULL);
+	};
+
+	static radix_node** _slot(radix_inner* n, unsigned b) {
+		switch (n->kind) {
+			case RADIX_NODE4:
+				return (_sorted_slot(static_cast<radix_node4*>(n), b));
+			case RADIX_NODE16:
+				return (_sorted_slot(static_cast<radix_node16*>(n), b));
+			case RADIX_NODE48: {
+				radix_node48* p = static_cast<radix_node48*>(n);
+				return (p->index[b] ? &p->child[p->index[b] - 1] : NULL);
+			}
+			default: {
+				radix_node256* p = static_cast<radix_node256*>(n);
+				return (p->child[b] ? &p->child[b] : NULL);
+			}
+		}
+	};
+
+	// The child for the smallest byte above b (-1 for the first child), or
+	// NULL; byte receives its byte.
+	static radix_node* _next_child(radix_inner* n, int b, unsigned& byte) {
+		switch (n->kind) {
+			case RADIX_NODE4:
+			case RADIX_NODE16: {
+				unsigned char* keys = (n->kind == RADIX_NODE4
+					? static_cast<radix_node4*>(n)->keys : static_cast<radix_node16*>(n)->keys);
+				radix_node** child = (n->kind == RADIX_NODE4
+					? static_cast<radix_node4*>(n)->child : static_cast<radix_node16*>(n)->child);
+				unsigned i = _rank(keys, n->count, b + 1);
+				if (i == n->count)
+					return (NULL);
+				byte = keys[i];
+				return (child[i]);
+			}
+			case RADIX_NODE48: {
+				radix_node48* p = static_cast<radix_node48*>(n);
+				for (unsigned i = b + 1; i < 256; i++) {
+					if (p->index[i]) {
+						byte = i;
+						return (p->child[p->index[i] - 1]);
+					}
+				}
+				return (NULL);
+			}
+			default: {
+				radix_node256* p = static_cast<radix_node256*>(n);
+				for (unsigned i = b + 1; i < 256; i++) {
+					if (p->child[i]) {
+						byte = i;
+						return (p->child[i]);
+					}
+				}
+				return (NULL);
+			}
+		}
+	};
+
+	// The child for the largest byte below b (256 for the last child).
+	static radix_node* _prev_child(radix_inner* n, int b) {
+		switch (n->kind) {
+			case RADIX_NODE4:
+			case RADIX_NODE16: {
+				unsigned char* keys = (n->kind == RADIX_NODE4
+					? static_cast<radix_node4*>(n)->keys : static_cast<radix_node16*>(n)->keys);
+				radix_node** child = (n->kind == RADIX_NODE4
+					? static_cast<radix_node4*>(n)->child : static_cast<radix_node16*>(n)->child);
+				unsigned i = _rank(keys, n->count, b);
+				return (i > 0 ? child[i - 1] : NULL);
+			}
+			case RADIX_NODE48: {
+				radix_node48* p = static_cast<radix_node48*>(n);
+				for (int i = b - 1; i >= 0; i--) {
+					if (p->index[i])
+						return (p->child[p->index[i] - 1]);
+				}
+				return (NULL);
+			}
+			default: {
+				radix_node256* p = static_cast<radix_node256*>(n);
+				for (int i = b - 1; i >= 0; i--) {
+					if (p->child[i])
+						return (p->child[i]);
+				}
+				return (NULL);
+			}
+		}
+	};
+
+	static Leaf* _min_leaf(radix_node* x) {
+		unsigned byte;
+		while (x->kind != RADIX_LEAF)
+			x = _next_child(static_cast<radix_inner*>(x), -1, byte);
+		return (static_cast<Leaf*>(x));
+	};
+
+	static Leaf* _max_leaf(radix_node* x) {
+		while (x->kind != RADIX_LEAF)
+			x = _prev_child(static_cast<radix_inner*>(x), 256);
+		return (static_cast<Leaf*>(x));
+	};
+
+	template <typename N>
+	N* _new_inner(unsigned char kind, unsigned depth, ukey_type prefix) {
+		typename Alloc::template rebind<N>::other node_alloc(_alloc);
+		N* n = node_alloc.allocate(1);
+		::new (static_cast<void*>(n)) N();
+		n->kind = kind;
+		n->depth = depth;
+		n->count = 0;
+		n->prefix = prefix;
+		return (n);
+	};
+
+	template <typename N>
+	void _free_inner(N* n) {
+		typename Alloc::template rebind<N>::other node_alloc(_alloc);
+		node_alloc.deallocate(n, 1);
+	};
+
+	void _delete_inner(radix_inner* n) {
+		switch (n->kind) {
+			case RADIX_NODE4: _free_inner(static_cast<radix_node4*>(n)); break;
+			case RADIX_NODE16: _free_inner(static_cast<radix_node16*>(n)); break;
+			case RADIX_NODE48: _free_inner(static_cast<radix_node48*>(n)); break;
+			default: _free_inner(static_cast<radix_node256*>(n)); break;
+		}
+	};
+
+	radix_inner* _new_kind(unsigned char kind, unsigned depth, ukey_type prefix) {
+		switch (kind) {
+			case RADIX_NODE4: return (_new_inner<radix_node4>(kind, depth, prefix));
+			case RADIX_NODE16: return (_new_inner<radix_node16>(kind, depth, prefix));
+			case RADIX_NODE48: return (_new_inner<radix_node48>(kind, depth, prefix));
+			default: return (_new_inner<radix_node256>(kind, depth, prefix));
+		}
+	};
+
+	template <typename N>
+	static void _insert_sorted(N* n, unsigned b, radix_node* c) {
+		unsigned i = n->count;
+		for (; i > 0 && n->keys[i - 1] > b; i--) {
+			n->keys[i] = n->keys[i - 1];
+			n->child[i] = n->child[i - 1];
+		}
+		n->keys[i] = b;
+		n->child[i] = c;
+	};
+
+	template <typename N>
+	static void _remove_sorted(N* n, unsigned b) {
+		unsigned i = _rank(n->keys, n->count, b);
+		for (; i + 1 < n->count; i++) {
+			n->keys[i] = n->keys[i + 1];
+			n->child[i] = n->child[i + 1];
+		}
+	};
+
+	// n has room for c.
+	static void _insert_child(radix_inner* n, unsigned b, radix_node* c) {
+		switch (n->kind) {
+			case RADIX_NODE4:
+				_insert_sorted(static_cast<radix_node4*>(n), b, c);
+				break;
+			case RADIX_NODE16:
+				_insert_sorted(static_cast<radix_node16*>(n), b, c);
+				break;
+			case RADIX_NODE48: {
+				radix_node48* p = static_cast<radix_node48*>(n);
+				unsigned i = 0;
+				while (p->child[i] != NULL)
+					i++;
+				p->child[i] = c;
+				p->index[b] = i + 1;
+				break;
+			}
+			default:
+				static_cast<radix_node256*>(n)->child[b] = c;
+				break;
+		}
+		n->count++;
+	};
+
+	// Moves the children of n into a fresh node of another kind.
+	radix_inner* _resize(radix_inner* n, unsigned char kind) {
+		radix_inner* m = _new_kind(kind, n->depth, n->prefix);
+		unsigned byte;
+		int b = -1;
+		for (radix_node* c; (c = _next_child(n, b, byte)) != NULL; b = byte)
+			_insert_child(m, byte, c);
+		_delete_inner(n);
+		return (m);
+	};
+
+	static bool _full(radix_inner* n) {
+		switch (n->kind) {
+			case RADIX_NODE4: return (n->count == 4);
+			case RADIX_NODE16: return (n->count == 16);
+			case RADIX_NODE48: return (n->count == 48);
+			default: return (false);
+		}
+	};
+
+	// Grows n and repoints *ref when it is full, before the leaf that goes
+	// under it is allocated.
+	radix_inner* _make_room(radix_node** ref, radix_inner* n) {
+		if (_full(n)) {
+			n = _resize(n, n->kind + 1);
+			*ref = n;
+		}
+		return (n);
+	};
+
+	// Shrinks n once it is well under capacity, and replaces a node4 left
+	// with a single child by that child.
+	void _remove_child(radix_node** ref, radix_inner* n, unsigned b) {
+		switch (n->kind) {
+			case RADIX_NODE4:
+				_remove_sorted(static_cast<radix_node4*>(n), b);
+				break;
+			case RADIX_NODE16:
+				_remove_sorted(static_cast<radix_node16*>(n), b);
+				break;
+			case RADIX_NODE48: {
+				radix_node48* p = static_cast<radix_node48*>(n);
+				p->child[p->index[b] - 1] = NULL;
+				p->index[b] = 0;
+				break;
+			}
+			default:
+				static_cast<radix_node256*>(n)->child[b] = NULL;
+				break;
+		}
+		n->count--;
+		if ((n->kind == RADIX_NODE256 && n->count <= 40)
+				|| (n->kind == RADIX_NODE48 && n->count <= 12)
+				|| (n->kind == RADIX_NODE16 && n->count <= 3)) {
+			*ref = _resize(n, n->kind - 1);
+		} else if (n->kind == RADIX_NODE4 && n->count == 1) {
+			*ref = static_cast<radix_node4*>(n)->child[0];
+			_delete_inner(n);
+		}
+	};
+
+	void _destroy(radix_node* x) {
+		if (x->kind == RADIX_LEAF) {
+			Leaf* l = static_cast<Leaf*>(x);
+			_leaf_alloc.destroy(l);
+			_leaf_alloc.deallocate(l, 1);
+			return;
+		}
+		radix_inner* n = static_cast<radix_inner*>(x);
+		unsigned byte;
+		int b = -1;
+		for (radix_node* c; (c = _next_child(n, b, byte)) != NULL; b = byte)
+			_destroy(c);
+		_delete_inner(n);
+	};
+
+ /*****************************************************************************\
+ * 							LEAVES				 							   *
+ \*****************************************************************************/
+
+	Leaf* _new_leaf(const value_type& val, ukey_type u, radix_link* before) {
+		Leaf* l = _leaf_alloc.allocate(1);
+		try {
+			_leaf_alloc.construct(l, Leaf(val, u));
+		} catch (...) {
+			_leaf_alloc.deallocate(l, 1);
+			throw;
+		}
+		l->next = before;
+		l->prev = before->prev;
+		before->prev->next = l;
+		before->prev = l;
+		_size++;
+		return (l);
+	};
+
+	void _delete_leaf(Leaf* l) {
+		l->prev->next = l->next;
+		l->next->prev = l->prev;
+		_leaf_alloc.destroy(l);
+		_leaf_alloc.deallocate(l, 1);
+		_size--;
+	};
+
+	static void _move_list(radix_link& from, radix_link& to) {
+		if (from.next == &from) {
+			to.prev = &to;
+			to.next = &to;
+			return;
+		}
+		to.next = from.next;
+		to.prev = from.prev;
+		to.next->prev = &to;
+		to.prev->next = &to;
+		from.prev = &from;
+		from.next = &from;
+	};
+
+ /*****************************************************************************\
+ * 							SEARCH				 							   *
+ \*****************************************************************************/
+
+	// Compressed paths are not checked on the way down: the leaf holds the
+	// whole key.
+	Leaf* _find(ukey_type u) const {
+		radix_node* x = _root;
+		while (x != NULL && x->kind != RADIX_LEAF) {
+			radix_inner* n = static_cast<radix_inner*>(x);
+			radix_node** s = _slot(n, _byte(u, n->depth));
+			x = (s != NULL ? *s : NULL);
+		}
+		if (x == NULL || static_cast<Leaf*>(x)->ukey != u)
+			return (NULL);
+		return (static_cast<Leaf*>(x));
+	};
+
+	// The first leaf at or above u in x's subtree, or NULL.
+	Leaf* _lower_leaf(radix_node* x, ukey_type u) const {
+		if (x->kind == RADIX_LEAF) {
+			Leaf* l = static_cast<Leaf*>(x);
+			return (l->ukey >= u ? l : NULL);
+		}
+		radix_inner* n = static_cast<radix_inner*>(x);
+		if (_mismatch(u, n->prefix) < n->depth)
+			return (u < n->prefix ? _min_leaf(n) : NULL);
+		unsigned b = _byte(u, n->depth);
+		radix_node** s = _slot(n, b);
+		if (s != NULL) {
+			Leaf* l = _lower_leaf(*s, u);
+			if (l != NULL)
+				return (l);
+		}
+		unsigned byte;
+		radix_node* next = _next_child(n, b, byte);
+		return (next != NULL ? _min_leaf(next) : NULL);
+	};
+
+	radix_link* _bound(ukey_type u) const {
+		Leaf* l = (_root != NULL ? _lower_leaf(_root, u) : NULL);
+		return (l != NULL ? l : const_cast<radix_link*>(&_head));
+	};
+
+	ft::pair<iterator, bool> _insert(const value_type& val) {
+		ukey_type u = _encode(val.first);
+		if (_root == NULL) {
+			_root = _new_leaf(val, u, &_head);
+			return (ft::make_pair(iterator(_head.next), true));
+		}
+		radix_node** ref = &_root;
+		for (;;) {
+			radix_node* x = *ref;
+			if (x->kind == RADIX_LEAF) {
+				Leaf* l = static_cast<Leaf*>(x);
+				if (l->ukey == u)
+					return (ft::make_pair(iterator(l), false));
+				unsigned d = _mismatch(u, l->ukey);
+				radix_inner* n = _new_inner<radix_node4>(RADIX_NODE4, d, u);
+				Leaf* z;
+				try {
+					z = _new_leaf(val, u, u < l->ukey ? l : l->next);
+				} catch (...) {
+					_delete_inner(n);
+					throw;
+				}
+				_insert_child(n, _byte(l->ukey, d), l);
+				_insert_child(n, _byte(u, d), z);
+				*ref = n;
+				return (ft::make_pair(iterator(z), true));
+			}
+			radix_inner* n = static_cast<radix_inner*>(x);
+			unsigned d = _mismatch(u, n->prefix);
+			if (d < n->depth) {
+				radix_inner* m = _new_inner<radix_node4>(RADIX_NODE4, d, u);
+				Leaf* z;
+				try {
+					z = _new_leaf(val, u, u < n->prefix ? _min_leaf(n) : _max_leaf(n)->next);
+				} catch (...) {
+					_delete_inner(m);
+					throw;
+				}
+				_insert_child(m, _byte(n->prefix, d), n);
+				_insert_child(m, _byte(u, d), z);
+				*ref = m;
+				return (ft::make_pair(iterator(z), true));
+			}
+			unsigned b = _byte(u, n->depth);
+			radix_node** s = _slot(n, b);
+			if (s != NULL) {
+				ref = s;
+				continue;
+			}
+			n = _make_room(ref, n);
+			unsigned byte;
+			radix_node* next = _next_child(n, b, byte);
+			Leaf* z = _new_leaf(val, u, next != NULL ? _min_leaf(next) : _max_leaf(_prev_child(n, b))->next);
+			_insert_child(n, b, z);
+			return (ft::make_pair(iterator(z), true));
+		}
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, class Alloc>
+bool operator==(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class Key, class T, class Alloc>
+bool operator!=(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (!(lhs == rhs));
+}
+
+template <class Key, class T, class Alloc>
+bool operator<(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+}
+
+template <class Key, class T, class Alloc>
+bool operator<=(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (!(rhs < lhs));
+}
+
+template <class Key, class T, class Alloc>
+bool operator>(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (rhs < lhs);
+}
+
+template <class Key, class T, class Alloc>
+bool operator>=(const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs) {
+	return (!(lhs < rhs));
+}
+
+template <class Key, class T, class Alloc>
+void swap(radix_map<Key, T, Alloc>& lhs, radix_map<Key, T, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
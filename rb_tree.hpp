@@ -8,13 +8,23 @@
 #include "./bidirectional_iterator.hpp"
 #include "./reverse_iterator_map.hpp"
 #include "./RBT_Node.hpp"
+#include "./tree_balance.hpp"
+#include "./utility.hpp"
 
 namespace ft {
 #define CONTAINER Container<Val, Alloc>
-template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = std::allocator<Val> >
+template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = std::allocator<Val>,
+		typename Balance = rb_balance>
 class Rb_tree : public CONTAINER {
 private:
 	typedef typename Alloc::template rebind<RBT_Node<Val> >::other Node_allocator;
+	typedef typename Alloc::template rebind<RBT_Node<Val>*>::other Ptr_allocator;
+
+	// Purging at least 1 / REBUILD_FRACTION of the tree rebuilds it.
+	enum { REBUILD_FRACTION = 4 };
+
+	// How far scan() runs ahead of the node it is copying.
+	enum { SCAN_AHEAD = 4 };
 
 public:
 	IMPORT_TYPE(value_type);
@@ -41,32 +51,11 @@ private:
 		Node_ptr								_dummy;
 		size_type								_size;
 		key_compare								_comp;
-
-	Color getColor(Const_node_ptr x)
-	{
-		return (x == NULL ? BLACK : x->color);
-	};
-
-	void setColor(Node_ptr x, Color c)
-	{
-		if (x != NULL)
-			x->color = c;
-	};
-
-	bool isRed(Const_node_ptr x)
-	{
-		return (getColor(x) == RED);
-	};
-
-	bool isBlack(Const_node_ptr x)
-	{
-		return (getColor(x) == BLACK);
-	};
-
-	bool isNullOrBlack(Const_node_ptr x)
-	{
-		return (x == NULL || isBlack(x));
-	};
+		mutable Node_ptr						_finger;
+		bool									_finger_cache;
+		Node_ptr								_arena;
+		size_type								_arena_size;
+		size_type								_arena_live;
 
  public:
 
@@ -76,14 +65,18 @@ private:
 
 	explicit Rb_tree(const key_compare& comp = key_compare(),
 					const allocator_type& alloc = allocator_type())
-		: _alloc(alloc), _dummy(_alloc.allocate(1)), _size(0), _comp(comp) {
+		: _root(NULL), _alloc(alloc), _dummy(_alloc.allocate(1)), _size(0), _comp(comp), _finger_cache(false),
+			_arena(NULL), _arena_size(0), _arena_live(0) {
 		_alloc.construct(_dummy, create_node(value_type(), BLACK));
 		_root = _dummy;
+		_finger = _dummy;
 	};
 
-	Rb_tree(const Rb_tree& x) : _alloc(x._alloc), _dummy(_alloc.allocate(1)), _comp(x._comp), _size(x._size) {
+	Rb_tree(const Rb_tree& x) : _root(NULL), _alloc(x._alloc), _dummy(_alloc.allocate(1)), _size(0), _comp(x._comp),
+			_finger_cache(x._finger_cache), _arena(NULL), _arena_size(0), _arena_live(0) {
 		_alloc.construct(_dummy, create_node(value_type(), BLACK));
 		_root = _dummy;
+		_finger = _dummy;
 		copy(x._root);
 	};
 
@@ -94,6 +87,11 @@ private:
 			_dummy = _alloc.allocate(1);
 			_alloc.construct(_dummy, create_node(value_type(), BLACK));
 			_root = _dummy;
+			_finger = _dummy;
+			_finger_cache = rhs._finger_cache;
+			_arena = NULL;
+			_arena_size = 0;
+			_arena_live = 0;
 			copy(rhs._root);
 			_size = rhs._size;
 			_comp = rhs._comp;
@@ -130,6 +128,11 @@ private:
 			std::swap(_alloc, x._alloc);
 			std::swap(_size, x._size);
 			std::swap(_comp, x._comp);
+			std::swap(_arena, x._arena);
+			std::swap(_arena_size, x._arena_size);
+			std::swap(_arena_live, x._arena_live);
+			_finger = _dummy;
+			x._finger = x._dummy;
 		}
 		else
 		{
@@ -140,7 +143,12 @@ private:
 	void clear(void) {
 		_clear(_root);
 		_root = _dummy;
+		_finger = _dummy;
 		_size = 0;
+#ifdef FT_THREADED_TREE
+		_dummy->next = _dummy;
+		_dummy->prev = _dummy;
+#endif
 	};
 
 	key_compare key_comp(void) const {
@@ -148,98 +156,68 @@ private:
 	};
 
 	iterator lower_bound(const key_type& k) {
-		Node_ptr ptr = _root;
-		Node_ptr res = NULL;
-		while (ptr != NULL)
-		{
-			if (_comp(k, KeyOfValue()(ptr->data)))
-			{
-				res = ptr;
-				ptr = ptr->left;
-			}
-			else if (_comp(KeyOfValue()(ptr->data), k))
-			{
-				ptr = ptr->right;
-			}
-			else
-			{
-				return iterator(ptr);
-			}
-		}
-		return iterator(res);
+		return (iterator(_cached_lower_bound(k)));
 	};
 
 	const_iterator lower_bound(const key_type& k) const {
-		Node_ptr ptr = _root;
-		Node_ptr res = NULL;
-		while (ptr != NULL)
-		{
-			if (_comp(k, KeyOfValue()(ptr->data)))
-			{
-				res = ptr;
-				ptr = ptr->left;
-			}
-			else if (_comp(KeyOfValue()(ptr->data), k))
-			{
-				ptr = ptr->right;
-			}
-			else
-			{
-				return const_iterator(ptr);
-			}
-		}
-		return const_iterator(res);
+		return (const_iterator(_cached_lower_bound(k)));
+	};
+
+	// hint is any node of this tree, or _dummy to start from the root.
+	Node_ptr lower_bound(const key_type& k, Node_ptr hint) const {
+		return (_finger_lower_bound(hint, k));
 	};
 
 	iterator upper_bound(const key_type& k) {
-		Node_ptr ptr = _root;
-		Node_ptr res = NULL;
-		while (ptr != NULL)
-		{
-			if (_comp(k, KeyOfValue()(ptr->data)))
-			{
-				res = ptr;
-				ptr = ptr->left;
-			}
-			else if (_comp(KeyOfValue()(ptr->data), k))
-			{
-				ptr = ptr->right;
-			}
-			else
-			{
-				return iterator(ptr->right);
-			}
-		}
-		return iterator(res);
+		return (iterator(_upper_bound(_root, _dummy, k)));
 	};
 
 	const_iterator upper_bound(const key_type& k) const {
-		Node_ptr ptr = _root;
-		Node_ptr res = NULL;
-		while (ptr != NULL)
-		{
-			if (_comp(k, KeyOfValue()(ptr->data)))
-			{
-				res = ptr;
-				ptr = ptr->left;
-			}
-			else if (_comp(KeyOfValue()(ptr->data), k))
-			{
-				ptr = ptr->right;
-			}
-			else
-			{
-				return const_iterator(ptr->right);
-			}
-		}
-		return const_iterator(res);
+		return (const_iterator(_upper_bound(_root, _dummy, k)));
+	};
+
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+		return (_find_batch<iterator>(first, last, out));
+	};
+
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+		return (_find_batch<const_iterator>(first, last, out));
 	};
 
 	allocator_type get_allocator(void) const { return (_alloc); };
 
-	Node_ptr find(Key k) const { return (_find(_root, k)); };
+	Node_ptr find(Key k) const { return (_cached_find(k)); };
+
+	// Lets self-adjusting policies move the node they found.
+	Node_ptr find(Key k) {
+		Node_ptr x = _cached_find(k);
+		if (x != _dummy) {
+			Balance::on_access(x, _root, _dummy);
+			_dummy->root = _root;
+		}
+		return (x);
+	};
+
+	Node_ptr find(const key_type& k, Node_ptr hint) const {
+		Node_ptr x = _finger_lower_bound(hint, k);
+		if (x != _dummy && _comp(k, KeyOfValue()(x->data)))
+			return (_dummy);
+		return (x);
+	};
+
+	// With the cache on, find() and lower_bound() start from the node the
+	// previous call landed on, so clustered lookups cost O(log d). It is
+	// written by const lookups: not for trees shared between readers.
+	void finger_cache(bool on) {
+		_finger_cache = on;
+		_finger = _dummy;
+	};
 
-	Node_ptr find(Key k, Node_ptr root) const { return (_find(root, k)); };
+	bool finger_cache(void) const {
+		return (_finger_cache);
+	};
 
 	Node_ptr minimum(Node_ptr node) const { return (Tree_Node::minimum(node)); };
 
@@ -249,23 +227,205 @@ private:
 
 	Node_ptr predecessor(Node_ptr x) const { return (Tree_Node::predecessor(x)); };
 
-	void insert(value_type data) {
-		Node_ptr z = find(KeyOfValue()(data));
-		if (z != _dummy) {
-			_erase(z);
+	// Copies the values of [first, last) to out. A second cursor runs
+	// SCAN_AHEAD nodes in front and prefetches, so the cache misses of a
+	// long scan overlap; a threaded tree makes each of its steps one load.
+	template <class OutputIterator>
+	OutputIterator scan(Node_ptr first, Node_ptr last, OutputIterator out) const {
+		Node_ptr ahead = first;
+		for (int i = 0; i < SCAN_AHEAD && ahead != last; i++)
+			ahead = successor(ahead);
+		for (; first != last; first = successor(first)) {
+			if (ahead != last) {
+				ahead = successor(ahead);
+				__builtin_prefetch(ahead);
+			}
+			*out = first->data;
+			++out;
 		}
-		_insert(data);
+		return (out);
+	};
+
+	// Inserts data unless its key is present; allocates only when it is not.
+	ft::pair<iterator, bool> try_insert(const value_type& data) {
+		Node_ptr parent;
+		bool left;
+		Node_ptr x = _descend_unique(KeyOfValue()(data), parent, left);
+		if (x != _dummy)
+			return (ft::make_pair(iterator(x), false));
+		Node_ptr z = _create(data);
+		_link(z, parent, left);
+		return (ft::make_pair(iterator(z), true));
+	};
+
+	// As above, near hint, any node of this tree or _dummy. A key that
+	// goes right before or right after hint is linked with two compares;
+	// any other is searched for outward from hint, O(log d) for d keys
+	// between the two.
+	ft::pair<iterator, bool> try_insert(const value_type& data, Node_ptr hint) {
+		const key_type& k = KeyOfValue()(data);
+		Node_ptr parent;
+		bool left;
+		if (_slot_beside(hint, k, parent, left))
+			return (ft::make_pair(insert_at(parent, left, data), true));
+		Node_ptr res;
+		Node_ptr x = _finger_climb(hint, k, res);
+		if (res != _dummy && !_comp(k, KeyOfValue()(res->data)))
+			return (ft::make_pair(iterator(res), false));
+		x = _descend_unique(x, k, parent, left);
+		if (x != _dummy)
+			return (ft::make_pair(iterator(x), false));
+		return (ft::make_pair(insert_at(parent, left, data), true));
+	};
+
+	// find_or_parent() and insert_at() split try_insert() so a caller can
+	// inspect the existing node, or build the value, between the two.
+	Node_ptr find_or_parent(const key_type& k, Node_ptr& parent, bool& left) const {
+		return (_descend_unique(k, parent, left));
+	};
+
+	iterator insert_at(Node_ptr parent, bool left, const value_type& data) {
+		Node_ptr z = _create(data);
+		_link(z, parent, left);
+		return (iterator(z));
 	};
 
-	void insert(value_type data, Node_ptr root) {
-		Node_ptr z = find(KeyOfValue()(data), root);
-		if (z != _dummy) {
-			_erase(z);
+	iterator insert_unique(value_type data) { return(_insert(data)); };
+
+	// Unlinks z without destroying it; the caller now owns the node. One
+	// from the arena is first moved to a node of its own, which the caller
+	// can free alone.
+	Node_ptr extract(Node_ptr z) {
+		_unlink(z);
+		if (!_in_arena(z))
+			return (z);
+		Node_ptr y = _alloc.allocate(1);
+		_alloc.construct(y, *z);
+		_free_node(z);
+		return (y);
+	};
+
+	// Links a node extracted from a tree with an equal allocator, unless
+	// its key is already present.
+	ft::pair<iterator, bool> insert_node(Node_ptr z) {
+		Node_ptr parent;
+		bool left;
+		Node_ptr x = _descend_unique(KeyOfValue()(z->data), parent, left);
+		if (x != _dummy)
+			return (ft::make_pair(iterator(x), false));
+		_link(z, parent, left);
+		return (ft::make_pair(iterator(z), true));
+	};
+
+	// Moves the nodes of [first, last) out of source, skipping keys this
+	// tree already holds; nothing is allocated or copied.
+	void splice(Rb_tree& source, Node_ptr first, Node_ptr last) {
+		if (&source == this)
+			return;
+		while (first != last) {
+			Node_ptr z = first;
+			first = successor(first);
+			Node_ptr parent;
+			bool left;
+			if (_descend_unique(KeyOfValue()(z->data), parent, left) == _dummy)
+				_link(source.extract(z), parent, left);
 		}
-		_insert(data);
 	};
 
-	iterator insert_unique(value_type data) { return(_insert(data)); };
+	// Replaces the contents with [first, last). Values in strictly
+	// increasing key order are built into a tree bottom-up in O(n); any
+	// other input is linked one by one, later duplicates dropped.
+	template <class InputIterator>
+	void assign_sorted(InputIterator first, InputIterator last) {
+		clear();
+		Ptr_allocator ptr_alloc(_alloc);
+		Node_ptr* nodes = NULL;
+		size_type n = 0;
+		size_type cap = 0;
+		bool sorted = true;
+		try {
+			for (; first != last; ++first) {
+				if (n == cap) {
+					size_type grown = (cap ? cap * 2 : 64);
+					Node_ptr* tmp = ptr_alloc.allocate(grown);
+					for (size_type i = 0; i < n; i++)
+						tmp[i] = nodes[i];
+					if (nodes)
+						ptr_alloc.deallocate(nodes, cap);
+					nodes = tmp;
+					cap = grown;
+				}
+				nodes[n] = _create(*first);
+				if (n && sorted && !_comp(KeyOfValue()(nodes[n - 1]->data), KeyOfValue()(nodes[n]->data)))
+					sorted = false;
+				n++;
+			}
+		} catch (...) {
+			for (size_type i = 0; i < n; i++)
+				_free_node(nodes[i]);
+			if (nodes)
+				ptr_alloc.deallocate(nodes, cap);
+			throw;
+		}
+		if (sorted) {
+			for (size_type i = 0; i < n; i++)
+				Balance::init(nodes[i]);
+			_root = Balance::build(nodes, n, _dummy);
+			_dummy->root = _root;
+			_thread(nodes, n);
+			_size = n;
+		} else {
+			for (size_type i = 0; i < n; i++) {
+				Node_ptr parent;
+				bool left;
+				if (_descend_unique(KeyOfValue()(nodes[i]->data), parent, left) == _dummy)
+					_link(nodes[i], parent, left);
+				else
+					_free_node(nodes[i]);
+			}
+		}
+		if (nodes)
+			ptr_alloc.deallocate(nodes, cap);
+	};
+
+	// Moves every node, in key order, into one block freshly allocated
+	// and keeps the shape of the tree, so an in-order scan reads memory
+	// front to back. Iterators other than end() are invalidated.
+	void compact(void) {
+		if (_size == 0)
+			return;
+		size_type n = _size;
+		Node_ptr block = _alloc.allocate(n);
+		size_type i = 0;
+		for (Node_ptr x = minimum(_root); x != _dummy; x = successor(x), i++) {
+			_alloc.construct(block + i, *x);
+			block[i].root = x;
+			x->root = block + i;
+		}
+		for (i = 0; i < n; i++) {
+			block[i].parent = _moved(block[i].parent);
+			block[i].left = _moved(block[i].left);
+			block[i].right = _moved(block[i].right);
+#ifdef FT_THREADED_TREE
+			block[i].prev = (i == 0 ? _dummy : block + i - 1);
+			block[i].next = (i + 1 == n ? _dummy : block + i + 1);
+#endif
+		}
+		_root = _moved(_root);
+		_dummy->root = _root;
+#ifdef FT_THREADED_TREE
+		_dummy->next = block;
+		_dummy->prev = block + n - 1;
+#endif
+		for (i = 0; i < n; i++) {
+			_free_node(block[i].root);
+			block[i].root = _root;
+		}
+		_arena = block;
+		_arena_size = n;
+		_arena_live = n;
+		_finger = _dummy;
+	};
 
 	void erase(Key key)
 	{
@@ -276,9 +436,55 @@ private:
 		_erase(z);
 	};
 	
+	// One in-order pass sorts the nodes into survivors (front of the
+	// scratch array) and victims (back). A large purge rebuilds the tree
+	// from the survivors in O(n); a small one unlinks victims one by one,
+	// with no lookup since the nodes are already known.
+	template <class Predicate>
+	size_type erase_if(Predicate pred) {
+		size_type n = _size;
+		if (n == 0)
+			return (0);
+		Ptr_allocator ptr_alloc(_alloc);
+		Node_ptr* nodes = ptr_alloc.allocate(n);
+		size_type keep = 0;
+		size_type drop = n;
+		try {
+			for (Node_ptr x = minimum(_root); x != _dummy; x = successor(x)) {
+				if (pred(x->data))
+					nodes[--drop] = x;
+				else
+					nodes[keep++] = x;
+			}
+		} catch (...) {
+			ptr_alloc.deallocate(nodes, n);
+			throw;
+		}
+		if ((n - keep) * REBUILD_FRACTION >= n) {
+			for (size_type i = keep; i < n; i++)
+				_free_node(nodes[i]);
+			_root = Balance::build(nodes, keep, _dummy);
+			_dummy->root = _root;
+			_thread(nodes, keep);
+			_finger = _dummy;
+			_size = keep;
+		} else {
+			for (size_type i = keep; i < n; i++)
+				_erase(nodes[i]);
+		}
+		ptr_alloc.deallocate(nodes, n);
+		return (n - keep);
+	};
+
+#ifdef FT_THREADED_TREE
+	iterator begin(void) { return (iterator(_dummy->next)); };
+
+	const_iterator begin(void) const { return (const_iterator(_dummy->next)); };
+#else
 	iterator begin(void) { return (iterator(minimum(_root))); };
 
 	const_iterator begin(void) const { return (const_iterator(minimum(_root))); };
+#endif
 
 	iterator end(void) { return (iterator(_dummy)); };
 
@@ -302,255 +508,352 @@ private:
 		return (const_reverse_iterator(begin()));
 	};
 
-	Node_ptr getroot(void)
+	Node_ptr getroot(void) const
 		{
 		return (_root);
 		};
 
 	private:
 
-	Node_ptr &getRefNode(Node_ptr x)
-	{
-		if (x == _root)
-			return _root;
-		Node_ptr parent = x->parent;
-
-		return (parent->left == x ? parent->left : parent->right);
+	// Rotates left children up so the tree unwinds into a right spine;
+	// no recursion, since a splay tree can be a single long path.
+	void _clear(Node_ptr node) {
+		while (node != _dummy) {
+			if (node->left != _dummy) {
+				Node_ptr l = node->left;
+				node->left = l->right;
+				l->right = node;
+				node = l;
+			} else {
+				Node_ptr r = node->right;
+				_free_node(node);
+				node = r;
+			}
+		}
 	};
 
-	void rotateLeft(Node_ptr n) {
-		Node_ptr &rp = this->getRefNode(n);
-
-		rp = n->right;
-		n->right = rp->left;
-		rp->left = n;
-		if (n->right != NULL)
-			n->right->parent = n;
-		rp->parent = n->parent;
-		n->parent = rp;
+	Node_ptr _lower_bound(Node_ptr x, Node_ptr res, const key_type& k) const {
+		while (x != _dummy) {
+			if (!_comp(KeyOfValue()(x->data), k)) {
+				res = x;
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		return (res);
 	};
 
-	void rotateRight(Node_ptr m) {
-		Node_ptr &rp = this->getRefNode(m);
-
-		rp = m->left;
-		m->left = rp->right;
-		rp->right = m;
-		if (m->left != NULL)
-			m->left->parent = m;
-		rp->parent = m->parent;
-		m->parent = rp;
+	Node_ptr _upper_bound(Node_ptr x, Node_ptr res, const key_type& k) const {
+		while (x != _dummy) {
+			if (_comp(k, KeyOfValue()(x->data))) {
+				res = x;
+				x = x->left;
+			} else {
+				x = x->right;
+			}
+		}
+		return (res);
+	};
+
+	// Climbs from finger until its subtree must hold the lower bound of k:
+	// O(log d) for d keys between the two. Below k, stop under an ancestor
+	// >= k; at or above it, under one < k. res is the lower bound should
+	// the subtree hold nothing >= k.
+	Node_ptr _finger_climb(Node_ptr finger, const key_type& k, Node_ptr& res) const {
+		res = _dummy;
+		if (finger == _dummy)
+			return (_root);
+		Node_ptr x = finger;
+		if (_comp(KeyOfValue()(finger->data), k)) {
+			while (x != _root) {
+				if (x == x->parent->left && !_comp(KeyOfValue()(x->parent->data), k)) {
+					res = x->parent;
+					break;
+				}
+				x = x->parent;
+			}
+			return (x);
+		}
+		while (x != _root) {
+			if (x == x->parent->right && _comp(KeyOfValue()(x->parent->data), k))
+				break;
+			x = x->parent;
+		}
+		res = finger;
+		return (x);
 	};
 
-	void _clear(Node_ptr node) {
-		if (node != _dummy) {
-			_clear(node->left);
-			_clear(node->right);
-			_alloc.destroy(node);
-			_alloc.deallocate(node, 1);
+	// Whether k falls strictly between hint and one of its neighbours; if
+	// so, parent and left give its place.
+	bool _slot_beside(Node_ptr hint, const key_type& k, Node_ptr& parent, bool& left) const {
+		if (_size == 0) {
+			parent = _dummy;
+			left = true;
+			return (true);
+		}
+		if (hint == _dummy || _comp(k, KeyOfValue()(hint->data))) {
+			Node_ptr before = predecessor(hint);
+			if (before != _dummy && !_comp(KeyOfValue()(before->data), k))
+				return (false);
+			left = (hint != _dummy && hint->left == _dummy);
+			parent = (left ? hint : before);
+			return (true);
+		}
+		if (!_comp(KeyOfValue()(hint->data), k))
+			return (false);
+		Node_ptr after = successor(hint);
+		if (after != _dummy && !_comp(k, KeyOfValue()(after->data)))
+			return (false);
+		left = (hint->right != _dummy);
+		parent = (left ? after : hint);
+		return (true);
+	};
+
+	Node_ptr _finger_lower_bound(Node_ptr finger, const key_type& k) const {
+		Node_ptr res;
+		Node_ptr x = _finger_climb(finger, k, res);
+		return (_lower_bound(x, res, k));
+	};
+
+	Node_ptr _cached_lower_bound(const key_type& k) const {
+		if (!_finger_cache)
+			return (_lower_bound(_root, _dummy, k));
+		Node_ptr x = _finger_lower_bound(_finger, k);
+		if (x != _dummy)
+			_finger = x;
+		return (x);
+	};
+
+	Node_ptr _cached_find(const key_type& k) const {
+		if (!_finger_cache)
+			return (_find(_root, k));
+		Node_ptr x = find(k, _finger);
+		if (x != _dummy)
+			_finger = x;
+		return (x);
+	};
+
+	template <class ForwardIterator>
+	bool _is_sorted(ForwardIterator first, ForwardIterator last) const {
+		if (first == last)
+			return (true);
+		ForwardIterator next = first;
+		while (++next != last) {
+			if (_comp(*next, *first))
+				return (false);
+			first = next;
 		}
+		return (true);
+	};
+
+	// Sorted keys reuse the previous answer as a finger. Otherwise up to
+	// FIND_BATCH descents advance one level per round, each prefetching the
+	// node it moves to, so their cache misses overlap.
+	enum { FIND_BATCH = 8 };
+
+	template <class Iter, class ForwardIterator, class OutputIterator>
+	OutputIterator _find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+		if (_is_sorted(first, last)) {
+			Node_ptr finger = _dummy;
+			for (bool head = true; first != last; ++first, head = false) {
+				if (head || finger != _dummy)
+					finger = _finger_lower_bound(finger, *first);
+				if (finger != _dummy && !_comp(*first, KeyOfValue()(finger->data)))
+					*out = Iter(finger);
+				else
+					*out = Iter(_dummy);
+				++out;
+			}
+			return (out);
+		}
+		const key_type* keys[FIND_BATCH];
+		Node_ptr cursor[FIND_BATCH];
+		Node_ptr found[FIND_BATCH];
+		while (first != last) {
+			int n = 0;
+			for (; n < FIND_BATCH && first != last; ++n, ++first) {
+				keys[n] = &*first;
+				cursor[n] = _root;
+				found[n] = _dummy;
+			}
+			for (int active = (_root == _dummy ? 0 : n); active > 0;) {
+				for (int i = 0; i < n; i++) {
+					Node_ptr x = cursor[i];
+					if (x == _dummy)
+						continue;
+					if (_comp(*keys[i], KeyOfValue()(x->data))) {
+						x = x->left;
+					} else if (_comp(KeyOfValue()(x->data), *keys[i])) {
+						x = x->right;
+					} else {
+						found[i] = x;
+						x = _dummy;
+					}
+					if (x == _dummy)
+						active--;
+					else
+						__builtin_prefetch(x);
+					cursor[i] = x;
+				}
+			}
+			for (int i = 0; i < n; i++, ++out)
+				*out = Iter(found[i]);
+		}
+		return (out);
 	};
 
-	Node_ptr _find(Node_ptr node, Key key) const {
-		if (node == _dummy || (!_comp(key, KeyOfValue()(node->data)) &&
-			!_comp(KeyOfValue()(node->data), key))) {
-			return (node);
+	Node_ptr _find(Node_ptr node, const key_type& key) const {
+		while (node != _dummy) {
+			if (_comp(key, KeyOfValue()(node->data)))
+				node = node->left;
+			else if (_comp(KeyOfValue()(node->data), key))
+				node = node->right;
+			else
+				break;
 		}
-		if (_comp(key, KeyOfValue()(node->data))) {
-			return (_find(node->left, key));
-		} else {
-			return (_find(node->right, key));
+		return (node);
+	};
+
+	Node_ptr _create(const value_type& data) {
+		Node_ptr z = _alloc.allocate(1);
+		try {
+			_alloc.construct(z, create_node(data, RED));
+		} catch (...) {
+			_alloc.deallocate(z, 1);
+			throw;
 		}
+		return (z);
 	};
 
 	iterator _insert(value_type data) {
 		Node_ptr x = _root;
 		Node_ptr y = _dummy;
-		Node_ptr z = _alloc.allocate(1);
-		_alloc.construct(z, create_node(data, RED));
+		Node_ptr z = _create(data);
 
+		bool left = true;
 		while (x != _dummy) {
 			y = x;
-			if (_comp(KeyOfValue()(z->data), KeyOfValue()(x->data))) {
+			left = _comp(KeyOfValue()(z->data), KeyOfValue()(x->data));
+			x = left ? x->left : x->right;
+		}
+		_link(z, y, left);
+		return(iterator(z));
+	};
+
+	// One descent: returns the node holding k, or _dummy with parent/left
+	// set to where a node for k would hang.
+	Node_ptr _descend_unique(const key_type& k, Node_ptr& parent, bool& left) const {
+		return (_descend_unique(_root, k, parent, left));
+	};
+
+	// From x, the root of a subtree known to hold k's place.
+	Node_ptr _descend_unique(Node_ptr x, const key_type& k, Node_ptr& parent, bool& left) const {
+		parent = _dummy;
+		left = true;
+		while (x != _dummy) {
+			parent = x;
+			if (_comp(k, KeyOfValue()(x->data))) {
+				left = true;
 				x = x->left;
-			} else {
+			} else if (_comp(KeyOfValue()(x->data), k)) {
+				left = false;
 				x = x->right;
+			} else {
+				return (x);
 			}
 		}
-		z->parent = y;
-		if (y == _dummy) {
+		return (_dummy);
+	};
+
+	// Hangs z, fresh or taken from another tree, under parent.
+	void _link(Node_ptr z, Node_ptr parent, bool left) {
+		z->leaf = _dummy;
+		z->parent = parent;
+		z->left = _dummy;
+		z->right = _dummy;
+		z->color = RED;
+		z->rank = 0;
+		Balance::init(z);
+#ifdef FT_THREADED_TREE
+		z->next = (left ? parent : parent->next);
+		z->prev = z->next->prev;
+		z->prev->next = z;
+		z->next->prev = z;
+#endif
+		if (parent == _dummy) {
 			_root = z;
-		} else if (_comp(KeyOfValue()(z->data), KeyOfValue()(y->data))) {
-			y->left = z;
+		} else if (left) {
+			parent->left = z;
 		} else {
-			y->right = z;
-			z->left = _dummy;
-			z->right = _dummy;
-			setColor(z, RED);
+			parent->right = z;
 		}
-		insert_fix(z);
+		Balance::insert_fix(z, _root, _dummy);
 		_dummy->root = _root;
 		_size++;
-
-		return(iterator(z));
 	};
 
-	void erase_fix(Node_ptr x) {
-		Node_ptr w;
-
-		while (x != _root && isNullOrBlack(x)) {
-			if (x == x->parent->left) {
-				w = x->parent->right;
-
-				if (isRed(w)) {
-					setColor(w, BLACK);
-					setColor(x->parent, RED);
-					rotateLeft(x->parent);
-					w = x->parent->right;
-				}
-				if (isNullOrBlack(w->left) && isNullOrBlack(w->right)) {
-					setColor(w, RED);
-					x = x->parent;
-				} else {
-					if (isNullOrBlack(w->right)) {
-						setColor(w->left, BLACK);
-						setColor(w, RED);
-						rotateRight(w);
-						w = x->parent->right;
-					}
-					setColor(w, getColor(x->parent));
-					setColor(x->parent, BLACK);
-					setColor(w->right, BLACK);
-					rotateLeft(x->parent);
-					x = _root;
-				}
-			} else {
-				w = x->parent->left;
-
-				if (isRed(w)) {
-					setColor(w, BLACK);
-					setColor(x->parent, RED);
-					rotateRight(x->parent);
-					w = x->parent->left;
-				}
-				if (isNullOrBlack(w->right) && isNullOrBlack(w->left)) {
-					setColor(w, RED);
-					x = x->parent;
-				} else {
-					if (isBlack(w->left)) {
-						setColor(w->right, BLACK);
-						setColor(w, RED);
-						rotateLeft(w);
-						w = x->parent->left;
-					}
-					setColor(w, getColor(x->parent));
-					setColor(x->parent, BLACK);
-					setColor(w->left, BLACK);
-					rotateRight(x->parent);
-					x = _root;
-				}
-			}
-		}
-		setColor(x, BLACK);
+	void _unlink(Node_ptr z) {
+		if (z == _finger)
+			_finger = _dummy;
+#ifdef FT_THREADED_TREE
+		z->prev->next = z->next;
+		z->next->prev = z->prev;
+#endif
+		Balance::erase(z, _root, _dummy);
+		_dummy->root = _root;
+		_size--;
 	};
 
-	void transplant(Node_ptr u, Node_ptr v) {
-		if (u->parent == _dummy) {
-			_root = v;
-		} else if (u == u->parent->left) {
-			u->parent->left = v;
-		} else {
-			u->parent->right = v;
+	// Chains n nodes, already in order, into the sentinel's list.
+	void _thread(Node_ptr* nodes, size_type n) {
+#ifdef FT_THREADED_TREE
+		Node_ptr prev = _dummy;
+		for (size_type i = 0; i < n; i++) {
+			nodes[i]->prev = prev;
+			prev->next = nodes[i];
+			prev = nodes[i];
 		}
-		v->parent = u->parent;
+		prev->next = _dummy;
+		_dummy->prev = prev;
+#else
+		(void)nodes;
+		(void)n;
+#endif
 	};
 
 	void _erase(Node_ptr z) {
-		Node_ptr x, y;
-		Color y_original_color;
-
-		y = z;
-		y_original_color = getColor(y);
-		if (z->left == _dummy) {
-			x = z->right;
-			transplant(z, z->right);
-		} else if (z->right == _dummy) {
-			x = z->left;
-			transplant(z, z->left);
-		} else {
-			y = minimum(z->right);
-			y_original_color = getColor(y);
-			x = y->right;
-			if (z != z->right) {
-				transplant(y, y->right);
-				y->right = z->right;
-				y->right->parent = y;
-			} else {
-				x->parent = y;
-			}
-			transplant(z, y);
-			y->left = z->left;
-			y->left->parent = y;
-			setColor(y, getColor(z));
-		}
+		_unlink(z);
+		_free_node(z);
+	};
 
-		_alloc.destroy(z);
-		_alloc.deallocate(z, 1);
+	// During compact() a node's root field holds its new address.
+	Node_ptr _moved(Node_ptr x) const {
+		return (x == _dummy ? x : x->root);
+	};
 
-		if (y_original_color == BLACK) {
-			erase_fix(x);
-		}
-		_dummy->root = _root;
-		_size--;
+	bool _in_arena(Node_ptr z) const {
+		return (_arena != NULL && z >= _arena && z < _arena + _arena_size);
 	};
 
-	void insert_fix(Node_ptr z) {
-		Node_ptr y;
-
-		while (isRed(z->parent)) {
-			if (z->parent == z->parent->parent->left) {
-				y = z->parent->parent->right;
-				if (isRed(y)) {
-					setColor(z->parent, BLACK);
-					setColor(y, BLACK);
-					setColor(z->parent->parent, RED);
-					z = z->parent->parent;
-				} else {
-					if (z == z->parent->right) {
-						z = z->parent;
-						rotateLeft(z);
-					}
-					setColor(z->parent, BLACK);
-					setColor(z->parent->parent, RED);
-					rotateRight(z->parent->parent);
-				}
-			} else {
-				y = z->parent->parent->left;
-				if (isRed(y)) {
-					setColor(z->parent, BLACK);
-					setColor(y, BLACK);
-					setColor(z->parent->parent, RED);
-					z = z->parent->parent;
-				} else {
-					if (z == z->parent->left) {
-						z = z->parent;
-						rotateRight(z);
-					}
-					setColor(z->parent, BLACK);
-					setColor(z->parent->parent, RED);
-					rotateLeft(z->parent->parent);
-				}
-			}
+	// A node inside the arena is only destroyed; the block goes back to
+	// the allocator with its last node.
+	void _free_node(Node_ptr z) {
+		_alloc.destroy(z);
+		if (!_in_arena(z)) {
+			_alloc.deallocate(z, 1);
+		} else if (--_arena_live == 0) {
+			_alloc.deallocate(_arena, _arena_size);
+			_arena = NULL;
+			_arena_size = 0;
 		}
-		setColor(_root, BLACK);
 	};
 
 	void copy(Node_ptr node) {
-		if (node != node->leaf) {
+		if (node == node->leaf)
+			return;
+		for (node = minimum(node); node != node->leaf; node = successor(node))
 			insert_unique(node->data);
-			copy(node->left);
-			copy(node->right);
-		}
 	};
 
 	Tree_Node create_node(value_type data, Color color) {
@@ -559,40 +862,46 @@ private:
 };
 #undef CONTAINER
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator==(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator==(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (x.size() == y.size() &&
 						ft::equal(x.begin(), x.end(), y.begin()));
 	}
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator!=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator!=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (!(x == y));
 	}
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator<(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator<(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
 	}
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator<=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator<=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (!(y < x));
 	}
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator>(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator>(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (y < x);
 	}
 
-	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-	inline bool operator>=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+			typename Balance>
+	inline bool operator>=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& x,
+							const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Balance>& y) {
 		return (!(x < y));
 	}
 
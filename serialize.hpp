@@ -0,0 +1,432 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "./hash.hpp"
+#include "./iterator_traits.hpp"
+#include "./map.hpp"
+#include "./type_traits.hpp"
+#include "./utility.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+/*
+		A snapshot is a header, the elements and a checksum of all that
+		precedes it:
+
+			"ftsn"  u16 version  u8 kind ('v' or 'm')  u8 reserved
+			u32 element size (0 unless written as one block)  u64 count
+			elements
+			u64 checksum
+
+		Numbers are in the host's byte order. A vector of trivially copyable
+		elements is written as one block; anything else goes element by
+		element through serializer<T>, which knows those types, std::string
+		and ft::pair. Maps are written in key order so that load() can build
+		the tree bottom-up in O(n).
+*/
+
+class snapshot_error : public std::runtime_error {
+ public:
+	explicit snapshot_error(const char* what) : std::runtime_error(what) {}
+};
+
+// Eight bytes at a time through hash_mix. The value does not depend on
+// how the input is cut into update() calls.
+class snapshot_checksum {
+	unsigned long long									_h;
+	unsigned long long									_length;
+	unsigned char										_tail[8];
+	unsigned											_tail_len;
+
+ public:
+	snapshot_checksum(void) : _h(0x9e3779b97f4a7c15ULL), _length(0), _tail_len(0) {}
+
+	void update(const void* data, std::size_t n) {
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		_length += n;
+		if (_tail_len) {
+			while (n && _tail_len < 8) {
+				_tail[_tail_len++] = *p++;
+				n--;
+			}
+			if (_tail_len < 8)
+				return;
+			_word(_tail);
+			_tail_len = 0;
+		}
+		for (; n >= 8; p += 8, n -= 8)
+			_word(p);
+		while (n--)
+			_tail[_tail_len++] = *p++;
+	}
+
+	unsigned long long value(void) const {
+		unsigned long long h = _h;
+		for (unsigned i = 0; i < _tail_len; i++)
+			h = (h ^ _tail[i]) * 0x100000001b3ULL;
+		return (hash_mix(h ^ _length));
+	}
+
+ private:
+	void _word(const unsigned char* p) {
+		unsigned long long w;
+		std::memcpy(&w, p, 8);
+		_h = (_h ^ hash_mix(w)) * 0x100000001b3ULL;
+	}
+};
+
+/*****************************************************************************\
+* 							WRITER / READER		 							   *
+\*****************************************************************************/
+
+enum {
+	SNAPSHOT_VERSION = 1,
+	SNAPSHOT_BUFFER = 1 << 16
+};
+
+class snapshot_writer {
+	std::ostream&										_os;
+	char*												_buf;
+	std::size_t											_used;
+	snapshot_checksum									_sum;
+
+	snapshot_writer(const snapshot_writer&);
+	snapshot_writer& operator=(const snapshot_writer&);
+
+ public:
+	explicit snapshot_writer(std::ostream& os) : _os(os), _buf(new char[SNAPSHOT_BUFFER]), _used(0) {}
+
+	~snapshot_writer(void) {
+		delete[] _buf;
+	}
+
+	void header(char kind, std::size_t element_size, unsigned long long count) {
+		unsigned short version = SNAPSHOT_VERSION;
+		unsigned char tag[2] = { static_cast<unsigned char>(kind), 0 };
+		unsigned size = static_cast<unsigned>(element_size);
+		write("ftsn", 4);
+		write(&version, sizeof(version));
+		write(tag, 2);
+		write(&size, sizeof(size));
+		write(&count, sizeof(count));
+	}
+
+	// Small writes are gathered in the buffer; a large one goes straight
+	// to the stream.
+	void write(const void* data, std::size_t n) {
+		if (_used + n > SNAPSHOT_BUFFER) {
+			flush();
+			if (n >= SNAPSHOT_BUFFER) {
+				_sum.update(data, n);
+				_put(data, n);
+				return;
+			}
+		}
+		std::memcpy(_buf + _used, data, n);
+		_used += n;
+	}
+
+	void flush(void) {
+		if (_used == 0)
+			return;
+		_sum.update(_buf, _used);
+		_put(_buf, _used);
+		_used = 0;
+	}
+
+	// Writes the checksum; the snapshot is complete after this.
+	void finish(void) {
+		flush();
+		unsigned long long sum = _sum.value();
+		_put(&sum, sizeof(sum));
+		_os.flush();
+	}
+
+ private:
+	void _put(const void* data, std::size_t n) {
+		_os.write(static_cast<const char*>(data), n);
+		if (!_os)
+			throw snapshot_error("snapshot: write failed");
+	}
+};
+
+// Reads ahead of the snapshot; finish() gives back what it did not use
+// when the stream can seek, so snapshots can follow one another.
+class snapshot_reader {
+	std::istream&										_is;
+	char*												_buf;
+	std::size_t											_pos;
+	std::size_t											_end;
+	std::size_t											_checked;
+	snapshot_checksum									_sum;
+
+	snapshot_reader(const snapshot_reader&);
+	snapshot_reader& operator=(const snapshot_reader&);
+
+ public:
+	explicit snapshot_reader(std::istream& is)
+		: _is(is), _buf(new char[SNAPSHOT_BUFFER]), _pos(0), _end(0), _checked(0) {}
+
+	~snapshot_reader(void) {
+		delete[] _buf;
+	}
+
+	// Checks the header against what the caller expects and returns the
+	// element count.
+	unsigned long long header(char kind, std::size_t element_size) {
+		char magic[4];
+		unsigned short version;
+		unsigned char tag[2];
+		unsigned size;
+		unsigned long long count;
+		read(magic, 4);
+		if (std::memcmp(magic, "ftsn", 4) != 0)
+			throw snapshot_error("snapshot: bad magic");
+		read(&version, sizeof(version));
+		if (version != SNAPSHOT_VERSION)
+			throw snapshot_error("snapshot: unknown version");
+		read(tag, 2);
+		read(&size, sizeof(size));
+		read(&count, sizeof(count));
+		if (tag[0] != static_cast<unsigned char>(kind) || size != element_size)
+			throw snapshot_error("snapshot: wrong container or element type");
+		return (count);
+	}
+
+	void read(void* data, std::size_t n) {
+		char* out = static_cast<char*>(data);
+		std::size_t avail = _end - _pos;
+		if (n <= avail) {
+			std::memcpy(out, _buf + _pos, n);
+			_pos += n;
+			return;
+		}
+		std::memcpy(out, _buf + _pos, avail);
+		out += avail;
+		n -= avail;
+		_pos = _end;
+		_sum.update(_buf + _checked, _end - _checked);
+		_pos = _end = _checked = 0;
+		if (n >= SNAPSHOT_BUFFER) {
+			_get(out, n);
+			_sum.update(out, n);
+			return;
+		}
+		_is.read(_buf, SNAPSHOT_BUFFER);
+		_end = static_cast<std::size_t>(_is.gcount());
+		if (_end < n)
+			throw snapshot_error("snapshot: truncated");
+		std::memcpy(out, _buf, n);
+		_pos = n;
+	}
+
+	// Reads the checksum and compares it with the bytes read so far.
+	void finish(void) {
+		_sum.update(_buf + _checked, _pos - _checked);
+		_checked = _pos;
+		unsigned long long expected = _sum.value();
+		unsigned long long stored;
+		read(&stored, sizeof(stored));
+		if (stored != expected)
+			throw snapshot_error("snapshot: checksum mismatch");
+		if (_end > _pos) {
+			_is.clear();
+			_is.seekg(-static_cast<std::streamoff>(_end - _pos), std::ios::cur);
+			_pos = _end;
+		}
+	}
+
+ private:
+	void _get(char* out, std::size_t n) {
+		_is.read(out, n);
+		if (static_cast<std::size_t>(_is.gcount()) != n)
+			throw snapshot_error("snapshot: truncated");
+	}
+};
+
+/*****************************************************************************\
+* 							ELEMENTS			 							   *
+\*****************************************************************************/
+
+// Trivially copyable types are copied byte for byte; other types need a
+// specialization of the false case, and fail to compile without one.
+template <typename T, bool Bulk = is_trivially_copyable<T>::value>
+struct serializer;
+
+template <typename T>
+struct serializer<T, true> {
+	static void save(snapshot_writer& w, const T& x) {
+		w.write(&x, sizeof(T));
+	}
+
+	static void load(snapshot_reader& r, T& x) {
+		r.read(&x, sizeof(T));
+	}
+};
+
+template <>
+struct serializer<std::string, false> {
+	static void save(snapshot_writer& w, const std::string& x) {
+		unsigned long long n = x.size();
+		w.write(&n, sizeof(n));
+		w.write(x.data(), x.size());
+	}
+
+	static void load(snapshot_reader& r, std::string& x) {
+		unsigned long long n;
+		r.read(&n, sizeof(n));
+		x.clear();
+		char buf[256];
+		while (n) {
+			std::size_t k = (n < sizeof(buf) ? static_cast<std::size_t>(n) : sizeof(buf));
+			r.read(buf, k);
+			x.append(buf, k);
+			n -= k;
+		}
+	}
+};
+
+// Field by field, so that padding never reaches the file.
+template <typename A, typename B>
+struct serializer<ft::pair<A, B>, false> {
+	typedef typename remove_const<A>::type				first_type;
+	typedef typename remove_const<B>::type				second_type;
+
+	static void save(snapshot_writer& w, const ft::pair<A, B>& x) {
+		serializer<first_type>::save(w, x.first);
+		serializer<second_type>::save(w, x.second);
+	}
+
+	static void load(snapshot_reader& r, ft::pair<first_type, second_type>& x) {
+		serializer<first_type>::load(r, x.first);
+		serializer<second_type>::load(r, x.second);
+	}
+};
+
+// The elements of a snapshot, read one per increment.
+template <typename T>
+class snapshot_iterator : public iterator<std::input_iterator_tag, T> {
+ public:
+	typedef std::input_iterator_tag						iterator_category;
+	typedef T											value_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef const T*									pointer;
+	typedef const T&									reference;
+
+ private:
+	snapshot_reader*									_r;
+	unsigned long long									_left;
+	T													_value;
+
+ public:
+	snapshot_iterator(void) : _r(NULL), _left(0), _value() {}
+
+	snapshot_iterator(snapshot_reader& r, unsigned long long count) : _r(&r), _left(count), _value() {
+		if (_left)
+			serializer<T>::load(*_r, _value);
+	}
+
+	reference operator*(void) const {
+		return (_value);
+	}
+
+	pointer operator->(void) const {
+		return (&_value);
+	}
+
+	snapshot_iterator& operator++(void) {
+		if (--_left)
+			serializer<T>::load(*_r, _value);
+		return (*this);
+	}
+
+	bool operator==(const snapshot_iterator& x) const {
+		return (_left == x._left);
+	}
+
+	bool operator!=(const snapshot_iterator& x) const {
+		return (_left != x._left);
+	}
+};
+
+/*****************************************************************************\
+* 							SAVE / LOAD			 							   *
+\*****************************************************************************/
+
+template <typename T, typename Alloc>
+void save(std::ostream& os, const vector<T, Alloc>& v) {
+	snapshot_writer w(os);
+	bool bulk = is_trivially_copyable<T>::value;
+	w.header('v', bulk ? sizeof(T) : 0, v.size());
+	if (bulk && !v.empty())
+		w.write(&v[0], v.size() * sizeof(T));
+	else
+		for (typename vector<T, Alloc>::size_type i = 0; i < v.size(); i++)
+			serializer<T>::save(w, v[i]);
+	w.finish();
+}
+
+// Leaves v as it was if the snapshot is rejected.
+template <typename T, typename Alloc>
+void load(std::istream& is, vector<T, Alloc>& v) {
+	const std::size_t chunk = 1 << 20;
+	snapshot_reader r(is);
+	bool bulk = is_trivially_copyable<T>::value;
+	unsigned long long n = r.header('v', bulk ? sizeof(T) : 0);
+	vector<T, Alloc> tmp(v.get_allocator());
+	// A corrupt count must not allocate memory the data does not back, so
+	// the vector at most doubles ahead of what has actually been read.
+	if (bulk) {
+		for (std::size_t done = 0; done < n; ) {
+			std::size_t grown = (done < chunk ? chunk : 2 * done);
+			if (grown > n)
+				grown = static_cast<std::size_t>(n);
+			tmp.resize(grown);
+			r.read(&tmp[done], (grown - done) * sizeof(T));
+			done = grown;
+		}
+	} else {
+		T x;
+		for (unsigned long long i = 0; i < n; i++) {
+			serializer<T>::load(r, x);
+			tmp.push_back(x);
+		}
+	}
+	r.finish();
+	v.swap(tmp);
+}
+
+template <class Key, class T, class Compare, class Alloc, class Balance>
+void save(std::ostream& os, const map<Key, T, Compare, Alloc, Balance>& m) {
+	typedef map<Key, T, Compare, Alloc, Balance>		Map;
+	snapshot_writer w(os);
+	w.header('m', 0, m.size());
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		serializer<typename Map::value_type>::save(w, *it);
+	w.finish();
+}
+
+// Leaves m as it was if the snapshot is rejected.
+template <class Key, class T, class Compare, class Alloc, class Balance>
+void load(std::istream& is, map<Key, T, Compare, Alloc, Balance>& m) {
+	snapshot_reader r(is);
+	unsigned long long n = r.header('m', 0);
+	map<Key, T, Compare, Alloc, Balance> tmp(m.key_comp(), m.get_allocator());
+	snapshot_iterator<ft::pair<Key, T> > first(r, n);
+	tmp.assign_sorted(first, snapshot_iterator<ft::pair<Key, T> >());
+	r.finish();
+	m.swap(tmp);
+}
+
+}
+
+#endif
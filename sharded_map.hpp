@@ -0,0 +1,315 @@
+#ifndef SHARDED_MAP_H
+#define SHARDED_MAP_H
+
+#include <functional>
+#include <memory>
+#include <new>
+
+#include "./Container.hpp"
+#include "./hash.hpp"
+#include "./map.hpp"
+#include "./merge_iterator.hpp"
+#include "./thread.hpp"
+#include "./utility.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+/*
+		Keys are spread by hash over Shards independent ft::map instances,
+		each behind its own lock, so writers only contend when they hit the
+		same shard. Ordered traversal merges the shards on the fly.
+*/
+#define CONTAINER Container<ft::pair<const Key, T>, Alloc>
+template <class Key, class T, std::size_t Shards = 16, class Hash = ft::hash<Key>,
+		class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class sharded_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(reference);
+	IMPORT_TYPE(const_reference);
+	IMPORT_TYPE(pointer);
+	IMPORT_TYPE(const_pointer);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef Key											key_type;
+	typedef T											mapped_type;
+	typedef Compare										key_compare;
+	typedef Hash										hasher;
+	typedef Alloc										allocator_type;
+	typedef ft::map<Key, T, Compare, Alloc>				shard_type;
+
+ /*****************************************************************************\
+ * 							MEMBER CLASS			 						   *
+ \*****************************************************************************/
+	class value_compare : public std::binary_function<value_type, value_type, bool> {
+	 protected:
+		Compare comp;
+
+	 public:
+		explicit value_compare(Compare c = Compare()) : comp(c) {}
+
+		bool operator()(const value_type& x, const value_type& y) const {
+			return (comp(x.first, y.first));
+		}
+	};
+
+	typedef ft::merge_iterator<typename shard_type::const_iterator, value_compare, Shards>
+														iterator;
+	typedef iterator									const_iterator;
+
+ private:
+	enum { CACHE_LINE = 64 };
+
+	// The padding keeps neighbouring locks off the same cache line.
+	struct shard {
+		spin_lock										lock;
+		shard_type										map;
+		char											pad[CACHE_LINE];
+
+		shard(const key_compare& comp, const allocator_type& alloc) : lock(), map(comp, alloc) {}
+
+	 private:
+		shard(const shard&);
+		shard& operator=(const shard&);
+	};
+
+	typedef typename Alloc::template rebind<shard>::other	Shard_allocator;
+	typedef ft::pair<Key, T>							Batch_value;
+	typedef typename Alloc::template rebind<Batch_value>::other
+														Batch_allocator;
+	typedef ft::vector<Batch_value, Batch_allocator>	Batch;
+
+	allocator_type										_alloc;
+	Shard_allocator										_shard_alloc;
+	shard*												_shards;
+	hasher												_hash;
+	key_compare											_comp;
+
+	sharded_map(const sharded_map&);
+	sharded_map& operator=(const sharded_map&);
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit sharded_map(const key_compare& comp = key_compare(),
+				const hasher& hash = hasher(),
+				const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _shard_alloc(alloc), _shards(NULL), _hash(hash), _comp(comp) {
+		_create();
+	};
+
+	template <class InputIterator>
+	sharded_map(InputIterator first, InputIterator last,
+		const key_compare& comp = key_compare(),
+		const hasher& hash = hasher(),
+		const allocator_type& alloc = allocator_type())
+		: _alloc(alloc), _shard_alloc(alloc), _shards(NULL), _hash(hash), _comp(comp) {
+		_create();
+		insert(first, last);
+	};
+
+	~sharded_map(void) {
+		for (size_type i = 0; i < Shards; i++)
+			_shards[i].~shard();
+		_shard_alloc.deallocate(_shards, Shards);
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	// Unsynchronized: writers must be quiet while these iterators are in use.
+	// range_scan() takes the locks itself.
+	const_iterator begin(void) const {
+		typename shard_type::const_iterator first[Shards];
+		typename shard_type::const_iterator last[Shards];
+		for (size_type i = 0; i < Shards; i++) {
+			first[i] = _shards[i].map.begin();
+			last[i] = _shards[i].map.end();
+		}
+		return (const_iterator(first, last, value_comp()));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator());
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (size() == 0);
+	};
+
+	size_type size(void) const {
+		size_type n = 0;
+		for (size_type i = 0; i < Shards; i++) {
+			scoped_lock<spin_lock> guard(_shards[i].lock);
+			n += _shards[i].map.size();
+		}
+		return (n);
+	};
+
+	size_type max_size(void) const {
+		return (_shards[0].map.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	bool insert(const value_type& val) {
+		shard& s = _shards[shard_index(val.first)];
+		scoped_lock<spin_lock> guard(s.lock);
+		return (s.map.insert(val).second);
+	};
+
+	// Groups the input by shard first, so each shard is locked once per
+	// call instead of once per element.
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		Batch batch[Shards];
+		for (; first != last; ++first)
+			batch[shard_index(first->first)].push_back(Batch_value(first->first, first->second));
+		for (size_type i = 0; i < Shards; i++) {
+			if (batch[i].empty())
+				continue;
+			scoped_lock<spin_lock> guard(_shards[i].lock);
+			for (typename Batch::iterator it = batch[i].begin(); it != batch[i].end(); ++it)
+				_shards[i].map.insert(value_type(it->first, it->second));
+		}
+	};
+
+	size_type erase(const key_type& k) {
+		shard& s = _shards[shard_index(k)];
+		scoped_lock<spin_lock> guard(s.lock);
+		return (s.map.erase(k));
+	};
+
+	void clear(void) {
+		for (size_type i = 0; i < Shards; i++) {
+			scoped_lock<spin_lock> guard(_shards[i].lock);
+			_shards[i].map.clear();
+		}
+	};
+
+	// Not synchronized with other operations on either map.
+	void swap(sharded_map& x) {
+		std::swap(_alloc, x._alloc);
+		std::swap(_shard_alloc, x._shard_alloc);
+		std::swap(_shards, x._shards);
+		std::swap(_hash, x._hash);
+		std::swap(_comp, x._comp);
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	// Copies the mapped value out, since a reference would outlive the lock.
+	bool find(const key_type& k, mapped_type& out) const {
+		shard& s = _shards[shard_index(k)];
+		scoped_lock<spin_lock> guard(s.lock);
+		typename shard_type::const_iterator it = s.map.find(k);
+		if (it == s.map.end())
+			return (false);
+		out = it->second;
+		return (true);
+	};
+
+	size_type count(const key_type& k) const {
+		shard& s = _shards[shard_index(k)];
+		scoped_lock<spin_lock> guard(s.lock);
+		return (s.map.count(k));
+	};
+
+	// Unsynchronized, like begin().
+	const_iterator lower_bound(const key_type& k) const {
+		typename shard_type::const_iterator first[Shards];
+		typename shard_type::const_iterator last[Shards];
+		for (size_type i = 0; i < Shards; i++) {
+			first[i] = _shards[i].map.lower_bound(k);
+			last[i] = _shards[i].map.end();
+		}
+		return (const_iterator(first, last, value_comp()));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		typename shard_type::const_iterator first[Shards];
+		typename shard_type::const_iterator last[Shards];
+		for (size_type i = 0; i < Shards; i++) {
+			first[i] = _shards[i].map.upper_bound(k);
+			last[i] = _shards[i].map.end();
+		}
+		return (const_iterator(first, last, value_comp()));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	// Copies every element with a key in [lo, hi) to out, in key order. All
+	// shards are locked, in index order, for the duration of the scan.
+	template <class OutputIterator>
+	OutputIterator range_scan(const key_type& lo, const key_type& hi, OutputIterator out) const {
+		typename shard_type::const_iterator first[Shards];
+		typename shard_type::const_iterator last[Shards];
+		for (size_type i = 0; i < Shards; i++) {
+			_shards[i].lock.lock();
+			first[i] = _shards[i].map.lower_bound(lo);
+			last[i] = _shards[i].map.lower_bound(hi);
+		}
+		for (const_iterator it(first, last, value_comp()); !it.at_end(); ++it)
+			*out++ = *it;
+		for (size_type i = Shards; i-- > 0; )
+			_shards[i].lock.unlock();
+		return (out);
+	};
+
+	size_type shard_index(const key_type& k) const {
+		return (_hash(k) % Shards);
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+	key_compare key_comp(void) const {
+		return (_comp);
+	};
+
+	value_compare value_comp(void) const {
+		return (value_compare(_comp));
+	};
+
+	hasher hash_function(void) const {
+		return (_hash);
+	};
+
+ private:
+
+	void _create(void) {
+		_shards = _shard_alloc.allocate(Shards);
+		for (size_type i = 0; i < Shards; i++)
+			new (_shards + i) shard(_comp, _alloc);
+	};
+};
+#undef CONTAINER
+
+template <class Key, class T, std::size_t Shards, class Hash, class Compare, class Alloc>
+void swap(sharded_map<Key, T, Shards, Hash, Compare, Alloc>& lhs,
+		sharded_map<Key, T, Shards, Hash, Compare, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+};
+#endif
@@ -0,0 +1,871 @@
+#ifndef STRING_RADIX_MAP_H
+#define STRING_RADIX_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "./Container.hpp"
+#include "./iterator_traits.hpp"
+#include "./utility.hpp"
+#include "./vector.hpp"
+
+namespace ft {
+
+// A node's key is the concatenation of the labels from the root down to
+// it. Children are sorted by the first byte of their label, which is
+// unique among siblings; only the root and nodes with a value may have
+// fewer than two children. Short labels and the value live inside the
+// node, and the children share one block with their first bytes, so a
+// lookup reads the bytes it branches on without touching the children.
+template <typename T>
+struct string_radix_node {
+	typedef string_radix_node<T>		Node;
+
+	enum { INLINE = 8 };
+
+	union Label {
+		char*							ptr;
+		char							buf[INLINE];
+	};
+
+	union Storage {
+		char							bytes[sizeof(T)];
+		long double						align_float;
+		long long						align_int;
+		void*							align_ptr;
+	};
+
+	Node*								parent;
+	Node**								children;
+	Label								label;
+	unsigned							length;
+	unsigned short						count;
+	bool								has_value;
+	Storage								storage;
+
+	const char* text(void) const {
+		return (length <= INLINE ? label.buf : label.ptr);
+	}
+
+	unsigned char head(void) const {
+		return (static_cast<unsigned char>(text()[0]));
+	}
+
+	// The first byte of each child's label, after the child pointers.
+	const unsigned char* heads(void) const {
+		return (reinterpret_cast<const unsigned char*>(children + count));
+	}
+
+	unsigned char* heads(void) {
+		return (reinterpret_cast<unsigned char*>(children + count));
+	}
+
+	T* value(void) {
+		return (reinterpret_cast<T*>(storage.bytes));
+	}
+
+	const T* value(void) const {
+		return (reinterpret_cast<const T*>(storage.bytes));
+	}
+
+	// The index of the first child whose label starts at or above c.
+	std::size_t child_index(unsigned char c) const {
+		const unsigned char* h = heads();
+		std::size_t lo = 0;
+		std::size_t hi = count;
+		while (lo < hi) {
+			std::size_t mid = (lo + hi) / 2;
+			if (h[mid] < c)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return (lo);
+	}
+
+	Node* child(unsigned char c) const {
+		std::size_t i = child_index(c);
+		return (i < count && heads()[i] == c ? children[i] : NULL);
+	}
+
+	// A key sorts before every key it prefixes, so a node precedes its
+	// subtree.
+	static Node* first(Node* n) {
+		while (!n->has_value)
+			n = n->children[0];
+		return (n);
+	}
+
+	static Node* last(Node* n) {
+		while (n->count != 0)
+			n = n->children[n->count - 1];
+		return (n);
+	}
+
+	// The first node with a value past n's subtree, or NULL.
+	static Node* after(Node* n) {
+		for (Node* p = n->parent; p != NULL; n = p, p = p->parent) {
+			std::size_t i = p->child_index(n->head());
+			if (i + 1 < p->count)
+				return (first(p->children[i + 1]));
+		}
+		return (NULL);
+	}
+};
+
+// What an iterator dereferences to: the key it rebuilt and the value in
+// the node. Both stay valid until the iterator moves.
+template <typename T>
+struct string_radix_entry {
+	const std::string&					first;
+	T&									second;
+
+	string_radix_entry(const std::string& _first, T& _second) : first(_first), second(_second) {}
+};
+
+template <typename T>
+struct string_radix_arrow {
+	string_radix_entry<T>				entry;
+
+	string_radix_arrow(const std::string& _first, T& _second) : entry(_first, _second) {}
+
+	string_radix_entry<T>* operator->(void) {
+		return (&entry);
+	}
+};
+
+/*
+		Keys are not stored anywhere whole, so the iterator carries the key
+		of its node and extends or trims it label by label as it moves.
+*/
+template <typename T, typename Node>
+class string_radix_iterator
+	: public iterator<std::bidirectional_iterator_tag, T, std::ptrdiff_t,
+		string_radix_arrow<T>, string_radix_entry<T> > {
+ public:
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef T									value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef string_radix_arrow<T>				pointer;
+	typedef string_radix_entry<T>				reference;
+
+ protected:
+	Node*										node;
+	Node*										root;
+	std::string									path;
+
+ public:
+	string_radix_iterator(void) : node(NULL), root(NULL), path() {}
+
+	string_radix_iterator(Node* _node, Node* _root) : node(_node), root(_root), path() {
+		for (Node* n = node; n != NULL; n = n->parent)
+			path.insert(0, n->text(), n->length);
+	}
+
+	string_radix_iterator(Node* _node, Node* _root, const std::string& _path)
+		: node(_node), root(_root), path(_path) {}
+
+	template <typename U>
+	string_radix_iterator(const string_radix_iterator<U, Node>& i)
+		: node(i.base()), root(i.tree()), path(i.key()) {}
+
+	~string_radix_iterator(void) {}
+
+	Node* base(void) const {
+		return (node);
+	}
+
+	Node* tree(void) const {
+		return (root);
+	}
+
+	const std::string& key(void) const {
+		return (path);
+	}
+
+	reference operator*(void) const {
+		return (reference(path, *node->value()));
+	}
+
+	pointer operator->(void) const {
+		return (pointer(path, *node->value()));
+	}
+
+	string_radix_iterator& operator++(void) {
+		if (node->count != 0) {
+			_descend_first(node->children[0]);
+			return (*this);
+		}
+		for (Node* p = node->parent; p != NULL; node = p, p = p->parent) {
+			std::size_t i = p->child_index(node->head());
+			path.erase(path.size() - node->length);
+			if (i + 1 < p->count) {
+				_descend_first(p->children[i + 1]);
+				return (*this);
+			}
+		}
+		node = NULL;
+		path.clear();
+		return (*this);
+	}
+
+	string_radix_iterator operator++(int) {
+		string_radix_iterator tmp(*this);
+		++(*this);
+		return (tmp);
+	}
+
+	string_radix_iterator& operator--(void) {
+		if (node == NULL) {
+			node = root;
+			path.clear();
+			_descend_last();
+			return (*this);
+		}
+		for (Node* p = node->parent; p != NULL; p = node->parent) {
+			std::size_t i = p->child_index(node->head());
+			path.erase(path.size() - node->length);
+			node = p;
+			if (i > 0) {
+				node = p->children[i - 1];
+				path.append(node->text(), node->length);
+				_descend_last();
+				return (*this);
+			}
+			if (p->has_value)
+				return (*this);
+		}
+		return (*this);
+	}
+
+	string_radix_iterator operator--(int) {
+		string_radix_iterator tmp(*this);
+		--(*this);
+		return (tmp);
+	}
+
+ private:
+	void _descend_first(Node* n) {
+		node = n;
+		path.append(n->text(), n->length);
+		while (!node->has_value) {
+			node = node->children[0];
+			path.append(node->text(), node->length);
+		}
+	}
+
+	void _descend_last(void) {
+		while (node->count != 0) {
+			node = node->children[node->count - 1];
+			path.append(node->text(), node->length);
+		}
+	}
+};
+
+template <typename TL, typename TR, typename Node>
+inline bool operator==(const string_radix_iterator<TL, Node>& lhs, const string_radix_iterator<TR, Node>& rhs) {
+	return (lhs.base() == rhs.base());
+}
+
+template <typename TL, typename TR, typename Node>
+inline bool operator!=(const string_radix_iterator<TL, Node>& lhs, const string_radix_iterator<TR, Node>& rhs) {
+	return (lhs.base() != rhs.base());
+}
+
+// ft::reverse_iterator would hand out an entry that refers to the key of
+// a temporary; this one keeps the element it last dereferenced.
+template <typename Iterator>
+class string_radix_reverse_iterator
+	: public iterator<std::bidirectional_iterator_tag, typename Iterator::value_type,
+		std::ptrdiff_t, typename Iterator::pointer, typename Iterator::reference> {
+ public:
+	typedef Iterator							iterator_type;
+	typedef std::bidirectional_iterator_tag		iterator_category;
+	typedef typename Iterator::value_type		value_type;
+	typedef std::ptrdiff_t						difference_type;
+	typedef typename Iterator::pointer			pointer;
+	typedef typename Iterator::reference		reference;
+
+ protected:
+	Iterator									current;
+	mutable Iterator							element;
+
+ public:
+	string_radix_reverse_iterator(void) : current(), element() {}
+
+	explicit string_radix_reverse_iterator(iterator_type x) : current(x), element() {}
+
+	template <typename Iter>
+	string_radix_reverse_iterator(const string_radix_reverse_iterator<Iter>& x)
+		: current(x.base()), element() {}
+
+	~string_radix_reverse_iterator(void) {}
+
+	iterator_type base(void) const {
+		return (current);
+	}
+
+	reference operator*(void) const {
+		element = current;
+		return (*--element);
+	}
+
+	pointer operator->(void) const {
+		element = current;
+		return ((--element).operator->());
+	}
+
+	string_radix_reverse_iterator& operator++(void) {
+		--current;
+		return (*this);
+	}
+
+	string_radix_reverse_iterator operator++(int) {
+		string_radix_reverse_iterator tmp(*this);
+		--current;
+		return (tmp);
+	}
+
+	string_radix_reverse_iterator& operator--(void) {
+		++current;
+		return (*this);
+	}
+
+	string_radix_reverse_iterator operator--(int) {
+		string_radix_reverse_iterator tmp(*this);
+		++current;
+		return (tmp);
+	}
+};
+
+template <typename IteratorL, typename IteratorR>
+inline bool operator==(const string_radix_reverse_iterator<IteratorL>& x,
+						const string_radix_reverse_iterator<IteratorR>& y) {
+	return (x.base() == y.base());
+}
+
+template <typename IteratorL, typename IteratorR>
+inline bool operator!=(const string_radix_reverse_iterator<IteratorL>& x,
+						const string_radix_reverse_iterator<IteratorR>& y) {
+	return (x.base() != y.base());
+}
+
+/*
+		An ordered map from std::string, stored as a radix trie: a prefix
+		shared by many keys is kept once, on the edge above them, and a
+		lookup compares each byte of the key at most once. Dereferencing an
+		iterator yields a proxy whose first and second refer to the
+		iterator's rebuilt key and to the mapped value.
+*/
+#define CONTAINER Container<ft::pair<const std::string, T>, Alloc>
+template <class T, class Alloc = std::allocator<ft::pair<const std::string, T> > >
+class string_radix_map : public CONTAINER {
+ public:
+	IMPORT_TYPE(value_type);
+	IMPORT_TYPE(size_type);
+	IMPORT_TYPE(difference_type);
+	typedef std::string									key_type;
+	typedef T											mapped_type;
+	typedef std::less<std::string>						key_compare;
+	typedef Alloc										allocator_type;
+	typedef string_radix_node<T>						Node;
+	typedef ft::string_radix_iterator<T, Node>			iterator;
+	typedef ft::string_radix_iterator<const T, Node>	const_iterator;
+	typedef ft::string_radix_reverse_iterator<iterator>	reverse_iterator;
+	typedef ft::string_radix_reverse_iterator<const_iterator>
+														const_reverse_iterator;
+
+ private:
+	typedef typename Alloc::template rebind<Node>::other	Node_allocator;
+	typedef typename Alloc::template rebind<char>::other	Char_allocator;
+
+	Node*												_root;
+	size_type											_size;
+	allocator_type										_alloc;
+	Node_allocator										_node_alloc;
+	Char_allocator										_char_alloc;
+
+ public:
+
+ /*****************************************************************************\
+ * 					CONSTRUCTORS / DESTRUCTOR								   *
+ \*****************************************************************************/
+
+	explicit string_radix_map(const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _node_alloc(alloc), _char_alloc(alloc) {
+		_root = _new_node(NULL, 0, NULL);
+	};
+
+	template <class InputIterator>
+	string_radix_map(InputIterator first, InputIterator last,
+		const allocator_type& alloc = allocator_type())
+		: _root(NULL), _size(0), _alloc(alloc), _node_alloc(alloc), _char_alloc(alloc) {
+		_root = _new_node(NULL, 0, NULL);
+		insert(first, last);
+	};
+
+	string_radix_map(const string_radix_map& x)
+		: _root(NULL), _size(x._size), _alloc(x._alloc), _node_alloc(x._node_alloc),
+		_char_alloc(x._char_alloc) {
+		_root = _clone(x._root, NULL);
+	};
+
+	~string_radix_map(void) {
+		_destroy(_root);
+	};
+
+	string_radix_map& operator=(const string_radix_map& x) {
+		if (this != &x) {
+			string_radix_map tmp(x);
+			swap(tmp);
+		}
+		return (*this);
+	};
+
+ /*****************************************************************************\
+ * 							ELEMENT ACCESS		 							   *
+ \*****************************************************************************/
+
+	mapped_type& at(const key_type& key) {
+		Node* n = _find(key);
+		if (n == NULL) { throw std::out_of_range("cavalinho"); }
+		return (*n->value());
+	};
+
+	const mapped_type& at(const key_type& key) const {
+		Node* n = _find(key);
+		if (n == NULL) { throw std::out_of_range("cavalinho"); }
+		return (*n->value());
+	};
+
+	mapped_type& operator[](const key_type& k) {
+		Node* n = _find(k);
+		if (n != NULL)
+			return (*n->value());
+		return (*_insert(k, mapped_type()).first.base()->value());
+	};
+
+ /*****************************************************************************\
+ * 							ITERATORS			 							   *
+ \*****************************************************************************/
+
+	iterator begin(void) {
+		return (_size ? iterator(Node::first(_root), _root) : end());
+	};
+
+	const_iterator begin(void) const {
+		return (_size ? const_iterator(Node::first(_root), _root) : end());
+	};
+
+	iterator end(void) {
+		return (iterator(NULL, _root, std::string()));
+	};
+
+	const_iterator end(void) const {
+		return (const_iterator(NULL, _root, std::string()));
+	};
+
+	reverse_iterator rbegin(void) {
+		return (reverse_iterator(end()));
+	};
+
+	const_reverse_iterator rbegin(void) const {
+		return (const_reverse_iterator(end()));
+	};
+
+	reverse_iterator rend(void) {
+		return (reverse_iterator(begin()));
+	};
+
+	const_reverse_iterator rend(void) const {
+		return (const_reverse_iterator(begin()));
+	};
+
+ /*****************************************************************************\
+ * 							CAPACITY			 							   *
+ \*****************************************************************************/
+
+	bool empty(void) const {
+		return (_size == 0);
+	};
+
+	size_type size(void) const {
+		return (_size);
+	};
+
+	size_type max_size(void) const {
+		return (_node_alloc.max_size());
+	};
+
+ /*****************************************************************************\
+ * 							MODIFIERS			 							   *
+ \*****************************************************************************/
+
+	ft::pair<iterator, bool> insert(const value_type& val) {
+		return (_insert(val.first, val.second));
+	};
+
+	iterator insert(iterator position, const value_type& val) {
+		(void)position;
+		return (_insert(val.first, val.second).first);
+	};
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			_insert(first->first, first->second);
+	};
+
+	void erase(iterator position) {
+		erase(position.key());
+	};
+
+	// A node left without a value and with a single child is folded
+	// into that child, so the trie stays compressed.
+	size_type erase(const key_type& k) {
+		Node* n = _find(k);
+		if (n == NULL)
+			return (0);
+		_alloc_value().destroy(n->value());
+		n->has_value = false;
+		_size--;
+		if (n == _root)
+			return (1);
+		if (n->count == 0) {
+			Node* p = n->parent;
+			_remove_child(p, p->child_index(n->head()));
+			_delete_node(n);
+			n = p;
+		}
+		if (n != _root && !n->has_value && n->count == 1)
+			_merge(n);
+		return (1);
+	};
+
+	void erase(iterator first, iterator last) {
+		while (first != last)
+			erase(first++);
+	};
+
+	void swap(string_radix_map& x) {
+		std::swap(_root, x._root);
+		std::swap(_size, x._size);
+		std::swap(_alloc, x._alloc);
+		std::swap(_node_alloc, x._node_alloc);
+		std::swap(_char_alloc, x._char_alloc);
+	};
+
+	void clear(void) {
+		_destroy(_root);
+		_root = _new_node(NULL, 0, NULL);
+		_size = 0;
+	};
+
+ /*****************************************************************************\
+ * 							LOOKUP				 							   *
+ \*****************************************************************************/
+
+	iterator find(const key_type& k) {
+		Node* n = _find(k);
+		return (n != NULL ? iterator(n, _root, k) : end());
+	};
+
+	const_iterator find(const key_type& k) const {
+		Node* n = _find(k);
+		return (n != NULL ? const_iterator(n, _root, k) : end());
+	};
+
+	size_type count(const key_type& k) const {
+		return (_find(k) != NULL);
+	};
+
+	iterator lower_bound(const key_type& k) {
+		return (iterator(_lower_bound(k), _root));
+	};
+
+	const_iterator lower_bound(const key_type& k) const {
+		return (const_iterator(_lower_bound(k), _root));
+	};
+
+	iterator upper_bound(const key_type& k) {
+		iterator it = find(k);
+		return (it != end() ? ++it : lower_bound(k));
+	};
+
+	const_iterator upper_bound(const key_type& k) const {
+		const_iterator it = find(k);
+		return (it != end() ? ++it : lower_bound(k));
+	};
+
+	ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return (ft::make_pair(lower_bound(k), upper_bound(k)));
+	};
+
+	// Every key starting with prefix, in order: a single subtree.
+	ft::pair<iterator, iterator> prefix_range(const key_type& prefix) {
+		Node* n = _prefix_node(prefix);
+		if (n == NULL)
+			return (ft::make_pair(end(), end()));
+		return (ft::make_pair(iterator(Node::first(n), _root), iterator(Node::after(n), _root)));
+	};
+
+	ft::pair<const_iterator, const_iterator> prefix_range(const key_type& prefix) const {
+		Node* n = _prefix_node(prefix);
+		if (n == NULL)
+			return (ft::make_pair(end(), end()));
+		return (ft::make_pair(const_iterator(Node::first(n), _root),
+			const_iterator(Node::after(n), _root)));
+	};
+
+ /*****************************************************************************\
+ * 							OBSERVERS			 							   *
+ \*****************************************************************************/
+
+	key_compare key_comp(void) const {
+		return (key_compare());
+	};
+
+	allocator_type get_allocator(void) const {
+		return (_alloc);
+	};
+
+ private:
+
+	typedef typename Alloc::template rebind<T>::other	Value_allocator;
+
+	Value_allocator _alloc_value(void) const {
+		return (Value_allocator(_alloc));
+	};
+
+	// How many bytes of n's label match k from pos on.
+	static std::size_t _common(const Node* n, const key_type& k, std::size_t pos) {
+		std::size_t len = n->length < k.size() - pos ? n->length : k.size() - pos;
+		const char* text = n->text();
+		std::size_t i = 0;
+		while (i < len && text[i] == k[pos + i])
+			i++;
+		return (i);
+	};
+
+	void _set_label(Node* n, const char* text, std::size_t len) {
+		n->length = len;
+		char* dst = n->label.buf;
+		if (len > Node::INLINE) {
+			n->label.ptr = _char_alloc.allocate(len);
+			dst = n->label.ptr;
+		}
+		for (std::size_t i = 0; i < len; i++)
+			dst[i] = text[i];
+	};
+
+	void _free_label(Node* n) {
+		if (n->length > Node::INLINE)
+			_char_alloc.deallocate(n->label.ptr, n->length);
+	};
+
+	// Takes a copy: the new label is usually cut from the old one.
+	void _relabel(Node* n, const std::string& text) {
+		_free_label(n);
+		_set_label(n, text.data(), text.size());
+	};
+
+	Node* _new_node(const char* text, std::size_t len, Node* parent) {
+		Node* n = _node_alloc.allocate(1);
+		n->parent = parent;
+		n->children = NULL;
+		n->count = 0;
+		n->has_value = false;
+		_set_label(n, text, len);
+		return (n);
+	};
+
+	void _delete_node(Node* n) {
+		_free_label(n);
+		_free_block(n->children, n->count);
+		_node_alloc.deallocate(n, 1);
+	};
+
+	// count child pointers followed by their first bytes.
+	Node** _new_block(std::size_t count) {
+		if (count == 0)
+			return (NULL);
+		return (reinterpret_cast<Node**>(_char_alloc.allocate(count * (sizeof(Node*) + 1))));
+	};
+
+	void _free_block(Node** block, std::size_t count) {
+		if (block != NULL)
+			_char_alloc.deallocate(reinterpret_cast<char*>(block), count * (sizeof(Node*) + 1));
+	};
+
+	// Blocks are sized exactly: a change of fanout copies the block.
+	void _insert_child(Node* n, std::size_t i, Node* c) {
+		std::size_t count = n->count;
+		Node** block = _new_block(count + 1);
+		unsigned char* heads = reinterpret_cast<unsigned char*>(block + count + 1);
+		const unsigned char* old = n->heads();
+		for (std::size_t j = 0; j < count; j++) {
+			block[j + (j >= i)] = n->children[j];
+			heads[j + (j >= i)] = old[j];
+		}
+		block[i] = c;
+		heads[i] = c->head();
+		_free_block(n->children, count);
+		n->children = block;
+		n->count = count + 1;
+	};
+
+	void _remove_child(Node* n, std::size_t i) {
+		std::size_t count = n->count;
+		Node** block = _new_block(count - 1);
+		unsigned char* heads = reinterpret_cast<unsigned char*>(block + count - 1);
+		const unsigned char* old = n->heads();
+		for (std::size_t j = 0; j < count; j++) {
+			if (j != i) {
+				block[j - (j > i)] = n->children[j];
+				heads[j - (j > i)] = old[j];
+			}
+		}
+		_free_block(n->children, count);
+		n->children = block;
+		n->count = count - 1;
+	};
+
+	void _destroy(Node* n) {
+		for (std::size_t i = 0; i < n->count; i++)
+			_destroy(n->children[i]);
+		if (n->has_value)
+			_alloc_value().destroy(n->value());
+		_delete_node(n);
+	};
+
+	Node* _clone(const Node* src, Node* parent) {
+		Node* n = _new_node(src->text(), src->length, parent);
+		if (src->has_value) {
+			_alloc_value().construct(n->value(), *src->value());
+			n->has_value = true;
+		}
+		n->children = _new_block(src->count);
+		n->count = src->count;
+		unsigned char* heads = n->heads();
+		for (std::size_t i = 0; i < src->count; i++) {
+			n->children[i] = _clone(src->children[i], n);
+			heads[i] = src->heads()[i];
+		}
+		return (n);
+	};
+
+	// n has no value and one child: the child takes n's place.
+	void _merge(Node* n) {
+		Node* c = n->children[0];
+		Node* p = n->parent;
+		_relabel(c, std::string(n->text(), n->length) + std::string(c->text(), c->length));
+		c->parent = p;
+		p->children[p->child_index(n->head())] = c;
+		_delete_node(n);
+	};
+
+	Node* _find(const key_type& k) const {
+		Node* n = _root;
+		for (std::size_t pos = 0; pos < k.size(); pos += n->length) {
+			n = n->child(k[pos]);
+			if (n == NULL || k.compare(pos, n->length, n->text(), n->length) != 0)
+				return (NULL);
+		}
+		return (n->has_value ? n : NULL);
+	};
+
+	Node* _lower_bound(const key_type& k) const {
+		if (_size == 0)
+			return (NULL);
+		Node* n = _root;
+		for (std::size_t pos = 0; pos < k.size(); ) {
+			unsigned char c = k[pos];
+			std::size_t i = n->child_index(c);
+			if (i < n->count && n->heads()[i] == c) {
+				Node* x = n->children[i];
+				std::size_t len = _common(x, k, pos);
+				if (len == x->length) {
+					n = x;
+					pos += len;
+					continue;
+				}
+				if (pos + len == k.size()
+						|| static_cast<unsigned char>(x->text()[len])
+							> static_cast<unsigned char>(k[pos + len]))
+					return (Node::first(x));
+				i++;
+			}
+			return (i < n->count ? Node::first(n->children[i]) : Node::after(n));
+		}
+		return (Node::first(n));
+	};
+
+	// The node whose subtree holds exactly the keys starting with prefix.
+	Node* _prefix_node(const key_type& prefix) const {
+		if (_size == 0)
+			return (NULL);
+		Node* n = _root;
+		for (std::size_t pos = 0; pos < prefix.size(); ) {
+			n = n->child(prefix[pos]);
+			if (n == NULL)
+				return (NULL);
+			std::size_t len = _common(n, prefix, pos);
+			if (len < n->length && pos + len < prefix.size())
+				return (NULL);
+			pos += len;
+		}
+		return (n);
+	};
+
+	// Splitting an edge leaves the walk on the new middle node, from which
+	// it carries on as usual.
+	ft::pair<iterator, bool> _insert(const key_type& k, const mapped_type& obj) {
+		Node* n = _root;
+		std::size_t pos = 0;
+		while (pos < k.size()) {
+			unsigned char c = k[pos];
+			std::size_t i = n->child_index(c);
+			if (i == n->count || n->heads()[i] != c) {
+				Node* leaf = _new_node(k.data() + pos, k.size() - pos, n);
+				_insert_child(n, i, leaf);
+				n = leaf;
+				break;
+			}
+			Node* x = n->children[i];
+			std::size_t len = _common(x, k, pos);
+			if (len < x->length) {
+				Node* mid = _new_node(x->text(), len, n);
+				n->children[i] = mid;
+				_relabel(x, std::string(x->text() + len, x->length - len));
+				x->parent = mid;
+				_insert_child(mid, 0, x);
+				x = mid;
+			}
+			n = x;
+			pos += len;
+		}
+		if (n->has_value)
+			return (ft::make_pair(iterator(n, _root, k), false));
+		_alloc_value().construct(n->value(), obj);
+		n->has_value = true;
+		_size++;
+		return (ft::make_pair(iterator(n, _root, k), true));
+	};
+};
+#undef CONTAINER
+
+template <class T, class Alloc>
+void swap(string_radix_map<T, Alloc>& lhs, string_radix_map<T, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+}
+
+#endif
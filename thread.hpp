@@ -0,0 +1,291 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace ft {
+
+class spin_lock {
+ private:
+	volatile int	_flag;
+
+	spin_lock(const spin_lock&);
+	spin_lock& operator=(const spin_lock&);
+
+ public:
+	spin_lock(void) : _flag(0) {}
+
+	void lock(void) {
+		while (__sync_lock_test_and_set(&_flag, 1)) {
+			while (__atomic_load_n(&_flag, __ATOMIC_RELAXED))
+				sched_yield();
+		}
+	}
+
+	bool try_lock(void) {
+		return (__sync_lock_test_and_set(&_flag, 1) == 0);
+	}
+
+	void unlock(void) {
+		__sync_lock_release(&_flag);
+	}
+};
+
+class mutex {
+ private:
+	pthread_mutex_t	_mutex;
+
+	mutex(const mutex&);
+	mutex& operator=(const mutex&);
+
+ public:
+	mutex(void) {
+		pthread_mutex_init(&_mutex, NULL);
+	}
+
+	~mutex(void) {
+		pthread_mutex_destroy(&_mutex);
+	}
+
+	void lock(void) {
+		pthread_mutex_lock(&_mutex);
+	}
+
+	bool try_lock(void) {
+		return (pthread_mutex_trylock(&_mutex) == 0);
+	}
+
+	void unlock(void) {
+		pthread_mutex_unlock(&_mutex);
+	}
+
+	pthread_mutex_t* native_handle(void) {
+		return (&_mutex);
+	}
+};
+
+class condition {
+ private:
+	pthread_cond_t	_cond;
+
+	condition(const condition&);
+	condition& operator=(const condition&);
+
+ public:
+	condition(void) {
+		pthread_cond_init(&_cond, NULL);
+	}
+
+	~condition(void) {
+		pthread_cond_destroy(&_cond);
+	}
+
+	// m must be locked; it is released while waiting.
+	void wait(mutex& m) {
+		pthread_cond_wait(&_cond, m.native_handle());
+	}
+
+	void notify_one(void) {
+		pthread_cond_signal(&_cond);
+	}
+
+	void notify_all(void) {
+		pthread_cond_broadcast(&_cond);
+	}
+};
+
+// Runs (*f)() on a new thread; f must outlive join().
+class thread {
+ private:
+	pthread_t		_id;
+	bool			_joinable;
+
+	thread(const thread&);
+	thread& operator=(const thread&);
+
+	template <typename Function>
+	static void* _trampoline(void* f) {
+		(*static_cast<Function*>(f))();
+		return (NULL);
+	}
+
+ public:
+	thread(void) : _id(), _joinable(false) {}
+
+	~thread(void) {
+		join();
+	}
+
+	template <typename Function>
+	bool start(Function* f) {
+		_joinable = (pthread_create(&_id, NULL, &_trampoline<Function>, f) == 0);
+		return (_joinable);
+	}
+
+	void join(void) {
+		if (_joinable)
+			pthread_join(_id, NULL);
+		_joinable = false;
+	}
+
+	static unsigned hardware_concurrency(void) {
+		long n = sysconf(_SC_NPROCESSORS_ONLN);
+		return (n > 0 ? static_cast<unsigned>(n) : 1);
+	}
+};
+
+// One pointer per thread, NULL until that thread sets it.
+class thread_specific {
+ private:
+	pthread_key_t	_key;
+
+	thread_specific(const thread_specific&);
+	thread_specific& operator=(const thread_specific&);
+
+ public:
+	thread_specific(void) {
+		pthread_key_create(&_key, NULL);
+	}
+
+	~thread_specific(void) {
+		pthread_key_delete(_key);
+	}
+
+	void* get(void) const {
+		return (pthread_getspecific(_key));
+	}
+
+	void set(void* p) {
+		pthread_setspecific(_key, p);
+	}
+};
+
+// Seconds on a clock that never jumps; only differences mean anything.
+inline double monotonic_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+template <typename Lock>
+class scoped_lock {
+ private:
+	Lock&			_lock;
+
+	scoped_lock(const scoped_lock&);
+	scoped_lock& operator=(const scoped_lock&);
+
+ public:
+	explicit scoped_lock(Lock& lock) : _lock(lock) {
+		_lock.lock();
+	}
+
+	~scoped_lock(void) {
+		_lock.unlock();
+	}
+};
+
+/*
+		A ring of capacity slots between producers and consumers. push()
+		blocks while the ring is full and pop() while it is empty. Values
+		are swapped in and out rather than copied, so a consumer that hands
+		in an empty buffer gives its storage back to the next producer.
+		close() ends the stream: push() then fails at once and pop() fails
+		once the ring is drained. The time each side spent blocked is kept.
+*/
+template <typename T>
+class bounded_queue {
+ public:
+	typedef std::size_t									size_type;
+
+ private:
+	T*													_ring;
+	size_type											_capacity;
+	size_type											_head;
+	size_type											_count;
+	bool												_closed;
+	double												_push_wait;
+	double												_pop_wait;
+	mutex												_mutex;
+	condition											_not_empty;
+	condition											_not_full;
+
+	bounded_queue(const bounded_queue&);
+	bounded_queue& operator=(const bounded_queue&);
+
+ public:
+	explicit bounded_queue(size_type capacity)
+		: _ring(NULL), _capacity(capacity ? capacity : 1), _head(0), _count(0), _closed(false),
+		_push_wait(0), _pop_wait(0) {
+		_ring = new T[_capacity];
+	}
+
+	~bounded_queue(void) {
+		delete[] _ring;
+	}
+
+	// Swaps v into the ring; v is left with whatever the slot held.
+	bool push(T& v) {
+		scoped_lock<mutex> guard(_mutex);
+		if (_count == _capacity && !_closed) {
+			double start = monotonic_seconds();
+			while (_count == _capacity && !_closed)
+				_not_full.wait(_mutex);
+			_push_wait += monotonic_seconds() - start;
+		}
+		if (_closed)
+			return (false);
+		using std::swap;
+		swap(_ring[(_head + _count) % _capacity], v);
+		_count++;
+		_not_empty.notify_one();
+		return (true);
+	}
+
+	// Swaps the front value into v, which must be left empty enough to
+	// be reused by push().
+	bool pop(T& v) {
+		scoped_lock<mutex> guard(_mutex);
+		if (_count == 0 && !_closed) {
+			double start = monotonic_seconds();
+			while (_count == 0 && !_closed)
+				_not_empty.wait(_mutex);
+			_pop_wait += monotonic_seconds() - start;
+		}
+		if (_count == 0)
+			return (false);
+		using std::swap;
+		swap(_ring[_head], v);
+		_head = (_head + 1) % _capacity;
+		_count--;
+		_not_full.notify_one();
+		return (true);
+	}
+
+	void close(void) {
+		scoped_lock<mutex> guard(_mutex);
+		_closed = true;
+		_not_empty.notify_all();
+		_not_full.notify_all();
+	}
+
+	double push_wait(void) {
+		scoped_lock<mutex> guard(_mutex);
+		return (_push_wait);
+	}
+
+	double pop_wait(void) {
+		scoped_lock<mutex> guard(_mutex);
+		return (_pop_wait);
+	}
+};
+
+}
+
+#endif
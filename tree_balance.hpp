@@ -0,0 +1,452 @@
+#ifndef TREE_BALANCE_H
+#define TREE_BALANCE_H
+
+#include <cstddef>
+
+#include "./hash.hpp"
+#include "./RBT_Node.hpp"
+
+namespace ft {
+
+/*
+		Pointer surgery shared by the balancing policies. A tree hangs from
+		a sentinel leaf: the root's parent and every missing child point to
+		it. Nodes need parent, left, right, color and rank; rank is the
+		height for AVL and the priority for a treap. The leaf is only ever
+		written through its parent field, which erase uses as scratch.
+*/
+struct tree_algorithms {
+	template <typename Node>
+	static Node* minimum(Node* x, Node* leaf) {
+		while (x->left != leaf)
+			x = x->left;
+		return (x);
+	}
+
+	template <typename Node>
+	static void rotate_left(Node* x, Node*& root, Node* leaf) {
+		Node* y = x->right;
+		x->right = y->left;
+		if (y->left != leaf)
+			y->left->parent = x;
+		y->parent = x->parent;
+		if (x->parent == leaf)
+			root = y;
+		else if (x == x->parent->left)
+			x->parent->left = y;
+		else
+			x->parent->right = y;
+		y->left = x;
+		x->parent = y;
+	}
+
+	template <typename Node>
+	static void rotate_right(Node* x, Node*& root, Node* leaf) {
+		Node* y = x->left;
+		x->left = y->right;
+		if (y->right != leaf)
+			y->right->parent = x;
+		y->parent = x->parent;
+		if (x->parent == leaf)
+			root = y;
+		else if (x == x->parent->right)
+			x->parent->right = y;
+		else
+			x->parent->left = y;
+		y->right = x;
+		x->parent = y;
+	}
+
+	template <typename Node>
+	static void transplant(Node* u, Node* v, Node*& root, Node* leaf) {
+		if (u->parent == leaf)
+			root = v;
+		else if (u == u->parent->left)
+			u->parent->left = v;
+		else
+			u->parent->right = v;
+		v->parent = u->parent;
+	}
+
+	// Unlinks z as in a plain binary search tree; its successor takes its
+	// place when it has two children. x is the subtree that moved up (maybe
+	// the leaf) and x_parent the lowest node whose subtree changed.
+	template <typename Node>
+	static void unlink(Node* z, Node*& root, Node* leaf, Node*& x, Node*& x_parent) {
+		if (z->left == leaf || z->right == leaf) {
+			x = (z->left == leaf ? z->right : z->left);
+			x_parent = z->parent;
+			transplant(z, x, root, leaf);
+			return;
+		}
+		Node* y = minimum(z->right, leaf);
+		x = y->right;
+		if (y->parent == z) {
+			x_parent = y;
+		} else {
+			x_parent = y->parent;
+			transplant(y, x, root, leaf);
+			y->right = z->right;
+			y->right->parent = y;
+		}
+		transplant(z, y, root, leaf);
+		y->left = z->left;
+		y->left->parent = y;
+		x->parent = x_parent;
+	}
+
+	// Links nodes[0, n), given in key order, into a tree of minimal height
+	// and returns its root. Each rank becomes the subtree height. Nodes on
+	// the deepest level are colored red and the rest black, which is a
+	// valid red-black coloring since all leaves sit on the last two levels.
+	template <typename Node>
+	static Node* build(Node** nodes, std::size_t n, Node* parent, Node* leaf,
+						int depth, int red_depth) {
+		if (n == 0)
+			return (leaf);
+		std::size_t mid = n / 2;
+		Node* x = nodes[mid];
+		x->parent = parent;
+		x->left = build(nodes, mid, x, leaf, depth + 1, red_depth);
+		x->right = build(nodes + mid + 1, n - mid - 1, x, leaf, depth + 1, red_depth);
+		x->color = (depth == red_depth ? RED : BLACK);
+		int l = x->left->rank;
+		int r = x->right->rank;
+		x->rank = 1 + (l > r ? l : r);
+		return (x);
+	}
+
+	template <typename Node>
+	static Node* build(Node** nodes, std::size_t n, Node* leaf) {
+		int red_depth = 0;
+		for (std::size_t m = n; m > 1; m >>= 1)
+			red_depth++;
+		Node* root = build(nodes, n, leaf, leaf, 0, red_depth);
+		if (root != leaf)
+			root->color = BLACK;
+		return (root);
+	}
+};
+
+/*****************************************************************************\
+* 							RED-BLACK			 							  *
+\*****************************************************************************/
+
+struct rb_balance : tree_algorithms {
+	template <typename Node>
+	static void init(Node* z) {
+		z->color = RED;
+	}
+
+	template <typename Node>
+	static void insert_fix(Node* z, Node*& root, Node* leaf) {
+		while (z->parent->color == RED) {
+			Node* g = z->parent->parent;
+			if (z->parent == g->left) {
+				Node* y = g->right;
+				if (y->color == RED) {
+					z->parent->color = BLACK;
+					y->color = BLACK;
+					g->color = RED;
+					z = g;
+				} else {
+					if (z == z->parent->right) {
+						z = z->parent;
+						rotate_left(z, root, leaf);
+					}
+					z->parent->color = BLACK;
+					g->color = RED;
+					rotate_right(g, root, leaf);
+				}
+			} else {
+				Node* y = g->left;
+				if (y->color == RED) {
+					z->parent->color = BLACK;
+					y->color = BLACK;
+					g->color = RED;
+					z = g;
+				} else {
+					if (z == z->parent->left) {
+						z = z->parent;
+						rotate_right(z, root, leaf);
+					}
+					z->parent->color = BLACK;
+					g->color = RED;
+					rotate_left(g, root, leaf);
+				}
+			}
+		}
+		root->color = BLACK;
+	}
+
+	template <typename Node>
+	static void erase(Node* z, Node*& root, Node* leaf) {
+		Node* y = (z->left == leaf || z->right == leaf ? z : minimum(z->right, leaf));
+		Color y_original_color = y->color;
+		Node* x;
+		Node* x_parent;
+		unlink(z, root, leaf, x, x_parent);
+		y->color = z->color;
+		if (y_original_color == BLACK)
+			erase_fix(x, root, leaf);
+	}
+
+	template <typename Node>
+	static void on_access(Node*, Node*&, Node*) {}
+
+ private:
+	template <typename Node>
+	static void erase_fix(Node* x, Node*& root, Node* leaf) {
+		while (x != root && x->color == BLACK) {
+			if (x == x->parent->left) {
+				Node* w = x->parent->right;
+				if (w->color == RED) {
+					w->color = BLACK;
+					x->parent->color = RED;
+					rotate_left(x->parent, root, leaf);
+					w = x->parent->right;
+				}
+				if (w->left->color == BLACK && w->right->color == BLACK) {
+					w->color = RED;
+					x = x->parent;
+				} else {
+					if (w->right->color == BLACK) {
+						w->left->color = BLACK;
+						w->color = RED;
+						rotate_right(w, root, leaf);
+						w = x->parent->right;
+					}
+					w->color = x->parent->color;
+					x->parent->color = BLACK;
+					w->right->color = BLACK;
+					rotate_left(x->parent, root, leaf);
+					x = root;
+				}
+			} else {
+				Node* w = x->parent->left;
+				if (w->color == RED) {
+					w->color = BLACK;
+					x->parent->color = RED;
+					rotate_right(x->parent, root, leaf);
+					w = x->parent->left;
+				}
+				if (w->right->color == BLACK && w->left->color == BLACK) {
+					w->color = RED;
+					x = x->parent;
+				} else {
+					if (w->left->color == BLACK) {
+						w->right->color = BLACK;
+						w->color = RED;
+						rotate_left(w, root, leaf);
+						w = x->parent->left;
+					}
+					w->color = x->parent->color;
+					x->parent->color = BLACK;
+					w->left->color = BLACK;
+					rotate_right(x->parent, root, leaf);
+					x = root;
+				}
+			}
+		}
+		x->color = BLACK;
+	}
+};
+
+/*****************************************************************************\
+* 								AVL				 							  *
+\*****************************************************************************/
+
+// rank is the subtree height; the leaf keeps height 0.
+struct avl_balance : tree_algorithms {
+	template <typename Node>
+	static void init(Node* z) {
+		z->rank = 1;
+	}
+
+	template <typename Node>
+	static void insert_fix(Node* z, Node*& root, Node* leaf) {
+		retrace(z->parent, root, leaf);
+	}
+
+	template <typename Node>
+	static void erase(Node* z, Node*& root, Node* leaf) {
+		Node* y = (z->left == leaf || z->right == leaf ? z : minimum(z->right, leaf));
+		Node* x;
+		Node* x_parent;
+		unlink(z, root, leaf, x, x_parent);
+		y->rank = z->rank;
+		retrace(x_parent, root, leaf);
+	}
+
+	template <typename Node>
+	static void on_access(Node*, Node*&, Node*) {}
+
+ private:
+	template <typename Node>
+	static void update(Node* x) {
+		int l = x->left->rank;
+		int r = x->right->rank;
+		x->rank = 1 + (l > r ? l : r);
+	}
+
+	// Walks up refreshing heights and rotating where the two sides differ
+	// by two; stops once a subtree comes out as tall as it was.
+	template <typename Node>
+	static void retrace(Node* x, Node*& root, Node* leaf) {
+		while (x != leaf) {
+			int old = x->rank;
+			int balance = x->left->rank - x->right->rank;
+			if (balance > 1) {
+				Node* l = x->left;
+				if (l->left->rank < l->right->rank) {
+					rotate_left(l, root, leaf);
+					update(l);
+				}
+				rotate_right(x, root, leaf);
+				update(x);
+				x = x->parent;
+			} else if (balance < -1) {
+				Node* r = x->right;
+				if (r->right->rank < r->left->rank) {
+					rotate_right(r, root, leaf);
+					update(r);
+				}
+				rotate_left(x, root, leaf);
+				update(x);
+				x = x->parent;
+			}
+			update(x);
+			if (x->rank == old)
+				return;
+			x = x->parent;
+		}
+	}
+};
+
+/*****************************************************************************\
+* 								TREAP			 							  *
+\*****************************************************************************/
+
+// rank is a heap priority. It is derived from the node address, which
+// keeps the policy stateless and safe to use from several threads.
+struct treap_balance : tree_algorithms {
+	template <typename Node>
+	static void init(Node* z) {
+		z->rank = static_cast<int>(hash_mix(reinterpret_cast<std::size_t>(z)) & 0x7fffffff);
+	}
+
+	template <typename Node>
+	static void insert_fix(Node* z, Node*& root, Node* leaf) {
+		while (z->parent != leaf && z->parent->rank < z->rank) {
+			if (z == z->parent->left)
+				rotate_right(z->parent, root, leaf);
+			else
+				rotate_left(z->parent, root, leaf);
+		}
+	}
+
+	// Cartesian-tree construction along the right spine: keeps every
+	// node's priority, O(n) overall.
+	template <typename Node>
+	static Node* build(Node** nodes, std::size_t n, Node* leaf) {
+		Node* root = leaf;
+		Node* last = leaf;
+		for (std::size_t i = 0; i < n; i++) {
+			Node* x = nodes[i];
+			Node* y = last;
+			Node* child = leaf;
+			while (y != leaf && y->rank < x->rank) {
+				child = y;
+				y = y->parent;
+			}
+			x->left = child;
+			x->right = leaf;
+			if (child != leaf)
+				child->parent = x;
+			x->parent = y;
+			if (y == leaf)
+				root = x;
+			else
+				y->right = x;
+			last = x;
+		}
+		return (root);
+	}
+
+	template <typename Node>
+	static void erase(Node* z, Node*& root, Node* leaf) {
+		while (z->left != leaf && z->right != leaf) {
+			if (z->left->rank > z->right->rank)
+				rotate_right(z, root, leaf);
+			else
+				rotate_left(z, root, leaf);
+		}
+		Node* x;
+		Node* x_parent;
+		unlink(z, root, leaf, x, x_parent);
+	}
+
+	template <typename Node>
+	static void on_access(Node*, Node*&, Node*) {}
+};
+
+/*****************************************************************************\
+* 								SPLAY			 							  *
+\*****************************************************************************/
+
+// Every insert and every non-const find moves the node to the root, so
+// hot keys stay a few steps away. Bounds are amortized O(log n).
+struct splay_balance : tree_algorithms {
+	template <typename Node>
+	static void init(Node*) {}
+
+	template <typename Node>
+	static void insert_fix(Node* z, Node*& root, Node* leaf) {
+		splay(z, root, leaf);
+	}
+
+	template <typename Node>
+	static void erase(Node* z, Node*& root, Node* leaf) {
+		Node* x;
+		Node* x_parent;
+		unlink(z, root, leaf, x, x_parent);
+		if (x_parent != leaf)
+			splay(x_parent, root, leaf);
+	}
+
+	template <typename Node>
+	static void on_access(Node* x, Node*& root, Node* leaf) {
+		splay(x, root, leaf);
+	}
+
+ private:
+	template <typename Node>
+	static void splay(Node* x, Node*& root, Node* leaf) {
+		while (x->parent != leaf) {
+			Node* p = x->parent;
+			Node* g = p->parent;
+			if (g == leaf) {
+				if (x == p->left)
+					rotate_right(p, root, leaf);
+				else
+					rotate_left(p, root, leaf);
+			} else if (x == p->left && p == g->left) {
+				rotate_right(g, root, leaf);
+				rotate_right(p, root, leaf);
+			} else if (x == p->right && p == g->right) {
+				rotate_left(g, root, leaf);
+				rotate_left(p, root, leaf);
+			} else if (x == p->right) {
+				rotate_left(p, root, leaf);
+				rotate_right(g, root, leaf);
+			} else {
+				rotate_right(p, root, leaf);
+				rotate_left(g, root, leaf);
+			}
+		}
+	}
+};
+
+}
+
+#endif
@@ -98,6 +98,38 @@ struct is_integral<unsigned long long> {
 	typedef true_type type;
 };
 
+template <typename T>
+struct remove_const {
+	typedef T type;
+};
+
+template <typename T>
+struct remove_const<const T> {
+	typedef T type;
+};
+
+// Types whose bytes can be copied as they are. Arithmetic types and
+// pointers; a plain struct can opt in with a specialization.
+template <typename T>
+struct is_trivially_copyable {
+	enum { value = is_integral<T>::value };
+};
+
+template <typename T>
+struct is_trivially_copyable<T*> {
+	enum { value = 1 };
+};
+
+template <>
+struct is_trivially_copyable<float> {
+	enum { value = 1 };
+};
+
+template <>
+struct is_trivially_copyable<double> {
+	enum { value = 1 };
+};
+
 }
 
 #endif
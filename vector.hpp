@@ -102,9 +102,7 @@ public:
 		for (size_type i = 0; i < _size; i++) {
 			_alloc.destroy(_data + i);
 		}
-		if (_capacity > 0) {
-			_alloc.deallocate(_data, _size);
-		}
+		_alloc.deallocate(_data, _capacity);
 		_size = 0;
 		_capacity = 0;
 	};
@@ -360,8 +358,8 @@ public:
 		if (position == end())
 				return position;
 			std::copy(position + 1, end(), position);
-			_alloc.destroy(end().base());
 			_size--;
+			_alloc.destroy(end().base());
 			return position;
 	};
 
@@ -369,11 +367,10 @@ public:
 		if (first == end() || first == last)
 				return first;
 			iterator return_iterator = first;
-			std::copy(last.base(), end().base(), first.base());
-			while (first != last) {
-				_alloc.destroy(first.base());
+			pointer new_end = std::copy(last.base(), end().base(), first.base());
+			while (end().base() != new_end) {
 				_size--;
-				first++;
+				_alloc.destroy(end().base());
 			}
 		return return_iterator;
 	};